@@ -0,0 +1,420 @@
+/*  Work Stealing Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/PanicDump.h"
+#include "SpinPause.h"
+#include "WorkStealingPool.h"
+
+namespace PokemonAutomation{
+
+
+
+//  One parallel_for() call.
+struct WorkStealingPool::Job{
+    void (*invoke)(void* block, size_t s, size_t e);
+    void* block;
+    size_t start;
+    size_t end;
+    size_t grain;
+
+    std::atomic<bool> failed;
+    std::mutex lock;
+    std::exception_ptr exception;
+
+    //  Only used when the caller is not a worker.
+    std::condition_variable cv;
+    bool done = false;
+
+    Job(
+        size_t p_start, size_t p_end, size_t p_grain,
+        void (*p_invoke)(void* block, size_t s, size_t e), void* p_block
+    )
+        : invoke(p_invoke)
+        , block(p_block)
+        , start(p_start)
+        , end(p_end)
+        , grain(p_grain)
+        , failed(false)
+    {}
+
+    //  Run chunks [c0, c1).
+    void run_chunks(size_t c0, size_t c1) noexcept{
+        if (failed.load(std::memory_order_relaxed)){
+            return;
+        }
+        try{
+            invoke(block, start + c0 * grain, std::min(end, start + c1 * grain));
+        }catch (...){
+            std::lock_guard<std::mutex> lg(lock);
+            if (!failed.load(std::memory_order_relaxed)){
+                exception = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+//  A range of chunks that has been set aside for anyone to take.
+//  Lives on the stack of the thread that split it off.
+struct WorkStealingPool::Task{
+    Job* job;
+    size_t begin;
+    size_t end;
+    bool root;
+    std::atomic<bool> done;
+    Task* next = nullptr;
+
+    Task(Job& p_job, size_t p_begin, size_t p_end, bool p_root)
+        : job(&p_job)
+        , begin(p_begin)
+        , end(p_end)
+        , root(p_root)
+        , done(false)
+    {}
+};
+
+
+
+namespace{
+
+//  Fixed-size Chase-Lev deque.
+//  The owner pushes and pops at the bottom. Thieves take from the top.
+//
+//  "Correct and Efficient Work-Stealing for Weak Memory Models"
+//  Lê, Pop, Cohen, Zappa Nardelli (PPoPP 2013)
+//
+//  The recursion in run_range() puts at most one task per level on the
+//  deque. So the capacity only needs to cover the depth. If it's ever full,
+//  the caller runs the work itself instead.
+template <class Type, size_t CAPACITY>
+class ChaseLevDeque{
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two.");
+    static constexpr int64_t MASK = CAPACITY - 1;
+
+public:
+    ChaseLevDeque()
+        : m_top(0)
+        , m_bottom(0)
+    {
+        for (std::atomic<Type*>& item : m_buffer){
+            item.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    bool empty() const{
+        return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+    }
+
+    //  Owner only. Returns false if full.
+    bool push(Type* item){
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        if (b - t >= (int64_t)CAPACITY){
+            return false;
+        }
+        m_buffer[b & MASK].store(item, std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    //  Owner only. Returns null if empty.
+    Type* pop(){
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        if (t > b){
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Type* item = m_buffer[b & MASK].load(std::memory_order_relaxed);
+        if (t == b){
+            //  Last item. Race the thieves for it.
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+                item = nullptr;
+            }
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    //  Any thread. Returns null if empty or if another thread got there first.
+    Type* steal(){
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b){
+            return nullptr;
+        }
+        Type* item = m_buffer[t & MASK].load(std::memory_order_acquire);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+            return nullptr;
+        }
+        return item;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    alignas(64) std::atomic<Type*> m_buffer[CAPACITY];
+};
+
+}
+
+
+
+struct WorkStealingPool::Worker{
+    WorkStealingPool* pool;
+    size_t index;
+    uint64_t rng_state;
+    ChaseLevDeque<Task, 256> deque;
+
+    Worker(WorkStealingPool& p_pool, size_t p_index)
+        : pool(&p_pool)
+        , index(p_index)
+        , rng_state(0x9e3779b97f4a7c15ull * (p_index + 1))
+    {}
+
+    size_t random(){
+        //  xorshift64
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        return (size_t)rng_state;
+    }
+};
+
+namespace{
+    //  The worker running on this thread, if any.
+    thread_local void* t_current_worker = nullptr;
+}
+
+
+
+WorkStealingPool::WorkStealingPool(std::function<void()>&& new_thread_callback, size_t threads)
+    : m_new_thread_callback(std::move(new_thread_callback))
+    , m_inject_size(0)
+    , m_sleeping(0)
+{
+    if (threads == 0){
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    for (size_t c = 0; c < threads; c++){
+        m_workers.emplace_back(new Worker(*this, c));
+    }
+    for (size_t c = 0; c < threads; c++){
+        Worker& worker = *m_workers[c];
+        m_threads.emplace_back(run_with_catch, "WorkStealingPool::thread_loop()", [this, &worker]{ thread_loop(worker); });
+    }
+}
+WorkStealingPool::~WorkStealingPool(){
+    {
+        std::lock_guard<std::mutex> lg(m_sleep_lock);
+        m_stopping = true;
+        m_sleep_cv.notify_all();
+    }
+    for (std::thread& thread : m_threads){
+        thread.join();
+    }
+}
+
+
+void WorkStealingPool::run(
+    size_t start, size_t end, size_t grain,
+    void (*invoke)(void* block, size_t s, size_t e), void* block
+){
+    if (start >= end){
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (end - start + grain - 1) / grain;
+    Job job(start, end, grain, invoke, block);
+
+    Worker* worker = (Worker*)t_current_worker;
+    if (worker != nullptr && worker->pool == this){
+        //  Nested call from one of our own workers. Run it in place.
+        run_range(*worker, job, 0, chunks);
+    }else{
+        Task root(job, 0, chunks, true);
+        {
+            std::lock_guard<std::mutex> lg(m_inject_lock);
+            if (m_inject_tail == nullptr){
+                m_inject_head = &root;
+            }else{
+                m_inject_tail->next = &root;
+            }
+            m_inject_tail = &root;
+            m_inject_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_workers();
+
+        std::unique_lock<std::mutex> lg(job.lock);
+        job.cv.wait(lg, [&]{ return job.done; });
+    }
+
+    if (job.failed.load(std::memory_order_acquire)){
+        std::rethrow_exception(job.exception);
+    }
+}
+
+
+void WorkStealingPool::run_range(Worker& worker, Job& job, size_t begin, size_t end){
+    while (end - begin > 1){
+        //  Set the upper half aside and keep splitting the lower half.
+        size_t mid = begin + (end - begin) / 2;
+        Task right(job, mid, end, false);
+        if (!worker.deque.push(&right)){
+            run_range(worker, job, begin, mid);
+            begin = mid;
+            continue;
+        }
+
+        //  Pairs with the fence in thread_loop() so a worker that is about to
+        //  sleep either sees this task or is woken up.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_relaxed) != 0){
+            wake_workers();
+        }
+
+        run_range(worker, job, begin, mid);
+
+        //  Everything pushed after "right" has been popped by now. So this
+        //  either gets "right" back or finds that it was stolen.
+        if (worker.deque.pop() == &right){
+            begin = mid;
+            continue;
+        }
+
+        //  Stolen. Help out with other work until the thief is done.
+        size_t spins = 0;
+        while (!right.done.load(std::memory_order_acquire)){
+            Task* task = find_task(worker);
+            if (task != nullptr){
+                execute(worker, *task);
+                spins = 0;
+                continue;
+            }
+            if (++spins < 64){
+                pause();
+            }else{
+                std::this_thread::yield();
+            }
+        }
+        return;
+    }
+    job.run_chunks(begin, end);
+}
+void WorkStealingPool::execute(Worker& worker, Task& task){
+    Job& job = *task.job;
+    run_range(worker, job, task.begin, task.end);
+    if (task.root){
+        //  "job" and "task" belong to the waiting caller. Don't touch them
+        //  after it's been notified.
+        std::lock_guard<std::mutex> lg(job.lock);
+        job.done = true;
+        job.cv.notify_all();
+    }else{
+        task.done.store(true, std::memory_order_release);
+    }
+}
+
+
+WorkStealingPool::Task* WorkStealingPool::find_task(Worker& worker){
+    Task* task = worker.deque.pop();
+    if (task != nullptr){
+        return task;
+    }
+
+    if (m_inject_size.load(std::memory_order_relaxed) != 0){
+        std::lock_guard<std::mutex> lg(m_inject_lock);
+        task = m_inject_head;
+        if (task != nullptr){
+            m_inject_head = task->next;
+            if (m_inject_head == nullptr){
+                m_inject_tail = nullptr;
+            }
+            m_inject_size.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    const size_t workers = m_workers.size();
+    size_t start = worker.random() % workers;
+    for (size_t c = 0; c < workers; c++){
+        Worker& victim = *m_workers[(start + c) % workers];
+        if (&victim == &worker){
+            continue;
+        }
+        task = victim.deque.steal();
+        if (task != nullptr){
+            return task;
+        }
+    }
+    return nullptr;
+}
+bool WorkStealingPool::has_work() const{
+    if (m_inject_size.load(std::memory_order_relaxed) != 0){
+        return true;
+    }
+    for (const std::unique_ptr<Worker>& worker : m_workers){
+        if (!worker->deque.empty()){
+            return true;
+        }
+    }
+    return false;
+}
+void WorkStealingPool::wake_workers(){
+    std::lock_guard<std::mutex> lg(m_sleep_lock);
+    m_wake_epoch++;
+    m_sleep_cv.notify_one();
+}
+
+
+void WorkStealingPool::thread_loop(Worker& worker){
+    t_current_worker = &worker;
+    if (m_new_thread_callback){
+        m_new_thread_callback();
+    }
+
+    while (true){
+        Task* task = nullptr;
+        for (size_t c = 0; c < 64 && task == nullptr; c++){
+            task = find_task(worker);
+            if (task == nullptr){
+                pause();
+            }
+        }
+        if (task != nullptr){
+            execute(worker, *task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lg(m_sleep_lock);
+        if (m_stopping){
+            return;
+        }
+        uint64_t epoch = m_wake_epoch;
+        m_sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_work()){
+            m_sleep_cv.wait(lg, [&]{ return m_stopping || m_wake_epoch != epoch; });
+        }
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+        //  Pass the wake-up along so that more workers join in if there's
+        //  more than one task available.
+        if (!m_stopping && m_sleeping.load(std::memory_order_relaxed) != 0 && has_work()){
+            m_wake_epoch++;
+            m_sleep_cv.notify_one();
+        }
+    }
+}
+
+
+
+}
@@ -0,0 +1,110 @@
+/*  Work Stealing Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A fixed set of threads for fine-grained parallel compute.
+ *
+ *  ParallelTaskRunner allocates an AsyncTask with its own mutex and condition
+ *  variable for every task and funnels all of them through one locked queue.
+ *  That is fine for a handful of large tasks. For many small ones (kernel
+ *  tiles, sprite candidates, OCR glyphs), the overhead and lock contention
+ *  cost more than the work.
+ *
+ *  Here, every worker has its own Chase-Lev deque. A parallel_for() splits
+ *  its range in half recursively. Each half that is set aside is pushed onto
+ *  the local deque where idle workers can steal it. Tasks live on the stack
+ *  of the thread that split them, so nothing is allocated per task.
+ *
+ *  This is for compute only. Do not use it for tasks that block or wait on
+ *  each other. Use AsyncDispatcher for those.
+ *
+ */
+
+#ifndef PokemonAutomation_WorkStealingPool_H
+#define PokemonAutomation_WorkStealingPool_H
+
+#include <stddef.h>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace PokemonAutomation{
+
+
+class WorkStealingPool{
+public:
+    //  "threads = 0" means one per CPU thread.
+    WorkStealingPool(std::function<void()>&& new_thread_callback, size_t threads);
+    ~WorkStealingPool();
+
+    size_t threads() const{ return m_workers.size(); }
+
+    //  Run "func(index)" for every index in [start, end).
+    //  The range is split into chunks of "grain" indices which are the
+    //  smallest unit of work that can run on a different thread.
+    //  Returns when everything is done. If any call throws, the remaining
+    //  chunks are skipped and the first exception is rethrown here.
+    //  Can be called from inside another parallel_for() on the same pool.
+    template <class Func>
+    void parallel_for(size_t start, size_t end, size_t grain, Func&& func){
+        auto run_block = [&func](size_t s, size_t e){
+            for (size_t index = s; index < e; index++){
+                func(index);
+            }
+        };
+        run(start, end, grain, &invoke<decltype(run_block)>, &run_block);
+    }
+
+
+private:
+    struct Job;
+    struct Task;
+    struct Worker;
+
+    template <class Block>
+    static void invoke(void* block, size_t s, size_t e){
+        (*(Block*)block)(s, e);
+    }
+
+    void run(
+        size_t start, size_t end, size_t grain,
+        void (*invoke)(void* block, size_t s, size_t e), void* block
+    );
+
+    void thread_loop(Worker& worker);
+
+    void run_range(Worker& worker, Job& job, size_t begin, size_t end);
+    void execute(Worker& worker, Task& task);
+    Task* find_task(Worker& worker);
+    bool has_work() const;
+    void wake_workers();
+
+
+private:
+    std::function<void()> m_new_thread_callback;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    //  Root tasks from threads outside the pool. Intrusive linked list.
+    std::mutex m_inject_lock;
+    Task* m_inject_head = nullptr;
+    Task* m_inject_tail = nullptr;
+    std::atomic<size_t> m_inject_size;
+
+    //  Idle workers sleep on this.
+    std::mutex m_sleep_lock;
+    std::condition_variable m_sleep_cv;
+    std::atomic<size_t> m_sleeping;
+    uint64_t m_wake_epoch = 0;
+    bool m_stopping = false;
+
+    std::vector<std::thread> m_threads;
+};
+
+
+
+}
+#endif
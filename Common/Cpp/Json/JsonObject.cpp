@@ -6,6 +6,7 @@
 
 #include "JsonObject.h"
 #include "JsonTools.h"
+#include "JsonWriter.h"
 
 namespace PokemonAutomation{
 
@@ -223,11 +224,9 @@ bool JsonObject::read_string(std::string& value, const std::string& key) const{
 
 
 std::string JsonObject::dump(int indent) const{
-    nlohmann::json ret;
-    for (const auto& item : *this){
-        ret[item.first] = to_nlohmann(item.second);
-    }
-    return nlohmann::json(ret).dump(indent);
+    std::string ret;
+    write_json(ret, *this, indent);
+    return ret;
 }
 void JsonObject::dump(const std::string& filename, int indent) const{
     string_to_file(filename, dump(indent));
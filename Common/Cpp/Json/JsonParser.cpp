@@ -0,0 +1,499 @@
+/*  JSON Parser
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <vector>
+#include <locale>
+#include <sstream>
+#include "JsonArray.h"
+#include "JsonObject.h"
+#include "JsonParser.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+//  Doubles that are exactly representable. Used by the fast path in
+//  parse_number().
+const double POWERS_OF_10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+
+void append_utf8(std::string& str, uint32_t code){
+    if (code < 0x80){
+        str += (char)code;
+    }else if (code < 0x800){
+        str += (char)(0xc0 | (code >> 6));
+        str += (char)(0x80 | (code & 0x3f));
+    }else if (code < 0x10000){
+        str += (char)(0xe0 | (code >> 12));
+        str += (char)(0x80 | ((code >> 6) & 0x3f));
+        str += (char)(0x80 | (code & 0x3f));
+    }else{
+        str += (char)(0xf0 | (code >> 18));
+        str += (char)(0x80 | ((code >> 12) & 0x3f));
+        str += (char)(0x80 | ((code >> 6) & 0x3f));
+        str += (char)(0x80 | (code & 0x3f));
+    }
+}
+
+
+//
+//  The parser is event driven: each token either opens a container, closes
+//  one or completes a value which is then attached to the innermost open
+//  container. Open containers are kept on an explicit stack so that deeply
+//  nested input cannot overflow the call stack.
+//
+class JsonReader{
+public:
+    JsonReader(const char* data, size_t bytes)
+        : m_start(data)
+        , m_ptr(data)
+        , m_end(data + bytes)
+    {}
+
+    bool parse(JsonValue& value);
+    std::string error_message() const;
+
+private:
+    struct Frame{
+        Frame(bool p_is_object)
+            : is_object(p_is_object)
+        {}
+        bool is_object;
+        JsonArray array;
+        JsonObject object;
+        std::string key;
+    };
+
+    bool fail(const char* message){
+        if (m_error == nullptr){
+            m_error = message;
+            m_error_offset = m_ptr - m_start;
+        }
+        return false;
+    }
+
+    void skip_whitespace(){
+        while (m_ptr < m_end){
+            switch (*m_ptr){
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                m_ptr++;
+                continue;
+            }
+            return;
+        }
+    }
+    bool expect(char ch, const char* message){
+        skip_whitespace();
+        if (m_ptr == m_end || *m_ptr != ch){
+            return fail(message);
+        }
+        m_ptr++;
+        return true;
+    }
+
+    bool parse_literal(const char* text, size_t length);
+    bool parse_key(std::string& key);
+    bool parse_hex4(uint32_t& code);
+    bool parse_string(std::string& str);
+    bool parse_number(JsonValue& value);
+    bool parse_number_slow(JsonValue& value, const char* start);
+
+private:
+    const char* m_start;
+    const char* m_ptr;
+    const char* m_end;
+
+    const char* m_error = nullptr;
+    size_t m_error_offset = 0;
+};
+
+
+std::string JsonReader::error_message() const{
+    if (m_error == nullptr){
+        return "";
+    }
+    return "JSON parse error at byte " + std::to_string(m_error_offset) + ": " + m_error;
+}
+
+
+bool JsonReader::parse_literal(const char* text, size_t length){
+    if ((size_t)(m_end - m_ptr) < length || memcmp(m_ptr, text, length) != 0){
+        return fail("Invalid literal.");
+    }
+    m_ptr += length;
+    return true;
+}
+bool JsonReader::parse_key(std::string& key){
+    skip_whitespace();
+    if (m_ptr == m_end || *m_ptr != '"'){
+        return fail("Expected an object key.");
+    }
+    if (!parse_string(key)){
+        return false;
+    }
+    return expect(':', "Expected ':' after object key.");
+}
+bool JsonReader::parse_hex4(uint32_t& code){
+    if (m_end - m_ptr < 4){
+        return fail("Truncated \\u escape.");
+    }
+    code = 0;
+    for (size_t c = 0; c < 4; c++){
+        char ch = *m_ptr++;
+        code <<= 4;
+        if ('0' <= ch && ch <= '9'){
+            code |= ch - '0';
+        }else if ('a' <= ch && ch <= 'f'){
+            code |= ch - 'a' + 10;
+        }else if ('A' <= ch && ch <= 'F'){
+            code |= ch - 'A' + 10;
+        }else{
+            return fail("Invalid \\u escape.");
+        }
+    }
+    return true;
+}
+bool JsonReader::parse_string(std::string& str){
+    str.clear();
+    m_ptr++;    //  Opening quote.
+
+    //  Copy unescaped runs in bulk.
+    const char* run = m_ptr;
+    while (true){
+        if (m_ptr == m_end){
+            return fail("Unterminated string.");
+        }
+        unsigned char ch = *m_ptr;
+        if (ch == '"'){
+            str.append(run, m_ptr);
+            m_ptr++;
+            return true;
+        }
+        if (ch < 0x20){
+            return fail("Control character in string.");
+        }
+        if (ch != '\\'){
+            m_ptr++;
+            continue;
+        }
+
+        str.append(run, m_ptr);
+        m_ptr++;
+        if (m_ptr == m_end){
+            return fail("Unterminated string.");
+        }
+        switch (*m_ptr++){
+        case '"':   str += '"';     break;
+        case '\\':  str += '\\';    break;
+        case '/':   str += '/';     break;
+        case 'b':   str += '\b';    break;
+        case 'f':   str += '\f';    break;
+        case 'n':   str += '\n';    break;
+        case 'r':   str += '\r';    break;
+        case 't':   str += '\t';    break;
+        case 'u':{
+            uint32_t code;
+            if (!parse_hex4(code)){
+                return false;
+            }
+            if (0xdc00 <= code && code <= 0xdfff){
+                return fail("Unpaired low surrogate.");
+            }
+            if (0xd800 <= code && code <= 0xdbff){
+                if (m_end - m_ptr < 2 || m_ptr[0] != '\\' || m_ptr[1] != 'u'){
+                    return fail("Unpaired high surrogate.");
+                }
+                m_ptr += 2;
+                uint32_t low;
+                if (!parse_hex4(low)){
+                    return false;
+                }
+                if (low < 0xdc00 || low > 0xdfff){
+                    return fail("Unpaired high surrogate.");
+                }
+                code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+            }
+            append_utf8(str, code);
+            break;
+        }
+        default:
+            m_ptr--;
+            return fail("Invalid escape sequence.");
+        }
+        run = m_ptr;
+    }
+}
+bool JsonReader::parse_number(JsonValue& value){
+    const char* start = m_ptr;
+
+    bool negative = false;
+    if (*m_ptr == '-'){
+        negative = true;
+        m_ptr++;
+    }
+    if (m_ptr == m_end || *m_ptr < '0' || *m_ptr > '9'){
+        return fail("Invalid value.");
+    }
+
+    //  Accumulate the significant digits. If they don't fit in 64 bits, the
+    //  slow path takes over.
+    uint64_t mantissa = 0;
+    bool truncated = false;
+    auto accumulate = [&](char ch){
+        uint64_t digit = ch - '0';
+        if (mantissa > (UINT64_MAX - digit) / 10){
+            truncated = true;
+            return false;
+        }
+        mantissa = mantissa * 10 + digit;
+        return true;
+    };
+
+    if (*m_ptr == '0'){
+        m_ptr++;
+    }else{
+        while (m_ptr < m_end && '0' <= *m_ptr && *m_ptr <= '9'){
+            accumulate(*m_ptr++);
+        }
+    }
+
+    bool is_float = false;
+    int64_t exponent = 0;
+    if (m_ptr < m_end && *m_ptr == '.'){
+        is_float = true;
+        m_ptr++;
+        if (m_ptr == m_end || *m_ptr < '0' || *m_ptr > '9'){
+            return fail("Expected digits after decimal point.");
+        }
+        while (m_ptr < m_end && '0' <= *m_ptr && *m_ptr <= '9'){
+            if (!truncated && accumulate(*m_ptr)){
+                exponent--;
+            }
+            m_ptr++;
+        }
+    }
+    if (m_ptr < m_end && (*m_ptr == 'e' || *m_ptr == 'E')){
+        is_float = true;
+        m_ptr++;
+        bool exponent_negative = false;
+        if (m_ptr < m_end && (*m_ptr == '+' || *m_ptr == '-')){
+            exponent_negative = *m_ptr == '-';
+            m_ptr++;
+        }
+        if (m_ptr == m_end || *m_ptr < '0' || *m_ptr > '9'){
+            return fail("Expected digits in exponent.");
+        }
+        int64_t e = 0;
+        while (m_ptr < m_end && '0' <= *m_ptr && *m_ptr <= '9'){
+            e = std::min<int64_t>(e * 10 + (*m_ptr - '0'), 100000);
+            m_ptr++;
+        }
+        exponent += exponent_negative ? -e : e;
+    }
+
+    if (truncated){
+        return parse_number_slow(value, start);
+    }
+
+    if (!is_float){
+        if (!negative){
+            //  Same as nlohmann: values above INT64_MAX are stored unsigned
+            //  and wrap when read back as int64_t.
+            value = JsonValue((int64_t)mantissa);
+            return true;
+        }
+        if (mantissa <= (uint64_t)1 << 63){
+            value = JsonValue((int64_t)(0 - mantissa));
+            return true;
+        }
+        return parse_number_slow(value, start);
+    }
+
+    //  Fast path: both the mantissa and the power of 10 are exact doubles,
+    //  so a single multiply or divide is correctly rounded.
+    if (mantissa <= (uint64_t)1 << 53 && -22 <= exponent && exponent <= 22){
+        double x = (double)mantissa;
+        if (exponent < 0){
+            x /= POWERS_OF_10[-exponent];
+        }else{
+            x *= POWERS_OF_10[exponent];
+        }
+        value = JsonValue(negative ? -x : x);
+        return true;
+    }
+
+    return parse_number_slow(value, start);
+}
+bool JsonReader::parse_number_slow(JsonValue& value, const char* start){
+    //  The number has already been validated. Use the classic locale so the
+    //  decimal point doesn't depend on the user's system settings.
+    std::istringstream stream(std::string(start, m_ptr));
+    stream.imbue(std::locale::classic());
+    double x;
+    stream >> x;
+    if (stream.fail()){
+        m_ptr = start;
+        return fail("Number out of range.");
+    }
+    value = JsonValue(x);
+    return true;
+}
+
+
+bool JsonReader::parse(JsonValue& root){
+    if (m_end - m_ptr >= 3 && memcmp(m_ptr, "\xef\xbb\xbf", 3) == 0){
+        m_ptr += 3;
+    }
+
+    std::vector<Frame> stack;
+    JsonValue value;
+    while (true){
+        //  Start of a value.
+        skip_whitespace();
+        if (m_ptr == m_end){
+            return fail("Unexpected end of input.");
+        }
+        switch (*m_ptr){
+        case '{':
+            m_ptr++;
+            stack.emplace_back(true);
+            skip_whitespace();
+            if (m_ptr < m_end && *m_ptr == '}'){
+                m_ptr++;
+                value = JsonValue(std::move(stack.back().object));
+                stack.pop_back();
+                break;
+            }
+            if (!parse_key(stack.back().key)){
+                return false;
+            }
+            continue;
+        case '[':
+            m_ptr++;
+            stack.emplace_back(false);
+            skip_whitespace();
+            if (m_ptr < m_end && *m_ptr == ']'){
+                m_ptr++;
+                value = JsonValue(std::move(stack.back().array));
+                stack.pop_back();
+                break;
+            }
+            continue;
+        case '"':{
+            std::string str;
+            if (!parse_string(str)){
+                return false;
+            }
+            value = JsonValue(std::move(str));
+            break;
+        }
+        case 't':
+            if (!parse_literal("true", 4)){
+                return false;
+            }
+            value = JsonValue(true);
+            break;
+        case 'f':
+            if (!parse_literal("false", 5)){
+                return false;
+            }
+            value = JsonValue(false);
+            break;
+        case 'n':
+            if (!parse_literal("null", 4)){
+                return false;
+            }
+            value = JsonValue();
+            break;
+        default:
+            if (!parse_number(value)){
+                return false;
+            }
+        }
+
+        //  A value is complete. Attach it to its parent and close every
+        //  container that ends here.
+        while (true){
+            if (stack.empty()){
+                skip_whitespace();
+                if (m_ptr != m_end){
+                    return fail("Unexpected characters after the end of the document.");
+                }
+                root = std::move(value);
+                return true;
+            }
+
+            Frame& top = stack.back();
+            if (top.is_object){
+                top.object[std::move(top.key)] = std::move(value);
+            }else{
+                top.array.push_back(std::move(value));
+            }
+
+            skip_whitespace();
+            if (m_ptr == m_end){
+                return fail("Unexpected end of input.");
+            }
+            char ch = *m_ptr++;
+            if (ch == ','){
+                if (top.is_object && !parse_key(top.key)){
+                    return false;
+                }
+                break;
+            }
+            if (top.is_object && ch == '}'){
+                value = JsonValue(std::move(top.object));
+                stack.pop_back();
+                continue;
+            }
+            if (!top.is_object && ch == ']'){
+                value = JsonValue(std::move(top.array));
+                stack.pop_back();
+                continue;
+            }
+            m_ptr--;
+            return fail(top.is_object ? "Expected ',' or '}'." : "Expected ',' or ']'.");
+        }
+    }
+}
+
+
+}
+
+
+
+bool parse_json_direct(
+    JsonValue& value,
+    const char* data, size_t bytes,
+    std::string* error
+){
+    JsonReader reader(data, bytes);
+    JsonValue ret;
+    if (!reader.parse(ret)){
+        value.clear();
+        if (error != nullptr){
+            *error = reader.error_message();
+        }
+        return false;
+    }
+    value = std::move(ret);
+    return true;
+}
+
+
+
+}
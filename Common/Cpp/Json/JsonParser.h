@@ -0,0 +1,32 @@
+/*  JSON Parser
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Streaming JSON parser that builds JsonValue directly from the text
+ *  without going through an intermediate nlohmann::json DOM.
+ *
+ */
+
+#ifndef PokemonAutomation_Common_Json_JsonParser_H
+#define PokemonAutomation_Common_Json_JsonParser_H
+
+#include <string>
+#include "JsonValue.h"
+
+namespace PokemonAutomation{
+
+
+//  Parse strict JSON (RFC 8259). A leading UTF-8 BOM is skipped.
+//
+//  On success, returns true and assigns the result to "value".
+//  On failure, returns false, leaves "value" as null and writes a
+//  description of the error to "error" (if not null).
+bool parse_json_direct(
+    JsonValue& value,
+    const char* data, size_t bytes,
+    std::string* error = nullptr
+);
+
+
+}
+#endif
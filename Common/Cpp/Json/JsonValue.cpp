@@ -4,11 +4,12 @@
  *
  */
 
-#include "3rdParty/nlohmann/json.hpp"
 #include "JsonValue.h"
 #include "JsonArray.h"
 #include "JsonObject.h"
 #include "JsonTools.h"
+#include "JsonParser.h"
+#include "JsonWriter.h"
 
 namespace PokemonAutomation{
 
@@ -363,13 +364,18 @@ bool JsonValue::read_string(std::string& value) const{
 
 
 JsonValue parse_json(const std::string& str){
-    return from_nlohmann(nlohmann::json::parse(str, nullptr, false));
+    //  Malformed input returns null.
+    JsonValue ret;
+    parse_json_direct(ret, str.data(), str.size());
+    return ret;
 }
 JsonValue load_json_file(const std::string& str){
     return parse_json(file_to_string(str));
 }
 std::string JsonValue::dump(int indent) const{
-    return to_nlohmann(*this).dump(indent);
+    std::string ret;
+    write_json(ret, *this, indent);
+    return ret;
 }
 void JsonValue::dump(const std::string& filename, int indent) const{
     string_to_file(filename, dump(indent));
@@ -0,0 +1,177 @@
+/*  JSON Writer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <charconv>
+#include "3rdParty/nlohmann/json.hpp"
+#include "JsonArray.h"
+#include "JsonObject.h"
+#include "JsonWriter.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+class JsonWriter{
+public:
+    JsonWriter(std::string& out, int indent)
+        : m_out(out)
+        , m_pretty(indent >= 0)
+        , m_indent(indent >= 0 ? indent : 0)
+    {}
+
+    void write_value(const JsonValue& value, size_t depth);
+    void write_array(const JsonArray& array, size_t depth);
+    void write_object(const JsonObject& object, size_t depth);
+
+private:
+    void newline(size_t depth){
+        if (m_pretty){
+            m_out += '\n';
+            m_out.append(depth * m_indent, ' ');
+        }
+    }
+    void write_integer(int64_t x);
+    void write_float(double x);
+    void write_string(const std::string& str);
+
+private:
+    std::string& m_out;
+    bool m_pretty;
+    size_t m_indent;
+};
+
+
+void JsonWriter::write_integer(int64_t x){
+    char buffer[24];
+    char* end = std::to_chars(buffer, buffer + sizeof(buffer), x).ptr;
+    m_out.append(buffer, end);
+}
+void JsonWriter::write_float(double x){
+    if (!std::isfinite(x)){
+        m_out += "null";
+        return;
+    }
+    //  Use nlohmann's shortest round-trip formatting so the output doesn't
+    //  change from before.
+    char buffer[64];
+    char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), x);
+    m_out.append(buffer, end);
+}
+void JsonWriter::write_string(const std::string& str){
+    static const char HEX[] = "0123456789abcdef";
+    m_out += '"';
+    const char* run = str.data();
+    const char* end = run + str.size();
+    for (const char* ptr = run; ptr < end; ptr++){
+        unsigned char ch = *ptr;
+        if (ch >= 0x20 && ch != '"' && ch != '\\'){
+            continue;
+        }
+        m_out.append(run, ptr);
+        run = ptr + 1;
+        switch (ch){
+        case '"':   m_out += "\\\"";    break;
+        case '\\':  m_out += "\\\\";    break;
+        case '\b':  m_out += "\\b";     break;
+        case '\f':  m_out += "\\f";     break;
+        case '\n':  m_out += "\\n";     break;
+        case '\r':  m_out += "\\r";     break;
+        case '\t':  m_out += "\\t";     break;
+        default:
+            m_out += "\\u00";
+            m_out += HEX[ch >> 4];
+            m_out += HEX[ch & 0xf];
+        }
+    }
+    m_out.append(run, end);
+    m_out += '"';
+}
+
+void JsonWriter::write_value(const JsonValue& value, size_t depth){
+    switch (value.type()){
+    case JsonType::EMPTY:
+        m_out += "null";
+        return;
+    case JsonType::BOOLEAN:
+        m_out += value.to_boolean_default() ? "true" : "false";
+        return;
+    case JsonType::INTEGER:
+        write_integer(value.to_integer_default());
+        return;
+    case JsonType::FLOAT:
+        write_float(value.to_double_default());
+        return;
+    case JsonType::STRING:
+        write_string(*value.to_string());
+        return;
+    case JsonType::ARRAY:
+        write_array(*value.to_array(), depth);
+        return;
+    case JsonType::OBJECT:
+        write_object(*value.to_object(), depth);
+        return;
+    }
+}
+void JsonWriter::write_array(const JsonArray& array, size_t depth){
+    if (array.empty()){
+        m_out += "[]";
+        return;
+    }
+    m_out += '[';
+    bool first = true;
+    for (const JsonValue& item : array){
+        if (!first){
+            m_out += ',';
+        }
+        first = false;
+        newline(depth + 1);
+        write_value(item, depth + 1);
+    }
+    newline(depth);
+    m_out += ']';
+}
+void JsonWriter::write_object(const JsonObject& object, size_t depth){
+    if (object.empty()){
+        m_out += "{}";
+        return;
+    }
+    m_out += '{';
+    bool first = true;
+    for (const auto& item : object){
+        if (!first){
+            m_out += ',';
+        }
+        first = false;
+        newline(depth + 1);
+        write_string(item.first);
+        m_out += m_pretty ? ": " : ":";
+        write_value(item.second, depth + 1);
+    }
+    newline(depth);
+    m_out += '}';
+}
+
+
+}
+
+
+
+void write_json(std::string& out, const JsonValue& value, int indent){
+    JsonWriter(out, indent).write_value(value, 0);
+}
+void write_json(std::string& out, const JsonArray& value, int indent){
+    JsonWriter(out, indent).write_array(value, 0);
+}
+void write_json(std::string& out, const JsonObject& value, int indent){
+    JsonWriter(out, indent).write_object(value, 0);
+}
+
+
+
+}
@@ -0,0 +1,31 @@
+/*  JSON Writer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Serializes JsonValue straight to text without going through an
+ *  intermediate nlohmann::json DOM.
+ *
+ *  The output matches nlohmann::json::dump() with one exception: empty
+ *  objects are written as "{}". The old path through to_nlohmann() wrote
+ *  them as "null".
+ *
+ */
+
+#ifndef PokemonAutomation_Common_Json_JsonWriter_H
+#define PokemonAutomation_Common_Json_JsonWriter_H
+
+#include <string>
+#include "JsonValue.h"
+
+namespace PokemonAutomation{
+
+
+//  Append the serialized value to "out".
+//  If "indent" is negative, the output is compact (no whitespace).
+void write_json(std::string& out, const JsonValue& value, int indent = 4);
+void write_json(std::string& out, const JsonArray& value, int indent = 4);
+void write_json(std::string& out, const JsonObject& value, int indent = 4);
+
+
+}
+#endif
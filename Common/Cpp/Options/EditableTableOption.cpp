@@ -23,11 +23,22 @@ namespace PokemonAutomation{
 //{}
 EditableTableRow::EditableTableRow(EditableTableOption& parent_table)
     : m_parent_table(parent_table)
+    , m_cell_listener(*this)
     , m_index((size_t)0 - 1)
 {}
 void EditableTableRow::add_option(ConfigOption& option, std::string serialization_string){
+    //  The cells are members of the row and are destroyed before it.
+    //  So there's nothing to remove later.
+    option.add_listener(m_cell_listener);
     m_options.emplace_back(std::move(serialization_string), &option);
 }
+void EditableTableRow::CellListener::value_changed(void* object){
+    //  Orphaned rows (such as snapshot clones) don't affect the table.
+    if (row.m_index.load(std::memory_order_relaxed) == (size_t)0 - 1){
+        return;
+    }
+    row.m_parent_table.m_version.fetch_add(1, std::memory_order_acq_rel);
+}
 void EditableTableRow::load_json(const JsonValue& json){
     if (m_options.size() == 1){
         m_options[0].second->load_json(json);
@@ -88,6 +99,8 @@ EditableTableOption::EditableTableOption(
     , m_label(std::move(label))
     , m_enable_saveload(true)
     , m_default(std::move(default_value))
+    , m_current(std::make_shared<const RowList>())
+    , m_version(0)
 {
     restore_defaults();
 }
@@ -101,6 +114,8 @@ EditableTableOption::EditableTableOption(
     , m_label(std::move(label))
     , m_enable_saveload(enable_saveload)
     , m_default(std::move(default_value))
+    , m_current(std::make_shared<const RowList>())
+    , m_version(0)
 {
     restore_defaults();
 }
@@ -109,17 +124,20 @@ void EditableTableOption::set_default(std::vector<std::unique_ptr<EditableTableR
     m_default = std::move(default_value);
 }
 size_t EditableTableOption::current_rows() const{
-    ReadSpinLock lg(m_current_lock);
-    return m_current.size();
+    return current_list()->size();
 }
 std::vector<std::shared_ptr<EditableTableRow>> EditableTableOption::current_refs() const{
-    ReadSpinLock lg(m_current_lock);
-    return m_current;
+    return *current_list();
+}
+void EditableTableOption::publish(std::shared_ptr<const RowList> list){
+    //  Caller must hold "m_current_lock" for writing.
+    m_current = std::move(list);
+    m_version.fetch_add(1, std::memory_order_acq_rel);
 }
 
 void EditableTableOption::clear(){
     WriteSpinLock lg(m_current_lock);
-    m_current.clear();
+    publish(std::make_shared<const RowList>());
 }
 void EditableTableOption::load_json(const JsonValue& json){
     const JsonArray* array = json.to_array();
@@ -141,7 +159,7 @@ void EditableTableOption::load_json(const JsonValue& json){
         //  But the table can't finish building until current_refs() finishes.
         //  Building the table outside of the lock bypasses this issue since the listeners won't be 
         //  triggered in the first place.
-        std::vector<std::shared_ptr<EditableTableRow>> table;
+        RowList table;
         for (const auto& item : *array){
             std::unique_ptr<EditableTableRow> row = make_row();
             row->m_seqnum = seqnum++;
@@ -152,22 +170,22 @@ void EditableTableOption::load_json(const JsonValue& json){
 
         //  Now commit the table inside the lock.
         WriteSpinLock lg(m_current_lock);
-        m_current = std::move(table);
+        publish(std::make_shared<const RowList>(std::move(table)));
     }
     report_value_changed(this);
 }
 JsonValue EditableTableOption::to_json() const{
-    ReadSpinLock lg(m_current_lock);
+    std::shared_ptr<const RowList> list = current_list();
     JsonArray array;
-    for (const std::shared_ptr<EditableTableRow>& row : m_current){
+    for (const std::shared_ptr<EditableTableRow>& row : *list){
         array.push_back(row->to_json());
     }
     return array;
 }
 
 std::string EditableTableOption::check_validity() const{
-    ReadSpinLock lg(m_current_lock);
-    for (const std::shared_ptr<EditableTableRow>& item : m_current){
+    std::shared_ptr<const RowList> list = current_list();
+    for (const std::shared_ptr<EditableTableRow>& item : *list){
         std::string error = item->check_validity();
         if (!error.empty()){
             return error;
@@ -177,7 +195,7 @@ std::string EditableTableOption::check_validity() const{
 }
 void EditableTableOption::restore_defaults(){
     {
-        std::vector<std::shared_ptr<EditableTableRow>> tmp;
+        RowList tmp;
         {
             ReadSpinLock lg(m_default_lock);
 
@@ -196,7 +214,7 @@ void EditableTableOption::restore_defaults(){
 
         //  Now commit the table inside the lock.
         WriteSpinLock lg(m_current_lock);
-        m_current = std::move(tmp);
+        publish(std::make_shared<const RowList>(std::move(tmp)));
     }
     report_value_changed(this);
 }
@@ -206,13 +224,15 @@ void EditableTableOption::restore_defaults(){
 void EditableTableOption::insert_row(size_t index, std::unique_ptr<EditableTableRow> row){
     {
         WriteSpinLock lg(m_current_lock);
-        index = std::min(index, m_current.size());
+        RowList table = *m_current;
+        index = std::min(index, table.size());
         row->m_seqnum = m_seqnum++;
-        m_current.insert(m_current.begin() + index, std::move(row));
-        size_t stop = m_current.size();
+        table.insert(table.begin() + index, std::move(row));
+        size_t stop = table.size();
         for (size_t c = index; c < stop; c++){
-            m_current[c]->m_index.store(c, std::memory_order_relaxed);
+            table[c]->m_index.store(c, std::memory_order_relaxed);
         }
+        publish(std::make_shared<const RowList>(std::move(table)));
     }
     report_value_changed(this);
 }
@@ -232,12 +252,14 @@ void EditableTableOption::clone_row(const EditableTableRow& row){
 
         //  Now add it to the table.
         WriteSpinLock lg(m_current_lock);
-        index = std::min(index, m_current.size());
-        m_current.insert(m_current.begin() + index, std::move(new_row));
-        size_t stop = m_current.size();
+        RowList table = *m_current;
+        index = std::min(index, table.size());
+        table.insert(table.begin() + index, std::move(new_row));
+        size_t stop = table.size();
         for (size_t c = index; c < stop; c++){
-            m_current[c]->m_index.store(c, std::memory_order_relaxed);
+            table[c]->m_index.store(c, std::memory_order_relaxed);
         }
+        publish(std::make_shared<const RowList>(std::move(table)));
     }
     report_value_changed(this);
 }
@@ -250,13 +272,15 @@ void EditableTableOption::remove_row(EditableTableRow& row){
         }
 
         WriteSpinLock lg(m_current_lock);
-        auto iter = m_current.begin() + index;
+        RowList table = *m_current;
+        auto iter = table.begin() + index;
         (*iter)->m_index.store((size_t)0 - 1, std::memory_order_relaxed);
-        m_current.erase(iter);
-        size_t stop = m_current.size();
+        table.erase(iter);
+        size_t stop = table.size();
         for (size_t c = index; c < stop; c++){
-            m_current[c]->m_index.store(c, std::memory_order_relaxed);
+            table[c]->m_index.store(c, std::memory_order_relaxed);
         }
+        publish(std::make_shared<const RowList>(std::move(table)));
     }
     report_value_changed(this);
 }
@@ -9,6 +9,9 @@
 
 #include <memory>
 #include <vector>
+#include <map>
+#include <typeinfo>
+#include <typeindex>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "ConfigOption.h"
 
@@ -39,6 +42,8 @@ public:
 
 
 protected:
+    //  "option" must be owned by the row. Changes to it will bump the table's
+    //  version. (see EditableTableOption::version())
     void add_option(ConfigOption& option, std::string serialization_string);
 
 #define PA_ADD_OPTION(x)    add_option(x, #x)
@@ -54,7 +59,14 @@ public:
 private:
     friend class EditableTableOption;
 
+    struct CellListener : public ConfigOption::Listener{
+        EditableTableRow& row;
+        CellListener(EditableTableRow& p_row) : row(p_row) {}
+        virtual void value_changed(void* object) override;
+    };
+
     EditableTableOption& m_parent_table;
+    CellListener m_cell_listener;
 
     //  A unique # for this row within its table.
     uint64_t m_seqnum = 0;
@@ -70,7 +82,20 @@ private:
 
 
 //  This is the table itself.
+//
+//  The list of rows is copy-on-write. Adding or removing rows publishes a new
+//  immutable list so that readers can grab the current one in O(1) without
+//  copying anything. (current_list())
+//
+//  The rows themselves are live and can be edited by the user at any time.
+//  Every change to the table or to a cell of one of its rows increments
+//  version(). shared_copy_snapshot() and shared_snapshot() cache their result
+//  against it so that calling them repeatedly only clones the table once for
+//  each time it is actually changed.
 class EditableTableOption : public ConfigOption{
+public:
+    using RowList = std::vector<std::shared_ptr<EditableTableRow>>;
+
 public:
     EditableTableOption(
         std::string label,
@@ -93,17 +118,30 @@ public:
     //  this for bound-checking where it's unsafe to read out-of-bounds.
     size_t current_rows() const;
 
+    //  Incremented every time a row is added/removed or a cell is changed.
+    //  If this hasn't changed, neither has anything in the table.
+    uint64_t version() const{
+        return m_version.load(std::memory_order_acquire);
+    }
+
     //  Return a list of references to all the rows at this exact moment.
     //  These reference are live in that they may be asynchronously changed.
     std::vector<std::shared_ptr<EditableTableRow>> current_refs() const;
 
+    //  Same as above, but without copying the list. The list will never change.
+    //  The rows in it are still live.
+    std::shared_ptr<const RowList> current_list() const{
+        ReadSpinLock lg(m_current_lock);
+        return m_current;
+    }
+
     //  Return a copy of the entire table at the exact moment this is called.
     template <typename RowType>
     std::vector<std::unique_ptr<RowType>> copy_snapshot() const{
+        std::shared_ptr<const RowList> list = current_list();
         std::vector<std::unique_ptr<RowType>> ret;
-        ReadSpinLock lg(m_current_lock);
-        ret.reserve(m_current.size());
-        for (auto& item : m_current){
+        ret.reserve(list->size());
+        for (auto& item : *list){
             std::unique_ptr<EditableTableRow> parent = item->clone();
             std::unique_ptr<RowType> ptr(static_cast<RowType*>(parent.release()));
             ret.emplace_back(std::move(ptr));
@@ -112,14 +150,38 @@ public:
     }
     template <typename RowType, typename RowSnapshotType>
     std::vector<RowSnapshotType> snapshot() const{
-        std::vector<RowSnapshotType> ret;
-        ReadSpinLock lg(m_current_lock);
-        ret.reserve(m_current.size());
-        for (auto& item : m_current){
-            RowType& row = static_cast<RowType&>(*item);
-            ret.emplace_back(row.snapshot());
-        }
-        return ret;
+        return *shared_snapshot<RowType, RowSnapshotType>();
+    }
+
+    //  Immutable versions of the above that are shared by all callers.
+    //  These only clone the table if it has changed since the last call.
+    template <typename RowType>
+    std::shared_ptr<const std::vector<std::unique_ptr<const RowType>>> shared_copy_snapshot() const{
+        using Snapshot = std::vector<std::unique_ptr<const RowType>>;
+        return cached<Snapshot>([this]{
+            std::shared_ptr<const RowList> list = current_list();
+            Snapshot ret;
+            ret.reserve(list->size());
+            for (auto& item : *list){
+                std::unique_ptr<EditableTableRow> parent = item->clone();
+                ret.emplace_back(static_cast<const RowType*>(parent.release()));
+            }
+            return ret;
+        });
+    }
+    template <typename RowType, typename RowSnapshotType>
+    std::shared_ptr<const std::vector<RowSnapshotType>> shared_snapshot() const{
+        using Snapshot = std::vector<RowSnapshotType>;
+        return cached<Snapshot>([this]{
+            std::shared_ptr<const RowList> list = current_list();
+            Snapshot ret;
+            ret.reserve(list->size());
+            for (auto& item : *list){
+                const RowType& row = static_cast<const RowType&>(*item);
+                ret.emplace_back(row.snapshot());
+            }
+            return ret;
+        });
     }
 
     void clear();
@@ -143,6 +205,39 @@ public:
 public:
     virtual ConfigWidget* make_QtWidget(QWidget& parent) override;
 
+private:
+    friend class EditableTableRow;
+
+    void publish(std::shared_ptr<const RowList> list);
+
+    //  Return the cached "Snapshot" if the table hasn't changed since it was
+    //  built. Otherwise build a new one with "build" and cache it.
+    template <typename Snapshot, typename Builder>
+    std::shared_ptr<const Snapshot> cached(Builder&& build) const{
+        const std::type_index type(typeid(Snapshot));
+
+        //  Read the version first. If the table changes while building, the
+        //  snapshot is stored under the older version and gets rebuilt next time.
+        uint64_t version = this->version();
+        {
+            ReadSpinLock lg(m_cache_lock);
+            auto iter = m_cache.find(type);
+            if (iter != m_cache.end() && iter->second.first == version){
+                return std::static_pointer_cast<const Snapshot>(iter->second.second);
+            }
+        }
+
+        std::shared_ptr<const Snapshot> ret = std::make_shared<const Snapshot>(build());
+
+        WriteSpinLock lg(m_cache_lock);
+        std::pair<uint64_t, std::shared_ptr<const void>>& entry = m_cache[type];
+        if (entry.second == nullptr || entry.first <= version){
+            entry.first = version;
+            entry.second = ret;
+        }
+        return ret;
+    }
+
 private:
     const std::string m_label;
     const bool m_enable_saveload;
@@ -151,7 +246,12 @@ private:
 
     mutable SpinLock m_current_lock;
     std::atomic<uint64_t> m_seqnum = 0;
-    std::vector<std::shared_ptr<EditableTableRow>> m_current;
+    std::shared_ptr<const RowList> m_current;
+
+    std::atomic<uint64_t> m_version;
+
+    mutable SpinLock m_cache_lock;
+    mutable std::map<std::type_index, std::pair<uint64_t, std::shared_ptr<const void>>> m_cache;
 };
 
 
@@ -170,6 +270,15 @@ public:
         return EditableTableOption::snapshot<RowType, RowSnapshotType>();
     }
 
+    std::shared_ptr<const std::vector<std::unique_ptr<const RowType>>> shared_copy_snapshot() const{
+        return EditableTableOption::shared_copy_snapshot<RowType>();
+    }
+
+    template <typename RowSnapshotType>
+    std::shared_ptr<const std::vector<RowSnapshotType>> shared_snapshot() const{
+        return EditableTableOption::shared_snapshot<RowType, RowSnapshotType>();
+    }
+
     virtual std::unique_ptr<EditableTableRow> make_row() override{
         return std::unique_ptr<EditableTableRow>(new RowType(*this));
     }
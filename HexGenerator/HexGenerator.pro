@@ -27,8 +27,10 @@ SOURCES += \
     ../Common/Cpp/Exceptions.cpp \
     ../Common/Cpp/Json/JsonArray.cpp \
     ../Common/Cpp/Json/JsonObject.cpp \
+    ../Common/Cpp/Json/JsonParser.cpp \
     ../Common/Cpp/Json/JsonTools.cpp \
     ../Common/Cpp/Json/JsonValue.cpp \
+    ../Common/Cpp/Json/JsonWriter.cpp \
     ../Common/Cpp/LifetimeSanitizer.cpp \
     ../Common/Cpp/Options/BooleanCheckBoxOption.cpp \
     ../Common/Cpp/Options/ConfigOption.cpp \
@@ -86,8 +88,10 @@ HEADERS += \
     ../Common/Cpp/Exceptions.h \
     ../Common/Cpp/Json/JsonArray.h \
     ../Common/Cpp/Json/JsonObject.h \
+    ../Common/Cpp/Json/JsonParser.h \
     ../Common/Cpp/Json/JsonTools.h \
     ../Common/Cpp/Json/JsonValue.h \
+    ../Common/Cpp/Json/JsonWriter.h \
     ../Common/Cpp/LifetimeSanitizer.h \
     ../Common/Cpp/Options/BooleanCheckBoxOption.h \
     ../Common/Cpp/Options/ConfigOption.h \
@@ -89,6 +89,7 @@ SOURCES += \
     ../Common/Cpp/Concurrency/ScheduledTaskRunner.cpp \
     ../Common/Cpp/Concurrency/SpinLock.cpp \
     ../Common/Cpp/Concurrency/Watchdog.cpp \
+    ../Common/Cpp/Concurrency/WorkStealingPool.cpp \
     ../Common/Cpp/Containers/AlignedMalloc.cpp \
     ../Common/Cpp/CpuId/CpuId.cpp \
     ../Common/Cpp/EnumDatabase.cpp \
@@ -96,8 +97,10 @@ SOURCES += \
     ../Common/Cpp/ImageResolution.cpp \
     ../Common/Cpp/Json/JsonArray.cpp \
     ../Common/Cpp/Json/JsonObject.cpp \
+    ../Common/Cpp/Json/JsonParser.cpp \
     ../Common/Cpp/Json/JsonTools.cpp \
     ../Common/Cpp/Json/JsonValue.cpp \
+    ../Common/Cpp/Json/JsonWriter.cpp \
     ../Common/Cpp/LifetimeSanitizer.cpp \
     ../Common/Cpp/Options/BatchOption.cpp \
     ../Common/Cpp/Options/BooleanCheckBoxOption.cpp \
@@ -163,6 +166,7 @@ SOURCES += \
     Source/CommonFramework/AudioPipeline/IO/AudioFileLoader.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioSink.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioSource.cpp \
+    Source/CommonFramework/AudioPipeline/IO/AudioSpectrumReplay.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp \
@@ -177,6 +181,7 @@ SOURCES += \
     Source/CommonFramework/CrashDump.cpp \
     Source/CommonFramework/Environment/Environment.cpp \
     Source/CommonFramework/Environment/HardwareValidation.cpp \
+    Source/CommonFramework/Environment/KernelAutotuner.cpp \
     Source/CommonFramework/Environment/SystemSleep.cpp \
     Source/CommonFramework/Exceptions/FatalProgramException.cpp \
     Source/CommonFramework/Exceptions/OperationFailedException.cpp \
@@ -224,8 +229,10 @@ SOURCES += \
     Source/CommonFramework/Inference/SpectrogramMatcher.cpp \
     Source/CommonFramework/Inference/StatAccumulator.cpp \
     Source/CommonFramework/InferenceInfra/AudioInferencePivot.cpp \
+    Source/CommonFramework/InferenceInfra/InferenceExecutor.cpp \
     Source/CommonFramework/InferenceInfra/InferenceRoutines.cpp \
     Source/CommonFramework/InferenceInfra/InferenceSession.cpp \
+    Source/CommonFramework/InferenceInfra/VisualChangeTracker.cpp \
     Source/CommonFramework/InferenceInfra/VisualInferenceCallback.cpp \
     Source/CommonFramework/InferenceInfra/VisualInferencePivot.cpp \
     Source/CommonFramework/Language.cpp \
@@ -272,6 +279,8 @@ SOURCES += \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.cpp \
     Source/CommonFramework/PersistentSettings.cpp \
     Source/CommonFramework/ProgramSession.cpp \
+    Source/CommonFramework/Resources/BinaryResourceCache.cpp \
+    Source/CommonFramework/Resources/ResourceWarmup.cpp \
     Source/CommonFramework/Resources/SpriteDatabase.cpp \
     Source/CommonFramework/SetupSettings.cpp \
     Source/CommonFramework/Tools/BlackBorderCheck.cpp \
@@ -283,13 +292,16 @@ SOURCES += \
     Source/CommonFramework/Tools/InterruptableCommands.cpp \
     Source/CommonFramework/Tools/MultiConsoleErrors.cpp \
     Source/CommonFramework/Tools/ProgramEnvironment.cpp \
+    Source/CommonFramework/Tools/ReplayClock.cpp \
     Source/CommonFramework/Tools/StatsDatabase.cpp \
     Source/CommonFramework/Tools/StatsTracking.cpp \
     Source/CommonFramework/Tools/SuperControlSession.cpp \
     Source/CommonFramework/Tools/VideoResolutionCheck.cpp \
+    Source/CommonFramework/VideoPipeline/Backends/CameraFileReplay.cpp \
     Source/CommonFramework/VideoPipeline/Backends/CameraImplementations.cpp \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt5.cpp \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.cpp \
+    Source/CommonFramework/VideoPipeline/Backends/ReplayFrameSource.cpp \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.cpp \
     Source/CommonFramework/VideoPipeline/CameraOption.cpp \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.cpp \
@@ -297,6 +309,7 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWindow.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoOverlayWidget.cpp \
+    Source/CommonFramework/VideoPipeline/VideoBurst.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayOption.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlaySession.cpp \
     Source/CommonFramework/VideoPipeline/VideoOverlayTypes.cpp \
@@ -312,6 +325,7 @@ SOURCES += \
     Source/Integrations/DiscordIntegrationTable.cpp \
     Source/Integrations/DiscordSettingsOption.cpp \
     Source/Integrations/DiscordWebhook.cpp \
+    Source/Integrations/DiscordWebhookDelivery.cpp \
     Source/Integrations/DiscordWebhookSettings.cpp \
     Source/Integrations/DppIntegration/DppClient.cpp \
     Source/Integrations/DppIntegration/DppCommandHandler.cpp \
@@ -356,6 +370,10 @@ SOURCES += \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX2.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX512.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageBlockMean.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageBlockMean_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageBlockMean_x64_AVX2.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageBlockMean_x64_SSE41.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_Default.cpp \
@@ -835,6 +853,7 @@ SOURCES += \
     Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_ShinySparkleSet.cpp \
     Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleDetectorRadial.cpp \
     Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleDetectorSquare.cpp \
+    Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleHeatMap.cpp \
     Source/PokemonSwSh/Inference/Sounds/PokemonSwSh_BerryTreeRustlingSoundDetector.cpp \
     Source/PokemonSwSh/InferenceTraining/PokemonSwSh_GenerateIVCheckerOCR.cpp \
     Source/PokemonSwSh/InferenceTraining/PokemonSwSh_GenerateNameOCRPokedex.cpp \
@@ -842,6 +861,7 @@ SOURCES += \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.cpp \
+    Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Rollout.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_SelectItem.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_SelectMove.cpp \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_SelectPath.cpp \
@@ -896,6 +916,7 @@ SOURCES += \
     Source/PokemonSwSh/Options/PokemonSwSh_DateToucher.cpp \
     Source/PokemonSwSh/Options/PokemonSwSh_EggStepOption.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Battle.cpp \
+    Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_DamageTable.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Field.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.cpp \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Moves.cpp \
@@ -989,13 +1010,22 @@ SOURCES += \
     Source/PokemonSwSh/ShinyHuntTracker.cpp \
     Source/Tests/CommandLineTests.cpp \
     Source/Tests/CommonFramework_Tests.cpp \
+    Source/Tests/Concurrency_Benchmarks.cpp \
+    Source/Tests/Concurrency_Tests.cpp \
+    Source/Tests/DiscordWebhook_Tests.cpp \
+    Source/Tests/InferencePivot_Benchmarks.cpp \
+    Source/Tests/Json_Benchmarks.cpp \
+    Source/Tests/Kernels_Benchmarks.cpp \
     Source/Tests/Kernels_Tests.cpp \
     Source/Tests/NintendoSwitch_Tests.cpp \
     Source/Tests/PokemonLA_Tests.cpp \
     Source/Tests/PokemonSV_Tests.cpp \
     Source/Tests/PokemonSwSh_Tests.cpp \
+    Source/Tests/TestAllocationCounter.cpp \
     Source/Tests/TestMap.cpp \
     Source/Tests/TestUtils.cpp \
+    Source/Tests/VideoOverlay_Benchmarks.cpp \
+    Source/Tests/VideoOverlay_Tests.cpp \
     Source/ZeldaTotK/Programs/ZeldaTotK_BowItemDuper.cpp \
     Source/ZeldaTotK/Programs/ZeldaTotK_MineruItemDuper.cpp \
     Source/ZeldaTotK/Programs/ZeldaTotK_ParaglideItemDuper.cpp \
@@ -1099,6 +1129,7 @@ HEADERS += \
     ../Common/Cpp/Concurrency/SpinLock.h \
     ../Common/Cpp/Concurrency/SpinPause.h \
     ../Common/Cpp/Concurrency/Watchdog.h \
+    ../Common/Cpp/Concurrency/WorkStealingPool.h \
     ../Common/Cpp/Containers/AlignedMalloc.h \
     ../Common/Cpp/Containers/AlignedVector.h \
     ../Common/Cpp/Containers/AlignedVector.tpp \
@@ -1120,8 +1151,10 @@ HEADERS += \
     ../Common/Cpp/ImageResolution.h \
     ../Common/Cpp/Json/JsonArray.h \
     ../Common/Cpp/Json/JsonObject.h \
+    ../Common/Cpp/Json/JsonParser.h \
     ../Common/Cpp/Json/JsonTools.h \
     ../Common/Cpp/Json/JsonValue.h \
+    ../Common/Cpp/Json/JsonWriter.h \
     ../Common/Cpp/LifetimeSanitizer.h \
     ../Common/Cpp/Options/BatchOption.h \
     ../Common/Cpp/Options/BooleanCheckBoxOption.h \
@@ -1205,6 +1238,7 @@ HEADERS += \
     Source/CommonFramework/AudioPipeline/IO/AudioFileLoader.h \
     Source/CommonFramework/AudioPipeline/IO/AudioSink.h \
     Source/CommonFramework/AudioPipeline/IO/AudioSource.h \
+    Source/CommonFramework/AudioPipeline/IO/AudioSpectrumReplay.h \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.h \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.h \
@@ -1232,6 +1266,7 @@ HEADERS += \
     Source/CommonFramework/Environment/HardwareValidation.h \
     Source/CommonFramework/Environment/HardwareValidation_arm64.tpp \
     Source/CommonFramework/Environment/HardwareValidation_x86.tpp \
+    Source/CommonFramework/Environment/KernelAutotuner.h \
     Source/CommonFramework/Environment/SystemSleep.h \
     Source/CommonFramework/Exceptions/FatalProgramException.h \
     Source/CommonFramework/Exceptions/OperationFailedException.h \
@@ -1286,8 +1321,10 @@ HEADERS += \
     Source/CommonFramework/InferenceInfra/AudioInferenceCallback.h \
     Source/CommonFramework/InferenceInfra/AudioInferencePivot.h \
     Source/CommonFramework/InferenceInfra/InferenceCallback.h \
+    Source/CommonFramework/InferenceInfra/InferenceExecutor.h \
     Source/CommonFramework/InferenceInfra/InferenceRoutines.h \
     Source/CommonFramework/InferenceInfra/InferenceSession.h \
+    Source/CommonFramework/InferenceInfra/VisualChangeTracker.h \
     Source/CommonFramework/InferenceInfra/VisualInferenceCallback.h \
     Source/CommonFramework/InferenceInfra/VisualInferencePivot.h \
     Source/CommonFramework/Language.h \
@@ -1336,6 +1373,8 @@ HEADERS += \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.h \
     Source/CommonFramework/PersistentSettings.h \
     Source/CommonFramework/ProgramSession.h \
+    Source/CommonFramework/Resources/BinaryResourceCache.h \
+    Source/CommonFramework/Resources/ResourceWarmup.h \
     Source/CommonFramework/Resources/SpriteDatabase.h \
     Source/CommonFramework/SetupSettings.h \
     Source/CommonFramework/Tools/BlackBorderCheck.h \
@@ -1347,13 +1386,16 @@ HEADERS += \
     Source/CommonFramework/Tools/InterruptableCommands.h \
     Source/CommonFramework/Tools/MultiConsoleErrors.h \
     Source/CommonFramework/Tools/ProgramEnvironment.h \
+    Source/CommonFramework/Tools/ReplayClock.h \
     Source/CommonFramework/Tools/StatsDatabase.h \
     Source/CommonFramework/Tools/StatsTracking.h \
     Source/CommonFramework/Tools/SuperControlSession.h \
     Source/CommonFramework/Tools/VideoResolutionCheck.h \
+    Source/CommonFramework/VideoPipeline/Backends/CameraFileReplay.h \
     Source/CommonFramework/VideoPipeline/Backends/CameraImplementations.h \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt5.h \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.h \
+    Source/CommonFramework/VideoPipeline/Backends/ReplayFrameSource.h \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.h \
     Source/CommonFramework/VideoPipeline/CameraInfo.h \
     Source/CommonFramework/VideoPipeline/CameraOption.h \
@@ -1365,6 +1407,7 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWindow.h \
     Source/CommonFramework/VideoPipeline/UI/VideoOverlayWidget.h \
     Source/CommonFramework/VideoPipeline/UI/VideoWidget.h \
+    Source/CommonFramework/VideoPipeline/VideoBurst.h \
     Source/CommonFramework/VideoPipeline/VideoFeed.h \
     Source/CommonFramework/VideoPipeline/VideoOverlay.h \
     Source/CommonFramework/VideoPipeline/VideoOverlayOption.h \
@@ -1383,6 +1426,7 @@ HEADERS += \
     Source/Integrations/DiscordIntegrationTable.h \
     Source/Integrations/DiscordSettingsOption.h \
     Source/Integrations/DiscordWebhook.h \
+    Source/Integrations/DiscordWebhookDelivery.h \
     Source/Integrations/DiscordWebhookSettings.h \
     Source/Integrations/DppIntegration/DppClient.h \
     Source/Integrations/DppIntegration/DppCommandHandler.h \
@@ -1434,10 +1478,13 @@ HEADERS += \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_t.h \
     Source/Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.tpp \
+    Source/Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixView.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h \
+    Source/Kernels/ImageStats/Kernels_ImageBlockMean.h \
+    Source/Kernels/ImageStats/Kernels_ImageBlockMean_Routines.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h \
     Source/Kernels/Kernels_Alignment.h \
@@ -1932,6 +1979,7 @@ HEADERS += \
     Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_ShinySparkleSet.h \
     Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleDetectorRadial.h \
     Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleDetectorSquare.h \
+    Source/PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleHeatMap.h \
     Source/PokemonSwSh/Inference/Sounds/PokemonSwSh_BerryTreeRustlingSoundDetector.h \
     Source/PokemonSwSh/InferenceTraining/PokemonSwSh_GenerateIVCheckerOCR.h \
     Source/PokemonSwSh/InferenceTraining/PokemonSwSh_GenerateNameOCRPokedex.h \
@@ -1939,6 +1987,7 @@ HEADERS += \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.h \
+    Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Rollout.h \
     Source/PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Tools.h \
     Source/PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_CatchScreenTracker.h \
     Source/PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_Notifications.h \
@@ -1991,6 +2040,7 @@ HEADERS += \
     Source/PokemonSwSh/Options/PokemonSwSh_EncounterBotCommon.h \
     Source/PokemonSwSh/Options/PokemonSwSh_RegiSelector.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Battle.h \
+    Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_DamageTable.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Field.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h \
     Source/PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Moves.h \
@@ -2089,13 +2139,22 @@ HEADERS += \
     Source/PokemonSwSh/ShinyHuntTracker.h \
     Source/Tests/CommandLineTests.h \
     Source/Tests/CommonFramework_Tests.h \
+    Source/Tests/Concurrency_Benchmarks.h \
+    Source/Tests/Concurrency_Tests.h \
+    Source/Tests/DiscordWebhook_Tests.h \
+    Source/Tests/InferencePivot_Benchmarks.h \
+    Source/Tests/Json_Benchmarks.h \
+    Source/Tests/Kernels_Benchmarks.h \
     Source/Tests/Kernels_Tests.h \
     Source/Tests/NintendoSwitch_Tests.h \
     Source/Tests/PokemonLA_Tests.h \
     Source/Tests/PokemonSV_Tests.h \
     Source/Tests/PokemonSwSh_Tests.h \
+    Source/Tests/TestAllocationCounter.h \
     Source/Tests/TestMap.h \
     Source/Tests/TestUtils.h \
+    Source/Tests/VideoOverlay_Benchmarks.h \
+    Source/Tests/VideoOverlay_Tests.h \
     Source/ZeldaTotK/Programs/ZeldaTotK_BowItemDuper.h \
     Source/ZeldaTotK/Programs/ZeldaTotK_MineruItemDuper.h \
     Source/ZeldaTotK/Programs/ZeldaTotK_ParaglideItemDuper.h \
@@ -0,0 +1,114 @@
+/*  Audio Spectrum Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/AudioPipeline/AudioConstants.h"
+#include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "AudioSpectrumReplay.h"
+
+namespace PokemonAutomation{
+
+
+//  Match the history length of AudioSpectrumHolder.
+const size_t REPLAY_SPECTRUM_HISTORY_LENGTH = 40;
+
+
+AudioSpectrumReplay::AudioSpectrumReplay(const std::string& path, ReplayPacing pacing, size_t sample_rate)
+    : m_sample_rate(sample_rate)
+    , m_clock(pacing, (double)sample_rate / FFT_SLIDING_WINDOW_STEP)
+    , m_released(0)
+{
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".txt") == 0){
+        std::ifstream file(path);
+        if (!file){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open spectrum file.", path);
+        }
+        std::string line;
+        std::vector<float> values;
+        while (std::getline(file, line)){
+            values.clear();
+            std::istringstream ss(line);
+            float value;
+            while (ss >> value){
+                values.emplace_back(value);
+            }
+            if (values.empty()){
+                continue;
+            }
+            AlignedVector<float> spectrum(values.size());
+            memcpy(spectrum.data(), values.data(), values.size() * sizeof(float));
+            m_spectrums.emplace_back(std::make_shared<const AlignedVector<float>>(std::move(spectrum)));
+        }
+    }else{
+        AudioTemplate audio = loadAudioTemplate(path, sample_rate);
+        for (size_t c = 0; c < audio.numWindows(); c++){
+            AlignedVector<float> spectrum(audio.numFrequencies());
+            memcpy(spectrum.data(), audio.getWindow(c), audio.numFrequencies() * sizeof(float));
+            m_spectrums.emplace_back(std::make_shared<const AlignedVector<float>>(std::move(spectrum)));
+        }
+    }
+    if (m_spectrums.empty()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "No spectrums found.", path);
+    }
+}
+
+bool AudioSpectrumReplay::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_released >= m_spectrums.size();
+}
+void AudioSpectrumReplay::reset(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_clock.restart();
+    m_released = 0;
+}
+void AudioSpectrumReplay::step(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_clock.step();
+}
+void AudioSpectrumReplay::advance(){
+    uint64_t index = m_clock.current_index();
+    size_t released = (size_t)std::min<uint64_t>(index + 1, m_spectrums.size());
+    m_released = std::max(m_released, released);
+}
+
+std::vector<AudioSpectrum> AudioSpectrumReplay::spectrums_since(uint64_t starting_seqnum){
+    std::lock_guard<std::mutex> lg(m_lock);
+    advance();
+
+    std::vector<AudioSpectrum> ret;
+    size_t oldest = m_released > REPLAY_SPECTRUM_HISTORY_LENGTH
+        ? m_released - REPLAY_SPECTRUM_HISTORY_LENGTH
+        : 0;
+    for (size_t c = m_released; c > oldest; c--){
+        uint64_t stamp = c - 1;
+        if (stamp < starting_seqnum){
+            break;
+        }
+        ret.emplace_back(stamp, m_sample_rate, m_spectrums[stamp]);
+    }
+    return ret;
+}
+std::vector<AudioSpectrum> AudioSpectrumReplay::spectrums_latest(size_t num_last_spectrums){
+    std::lock_guard<std::mutex> lg(m_lock);
+    advance();
+
+    std::vector<AudioSpectrum> ret;
+    size_t count = std::min(num_last_spectrums, std::min(m_released, REPLAY_SPECTRUM_HISTORY_LENGTH));
+    for (size_t c = 0; c < count; c++){
+        uint64_t stamp = m_released - 1 - c;
+        ret.emplace_back(stamp, m_sample_rate, m_spectrums[stamp]);
+    }
+    return ret;
+}
+
+
+
+}
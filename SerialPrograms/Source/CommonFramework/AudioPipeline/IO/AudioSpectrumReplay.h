@@ -0,0 +1,68 @@
+/*  Audio Spectrum Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      An AudioFeed that replays recorded spectrums instead of listening to
+ *  an audio device. This is the audio counterpart of the file replay camera.
+ *
+ *  Sources:
+ *    - ".txt": One spectrum per line as written by
+ *              AudioSpectrumHolder::saveAudioFrequenciesToDisk().
+ *    - Anything else is loaded as an audio file with loadAudioTemplate().
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioSpectrumReplay_H
+#define PokemonAutomation_AudioPipeline_AudioSpectrumReplay_H
+
+#include <string>
+#include <mutex>
+#include "CommonFramework/Tools/ReplayClock.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+
+namespace PokemonAutomation{
+
+
+class AudioSpectrumReplay : public AudioFeed{
+public:
+    //  Throws FileException if the source cannot be loaded.
+    AudioSpectrumReplay(const std::string& path, ReplayPacing pacing, size_t sample_rate = 48000);
+
+    size_t total_spectrums() const{ return m_spectrums.size(); }
+
+    //  Returns true once every spectrum has been released.
+    bool finished() const;
+
+    //  AS_FAST_AS_POSSIBLE: Release the next spectrum. Call this once per
+    //  tick after every consumer has read the current one.
+    void step();
+
+public:
+    //  Start over from the first spectrum.
+    virtual void reset() override;
+
+    virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) override;
+    virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override;
+
+    //  There is no spectrogram display to draw on. Ignored.
+    virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override{}
+
+private:
+    //  Release spectrums according to the pacing. Must hold the lock.
+    void advance();
+
+private:
+    const size_t m_sample_rate;
+    std::vector<std::shared_ptr<const AlignedVector<float>>> m_spectrums;
+
+    mutable std::mutex m_lock;
+    ReplayClock m_clock;
+
+    //  # of spectrums released so far.
+    size_t m_released;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,221 @@
+/*  Kernel Autotuner
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <random>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/AbstractLogger.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/Waterfill/Kernels_Waterfill.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "Environment.h"
+#include "KernelAutotuner.h"
+
+namespace PokemonAutomation{
+
+using namespace Kernels;
+using namespace Kernels::Waterfill;
+
+
+namespace{
+
+const BinaryMatrixType ALL_BINARY_MATRIX_TYPES[] = {
+    BinaryMatrixType::i64x4_Default,
+    BinaryMatrixType::i64x8_Default,
+    BinaryMatrixType::i64x8_x64_SSE42,
+    BinaryMatrixType::i64x16_x64_AVX2,
+    BinaryMatrixType::i64x32_x64_AVX512,
+    BinaryMatrixType::i64x64_x64_AVX512,
+    BinaryMatrixType::arm64x8_x64_NEON,
+};
+
+bool parse_BinaryMatrixType(BinaryMatrixType& type, const std::string& name){
+    for (BinaryMatrixType item : ALL_BINARY_MATRIX_TYPES){
+        if (name == get_BinaryMatrixType_name(item)){
+            type = item;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string current_processor_level(){
+    size_t index = GlobalSettings::instance().PROCESSOR_LEVEL0.current_value();
+    const std::vector<CpuCapabilityOption>& levels = AVAILABLE_CAPABILITIES();
+    return index < levels.size() ? levels[index].slug : "";
+}
+
+
+//  A 1080p frame with a few dozen solid blobs on a dark noisy background.
+//  This is roughly what the detectors feed into waterfill.
+struct SyntheticFrame{
+    static const size_t WIDTH = 1920;
+    static const size_t HEIGHT = 1080;
+    static const size_t BYTES_PER_ROW = WIDTH * sizeof(uint32_t);
+
+    AlignedVector<uint32_t> pixels;
+
+    SyntheticFrame()
+        : pixels(WIDTH * HEIGHT)
+    {
+        std::mt19937 rng(12345);
+        for (size_t c = 0; c < WIDTH * HEIGHT; c++){
+            pixels[c] = 0xff000000 | ((uint32_t)rng() & 0x003f3f3f);
+        }
+        for (size_t b = 0; b < 48; b++){
+            size_t w = 8 + rng() % 192;
+            size_t h = 8 + rng() % 128;
+            size_t x0 = rng() % (WIDTH - w);
+            size_t y0 = rng() % (HEIGHT - h);
+            for (size_t y = y0; y < y0 + h; y++){
+                for (size_t x = x0; x < x0 + w; x++){
+                    pixels[y * WIDTH + x] = 0xffc0c0c0 | ((uint32_t)rng() & 0x003f3f3f);
+                }
+            }
+        }
+    }
+};
+
+struct Candidate{
+    BinaryMatrixType type;
+    bool avx512gf;
+};
+
+std::string candidate_name(const Candidate& candidate){
+    std::string ret = get_BinaryMatrixType_name(candidate.type);
+    if (candidate.avx512gf){
+        ret += " (GF)";
+    }
+    return ret;
+}
+
+//  Best time over a few runs of a typical filter + waterfill pass.
+std::chrono::microseconds time_candidate(const SyntheticFrame& frame, const Candidate& candidate){
+    set_Waterfill_AVX512GF_enabled(candidate.avx512gf);
+    std::unique_ptr<PackedBinaryMatrix_IB> matrix = make_PackedBinaryMatrix(
+        candidate.type, SyntheticFrame::WIDTH, SyntheticFrame::HEIGHT
+    );
+
+    const size_t RUNS = 6;
+    std::chrono::microseconds best = std::chrono::microseconds::max();
+    for (size_t c = 0; c < RUNS; c++){
+        WallClock start = current_time();
+        compress_rgb32_to_binary_range(
+            frame.pixels.data(), SyntheticFrame::BYTES_PER_ROW,
+            *matrix, 0xff808080, 0xffffffff
+        );
+        find_objects_inplace(*matrix, 20);
+        WallClock end = current_time();
+
+        //  First run is warm-up.
+        if (c != 0){
+            best = std::min(best, std::chrono::duration_cast<std::chrono::microseconds>(end - start));
+        }
+    }
+    return best;
+}
+
+
+}
+
+
+
+bool KernelProfile::matches_current() const{
+    return !binary_matrix.empty() &&
+        processor == get_processor_name() &&
+        level == current_processor_level();
+}
+void KernelProfile::load_json(const JsonValue& json){
+    const JsonObject* obj = json.to_object();
+    if (obj == nullptr){
+        return;
+    }
+    obj->read_string(processor, "ProcessorString");
+    obj->read_string(level, "Level");
+    obj->read_string(binary_matrix, "BinaryMatrix");
+    obj->read_boolean(waterfill_avx512gf, "WaterfillAVX512GF");
+}
+JsonValue KernelProfile::to_json() const{
+    JsonObject obj;
+    obj["ProcessorString"] = processor;
+    obj["Level"] = level;
+    obj["BinaryMatrix"] = binary_matrix;
+    obj["WaterfillAVX512GF"] = waterfill_avx512gf;
+    return obj;
+}
+
+
+
+KernelProfile run_kernel_autotuner(Logger& logger){
+    logger.log("Kernel Autotuner: Timing kernels for this machine...", COLOR_BLUE);
+
+    std::vector<Candidate> candidates;
+    for (BinaryMatrixType type : ALL_BINARY_MATRIX_TYPES){
+        if (!is_BinaryMatrixType_supported(type)){
+            continue;
+        }
+        candidates.emplace_back(Candidate{type, false});
+        bool avx512 = type == BinaryMatrixType::i64x32_x64_AVX512 || type == BinaryMatrixType::i64x64_x64_AVX512;
+        if (avx512 && CPU_CAPABILITY_CURRENT.OK_19_IceLake){
+            candidates.emplace_back(Candidate{type, true});
+        }
+    }
+
+    SyntheticFrame frame;
+    const Candidate* best = nullptr;
+    std::chrono::microseconds best_time = std::chrono::microseconds::max();
+    for (const Candidate& candidate : candidates){
+        std::chrono::microseconds time = time_candidate(frame, candidate);
+        logger.log(
+            "Kernel Autotuner: " + candidate_name(candidate) + " : " +
+            tostr_fixed(time.count() / 1000., 3) + " ms"
+        );
+        if (time < best_time){
+            best = &candidate;
+            best_time = time;
+        }
+    }
+
+    KernelProfile profile;
+    profile.processor = get_processor_name();
+    profile.level = current_processor_level();
+    if (best != nullptr){
+        profile.binary_matrix = get_BinaryMatrixType_name(best->type);
+        profile.waterfill_avx512gf = best->avx512gf;
+    }
+    set_Waterfill_AVX512GF_enabled(true);
+    return profile;
+}
+
+void apply_kernel_profile(Logger& logger, const KernelProfile& profile){
+    BinaryMatrixType type;
+    if (!parse_BinaryMatrixType(type, profile.binary_matrix)){
+        clear_BinaryMatrixType_override();
+        set_Waterfill_AVX512GF_enabled(true);
+        return;
+    }
+    set_BinaryMatrixType_override(type);
+    set_Waterfill_AVX512GF_enabled(profile.waterfill_avx512gf);
+
+    Candidate candidate{get_BinaryMatrixType(), use_Waterfill_AVX512GF()};
+    logger.log("Kernel Profile: Using " + candidate_name(candidate), COLOR_BLUE);
+}
+
+void load_or_tune_kernel_profile(Logger& logger, KernelProfile& profile){
+    if (!profile.matches_current()){
+        profile = run_kernel_autotuner(logger);
+    }
+    apply_kernel_profile(logger, profile);
+}
+
+
+
+}
@@ -0,0 +1,55 @@
+/*  Kernel Autotuner
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Some kernels have more than one implementation at the same processor level.
+ *  (e.g. AVX512 64x32 vs. 64x64 binary matrix tiles, or AVX512-GF waterfill.)
+ *  The processor level alone does not say which one is fastest on a given
+ *  machine. So time them once and remember the winner per machine.
+ *
+ */
+
+#ifndef PokemonAutomation_KernelAutotuner_H
+#define PokemonAutomation_KernelAutotuner_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+class JsonValue;
+class Logger;
+
+
+struct KernelProfile{
+    //  What the profile was tuned on. A profile only applies to the same
+    //  processor at the same processor level.
+    std::string processor;
+    std::string level;
+
+    //  Winner per kernel family.
+    std::string binary_matrix;      //  Kernels::get_BinaryMatrixType_name()
+    bool waterfill_avx512gf = true;
+
+    //  Whether this profile was tuned on this machine at the current level.
+    bool matches_current() const;
+
+    void load_json(const JsonValue& json);
+    JsonValue to_json() const;
+};
+
+
+//  Time every binary matrix tile and waterfill variant that the current
+//  processor level supports on synthetic 1080p frames. Return the fastest.
+KernelProfile run_kernel_autotuner(Logger& logger);
+
+//  Make the kernel factories use the choices in "profile".
+//  Choices that the current processor level cannot run are ignored.
+void apply_kernel_profile(Logger& logger, const KernelProfile& profile);
+
+//  Called at startup. Tune if "profile" is missing or stale, then apply it.
+void load_or_tune_kernel_profile(Logger& logger, KernelProfile& profile);
+
+
+
+}
+#endif
@@ -6,6 +6,8 @@
 
 //#include "Common/Cpp/Concurrency/ScheduledTaskRunner.h"
 #include "Common/Cpp/Concurrency/Watchdog.h"
+#include "Common/Cpp/Concurrency/WorkStealingPool.h"
+#include "GlobalSettingsPanel.h"
 #include "GlobalServices.h"
 
 namespace PokemonAutomation{
@@ -25,6 +27,13 @@ Watchdog& global_watchdog(){
     static Watchdog watchdog;
     return watchdog;
 }
+WorkStealingPool& global_compute_pool(){
+    static WorkStealingPool pool(
+        [](){ GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread(); },
+        0
+    );
+    return pool;
+}
 
 
 
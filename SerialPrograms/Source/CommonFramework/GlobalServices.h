@@ -12,12 +12,18 @@ namespace PokemonAutomation{
 class AsyncDispatcher;
 class ScheduledTaskRunner;
 class Watchdog;
+class WorkStealingPool;
 
 
 //AsyncDispatcher& global_async_dispatcher();
 //ScheduledTaskRunner& global_scheduled_task_runner();
 Watchdog& global_watchdog();
 
+//  One thread per CPU thread at compute priority. Shared by all fine-grained
+//  parallel compute so that the program doesn't end up with a pool per call
+//  site. Compute only. Nothing on it may block on other tasks.
+WorkStealingPool& global_compute_pool();
+
 
 
 }
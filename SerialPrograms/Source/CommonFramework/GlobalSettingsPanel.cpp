@@ -52,6 +52,25 @@ ResolutionOption::ResolutionOption(
 }
 
 
+NotificationScreenshotOption::NotificationScreenshotOption()
+    : GroupOption("Notification Screenshots:", LockMode::LOCK_WHILE_RUNNING)
+    , JPG_QUALITY(
+        "<b>JPG Quality:</b><br>Quality (1-100) of JPG screenshots attached to notifications.",
+        LockMode::LOCK_WHILE_RUNNING,
+        75, 1, 100
+    )
+    , MAX_HEIGHT(
+        "<b>Maximum Height:</b><br>Scale screenshots attached to notifications down to this height. "
+        "Zero keeps the original size. Screenshots that are also saved to disk are saved at full size and quality.",
+        LockMode::LOCK_WHILE_RUNNING,
+        0
+    )
+{
+    PA_ADD_OPTION(JPG_QUALITY);
+    PA_ADD_OPTION(MAX_HEIGHT);
+}
+
+
 
 
 PreloadSettings::PreloadSettings(){}
@@ -174,6 +193,21 @@ GlobalSettings::GlobalSettings()
         "Thread priority of computation threads.",
         DEFAULT_PRIORITY_COMPUTE
     )
+    , SKIP_UNCHANGED_INFERENCE(
+        "<b>Skip Unchanged Inference:</b><br>"
+        "Don't re-run image recognition on parts of the screen that haven't changed since the last time they were checked. "
+        "Uncheck this if a program fails to notice something on the screen.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        true
+    )
+    , INFERENCE_WORKERS(
+        "<b>Inference Workers:</b><br>"
+        "Maximum # of inference callbacks that can run at the same time across all consoles. "
+        "Zero means one per CPU thread.<br>"
+        "Changes take effect after restarting the program.",
+        LockMode::LOCK_WHILE_RUNNING,
+        0
+    )
     , AUDIO_FILE_VOLUME_SCALE(
         "<b>Audio File Input Volume Scale:</b><br>"
         "Multiply audio file playback by this factor. (This is linear scale. So each factor of 10 is 20dB.)",
@@ -237,6 +271,7 @@ GlobalSettings::GlobalSettings()
     PA_ADD_OPTION(CHECK_FOR_UPDATES);
     PA_ADD_OPTION(WINDOW_SIZE);
     PA_ADD_OPTION(THEME);
+    PA_ADD_OPTION(NOTIFICATION_SCREENSHOTS);
 
     PA_ADD_STATIC(m_discord_settings);
     PA_ADD_OPTION(DISCORD);
@@ -250,6 +285,8 @@ GlobalSettings::GlobalSettings()
     PA_ADD_OPTION(REALTIME_THREAD_PRIORITY0);
     PA_ADD_OPTION(INFERENCE_PRIORITY0);
     PA_ADD_OPTION(COMPUTE_PRIORITY0);
+    PA_ADD_OPTION(SKIP_UNCHANGED_INFERENCE);
+    PA_ADD_OPTION(INFERENCE_WORKERS);
 
     PA_ADD_OPTION(AUDIO_FILE_VOLUME_SCALE);
     PA_ADD_OPTION(AUDIO_DEVICE_VOLUME_SCALE);
@@ -294,6 +331,11 @@ void GlobalSettings::load_json(const JsonValue& json){
         ) + ")</font>"
     );
 
+    const JsonValue* kernel_profile = obj->get_value("KERNEL_PROFILE");
+    if (kernel_profile){
+        KERNEL_PROFILE.load_json(*kernel_profile);
+    }
+
     COMMAND_LINE_TEST_LIST.clear();
     COMMAND_LINE_IGNORE_LIST.clear();
     const JsonObject* command_line_tests_setting = obj->get_object("COMMAND_LINE_TESTS");
@@ -304,6 +346,9 @@ void GlobalSettings::load_json(const JsonValue& json){
             COMMAND_LINE_TEST_FOLDER = "CommandLineTests";
         }
 
+        command_line_tests_setting->read_integer(COMMAND_LINE_TEST_THREADS, "THREADS", 1, 256);
+        command_line_tests_setting->read_string(COMMAND_LINE_TEST_REPORT, "REPORT");
+
         const JsonArray* test_list = command_line_tests_setting->get_array("TEST_LIST");
         if (test_list){
             for (const auto& value: *test_list){
@@ -359,6 +404,8 @@ JsonValue GlobalSettings::to_json() const{
     JsonObject command_line_test_obj;
     command_line_test_obj["RUN"] = COMMAND_LINE_TEST_MODE;
     command_line_test_obj["FOLDER"] = COMMAND_LINE_TEST_FOLDER;
+    command_line_test_obj["THREADS"] = COMMAND_LINE_TEST_THREADS;
+    command_line_test_obj["REPORT"] = COMMAND_LINE_TEST_REPORT;
 
     {
         JsonArray test_list;
@@ -385,6 +432,8 @@ JsonValue GlobalSettings::to_json() const{
     debug_obj["IMAGE_DICTIONARY_MATCHING"] = debug_settings.IMAGE_DICTIONARY_MATCHING;
     obj["DEBUG"] = std::move(debug_obj);
 
+    obj["KERNEL_PROFILE"] = KERNEL_PROFILE.to_json();
+
     return obj;
 }
 
@@ -16,6 +16,7 @@
 #include "CommonFramework/Options/Environment/ProcessPriorityOption.h"
 #include "CommonFramework/Options/Environment/ProcessorLevelOption.h"
 #include "CommonFramework/Options/Environment/ThemeSelectorOption.h"
+#include "CommonFramework/Environment/KernelAutotuner.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
 #include "CommonFramework/Panels/SettingsPanel.h"
 #include "CommonFramework/Panels/PanelTools.h"
@@ -44,6 +45,17 @@ public:
 
 
 
+//  Applies to screenshots sent through every notification integration.
+class NotificationScreenshotOption : public GroupOption{
+public:
+    NotificationScreenshotOption();
+
+    SimpleIntegerOption<uint8_t> JPG_QUALITY;
+    SimpleIntegerOption<uint16_t> MAX_HEIGHT;
+};
+
+
+
 struct DebugSettings{
     bool COLOR_CHECK = false;
     bool IMAGE_TEMPLATE_MATCHING = false;
@@ -90,6 +102,8 @@ public:
     ResolutionOption WINDOW_SIZE;
     ThemeSelectorOption THEME;
 
+    NotificationScreenshotOption NOTIFICATION_SCREENSHOTS;
+
     SectionDividerOption m_discord_settings;
     Integration::DiscordSettingsOption DISCORD;
 
@@ -105,6 +119,8 @@ public:
     ThreadPriorityOption REALTIME_THREAD_PRIORITY0;
     ThreadPriorityOption INFERENCE_PRIORITY0;
     ThreadPriorityOption COMPUTE_PRIORITY0;
+    BooleanCheckBoxOption SKIP_UNCHANGED_INFERENCE;
+    SimpleIntegerOption<uint8_t> INFERENCE_WORKERS;
 
     FloatingPointOption AUDIO_FILE_VOLUME_SCALE;
     FloatingPointOption AUDIO_DEVICE_VOLUME_SCALE;
@@ -133,6 +149,16 @@ public:
     // Which tests to ignore running under the command line test mode.
     // If a test path appears in both COMMAND_LINE_TEST_LIST and COMMAND_LINE_IGNORE_LIST, it's still ignored.
     std::vector<std::string> COMMAND_LINE_IGNORE_LIST;
+    // Number of threads to run the test files on. 1 runs them in order on the
+    // main thread and stops at the first failure. More than 1 runs every test
+    // file and reports all failures at the end.
+    size_t COMMAND_LINE_TEST_THREADS = 1;
+    // If not empty, write a JSON report of per-test timings to this path.
+    std::string COMMAND_LINE_TEST_REPORT;
+
+    // Kernel dispatch choices timed on this machine. Re-tuned at startup if
+    // the processor or processor level has changed.
+    KernelProfile KERNEL_PROFILE;
 };
 
 
@@ -10,6 +10,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Resources/BinaryResourceCache.h"
 #include "CommonFramework/Tools/DebugDumper.h"
 #include "WaterfillTemplateMatcher.h"
 
@@ -24,12 +25,35 @@ using namespace Kernels;
 using namespace Kernels::Waterfill;
 
 
+//  Bump this whenever the template preprocessing below changes.
+const uint32_t WATERFILL_TEMPLATE_CACHE_VERSION = 1;
+
+
 WaterfillTemplateMatcher::WaterfillTemplateMatcher(
     const char* path,
     Color min_color, Color max_color,
     size_t min_area
 ){
     std::string full_path = RESOURCE_PATH() + path;
+
+    //  The cropped template only depends on the file and the filter settings.
+    //  If it's cached, skip the PNG decode and waterfill.
+    const std::string cache_name = std::string("WaterfillTemplates/") + path;
+    const uint64_t settings[] = {(uint32_t)min_color, (uint32_t)max_color, min_area};
+    const uint64_t source_hash = hash_resource_bytes(settings, sizeof(settings), hash_resource_file(full_path));
+    if (!PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
+        bool loaded = load_cached_resource(
+            cache_name, WATERFILL_TEMPLATE_CACHE_VERSION, source_hash,
+            [&](BinaryResourceReader& reader){
+                m_area_ratio = reader.read<double>();
+                m_matcher.reset(new ExactImageMatcher(reader.read_image<ImageRGB32>()));
+            }
+        );
+        if (loaded){
+            return;
+        }
+    }
+
     ImageRGB32 reference(full_path);
 
     PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(reference, (uint32_t)min_color, (uint32_t)max_color);
@@ -68,6 +92,11 @@ WaterfillTemplateMatcher::WaterfillTemplateMatcher(
              << " x " << exact_image.height() <<  ", area ratio: " << m_area_ratio << ", Object area: " << best->area << endl;
         dump_debug_image(global_logger_command_line(), "CommonFramework/WaterfillTemplateMatcher", "matcher_exact_image", exact_image);
     }
+
+    BinaryResourceWriter writer;
+    writer.write(m_area_ratio);
+    writer.write_image(m_matcher->image_template());
+    store_cached_resource(cache_name, WATERFILL_TEMPLATE_CACHE_VERSION, source_hash, writer);
 }
 
 double WaterfillTemplateMatcher::rmsd(const ImageViewRGB32& image) const{
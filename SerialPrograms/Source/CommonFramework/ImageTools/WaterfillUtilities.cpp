@@ -6,6 +6,7 @@
 
 #include <map>
 #include "Common/Cpp/Color.h"
+#include "Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixView.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
@@ -27,24 +28,20 @@ std::pair<PackedBinaryMatrix, size_t> remove_center_pixels(
     size_t num_pixels_to_remove
 ){
     PackedBinaryMatrix matrix = object.packed_matrix();
-    size_t width = matrix.width();
-    size_t height = matrix.height();
 //    cout << matrix.dump() << endl;
 
     //  Sort all pixels by distance from center.
     size_t center_x = object.center_of_gravity_x() - object.min_x;
     size_t center_y = object.center_of_gravity_y() - object.min_y;
     std::map<uint64_t, size_t> distances;
-    for (size_t r = 0; r < height; r++){
-        for (size_t c = 0; c < width; c++){
-            if (matrix.get(c, r)){
-                size_t dist_x = c - center_x;
-                size_t dist_y = r - center_y;
-                uint64_t distance_sqr = (uint64_t)dist_x*dist_x + (uint64_t)dist_y*dist_y;
-                distances[distance_sqr]++;
-            }
-        }
-    }
+    Kernels::visit_matrix((const Kernels::PackedBinaryMatrix_IB&)matrix, [&](auto view){
+        Kernels::for_each_set_bit(view, [&](size_t c, size_t r){
+            size_t dist_x = c - center_x;
+            size_t dist_y = r - center_y;
+            uint64_t distance_sqr = (uint64_t)dist_x*dist_x + (uint64_t)dist_y*dist_y;
+            distances[distance_sqr]++;
+        });
+    });
 
     //  Filter out pixels close to center
     size_t count = 0;
@@ -56,16 +53,16 @@ std::pair<PackedBinaryMatrix, size_t> remove_center_pixels(
             break;
         }
     }
-    for (size_t r = 0; r < height; r++){
-        for (size_t c = 0; c < width; c++){
+    Kernels::visit_matrix((Kernels::PackedBinaryMatrix_IB&)matrix, [&](auto view){
+        Kernels::for_each_set_bit(view, [&](size_t c, size_t r){
             size_t dist_x = c - center_x;
             size_t dist_y = r - center_y;
             uint64_t distance_sqr = (uint64_t)dist_x*dist_x + (uint64_t)dist_y*dist_y;
             if (distance_sqr < distance_sqr_th){
-                matrix.set(c, r, false);
+                view.set(c, r, false);
             }
-        }
-    }
+        });
+    });
 
     return std::pair<PackedBinaryMatrix, size_t>(std::move(matrix), distance_sqr_th);
 }
@@ -149,13 +146,11 @@ void draw_matrix_on_image(
     const PackedBinaryMatrix& matrix,
     uint32_t color, ImageRGB32& image, size_t offset_x, size_t offset_y
 ){
-    for (size_t x = 0; x < matrix.width(); x++){
-        for (size_t y = 0; y < matrix.height(); y++){
-            if (matrix.get(x, y)){
-                image.pixel(offset_x + x, offset_y + y) = (uint32_t)color;
-            }
-        }
-    }
+    Kernels::visit_matrix((const Kernels::PackedBinaryMatrix_IB&)matrix, [&](auto view){
+        Kernels::for_each_set_bit(view, [&](size_t x, size_t y){
+            image.pixel(offset_x + x, offset_y + y) = (uint32_t)color;
+        });
+    });
 }
 
 
@@ -163,14 +158,13 @@ void draw_object_on_image(
     const Kernels::Waterfill::WaterfillObject& obj,
     const uint32_t& color, ImageRGB32& image, size_t offset_x, size_t offset_y
 ){
-    for (size_t x = 0; x < obj.width(); x++){
-        for (size_t y = 0; y < obj.height(); y++){
-            if (obj.object->get(obj.min_x + x, obj.min_y + y)){
-                image.pixel(offset_x + obj.min_x + x, offset_y + obj.min_y + y) = color;
-                // cout << "Set color at " << offset_x + object.min_x + obj.min_x + x << ", " << offset_y + object.min_y + obj.min_y + y << endl;
-            }
-        }
-    }
+    std::unique_ptr<Kernels::PackedBinaryMatrix_IB> matrix = obj.packed_matrix();
+    Kernels::visit_matrix((const Kernels::PackedBinaryMatrix_IB&)*matrix, [&](auto view){
+        Kernels::for_each_set_bit(view, [&](size_t x, size_t y){
+            image.pixel(offset_x + obj.min_x + x, offset_y + obj.min_y + y) = color;
+            // cout << "Set color at " << offset_x + object.min_x + obj.min_x + x << ", " << offset_y + object.min_y + obj.min_y + y << endl;
+        });
+    });
 }
 
 
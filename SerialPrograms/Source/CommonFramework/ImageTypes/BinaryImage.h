@@ -64,7 +64,8 @@ public:
     size_t width() const{ return m_matrix->width(); }
     size_t height() const{ return m_matrix->height(); }
 
-    //  These are slow.
+    //  These are slow. For loops over many bits, use Kernels::visit_matrix().
+    //  (see Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixView.h)
     bool get(size_t x, size_t y) const{ return m_matrix->get(x, y); }
     void set(size_t x, size_t y, bool set){ m_matrix->set(x, y, set); }
 
@@ -31,7 +31,10 @@ AudioPerSpectrumDetectorBase::AudioPerSpectrumDetectorBase(
     , m_detected_callback(std::move(detected_callback))
     , m_start_timestamp(current_time())
     , m_spectrums_processed(0)
-{}
+{
+    //  Sounds are short. A late check can miss the window to react to them.
+    set_time_critical();
+}
 AudioPerSpectrumDetectorBase::~AudioPerSpectrumDetectorBase(){
     try{
         log_results();
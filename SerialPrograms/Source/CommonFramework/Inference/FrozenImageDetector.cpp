@@ -4,6 +4,10 @@
  *
  */
 
+#include <cmath>
+#include <algorithm>
+#include "Kernels/ImageStats/Kernels_ImageBlockMean.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageMatch/ImageDiff.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
@@ -16,27 +20,47 @@
 namespace PokemonAutomation{
 
 
-FrozenImageDetector::FrozenImageDetector(std::chrono::milliseconds timeout, double rmsd_threshold)
-    : VisualInferenceCallback("FrozenImageDetector")
-    , m_color(COLOR_CYAN)
-    , m_box(0.0, 0.0, 1.0, 1.0)
-    , m_timeout(timeout)
-    , m_rmsd_threshold(rmsd_threshold)
+//  Dimensions of the signature grid. 16:9 to match the video feed.
+const size_t SIGNATURE_GRID_WIDTH = 64;
+const size_t SIGNATURE_GRID_HEIGHT = 36;
+
+
+FrozenImageDetector::FrozenImageDetector(
+    std::chrono::milliseconds timeout, double rmsd_threshold,
+    Mode mode
+)
+    : FrozenImageDetector(COLOR_CYAN, {0.0, 0.0, 1.0, 1.0}, timeout, rmsd_threshold, mode)
 {}
 FrozenImageDetector::FrozenImageDetector(
     Color color, const ImageFloatBox& box,
-    std::chrono::milliseconds timeout, double rmsd_threshold
+    std::chrono::milliseconds timeout, double rmsd_threshold,
+    Mode mode
 )
     : VisualInferenceCallback("FrozenImageDetector")
     , m_color(color)
     , m_box(box)
     , m_timeout(timeout)
     , m_rmsd_threshold(rmsd_threshold)
-{}
+    , m_mode(mode)
+    , m_signature_width(0)
+    , m_signature_height(0)
+    , m_previous_index(0)
+    , m_previous_frame_width(0)
+    , m_previous_frame_height(0)
+    , m_previous_timestamp(WallClock::min())
+{
+    if (m_mode == Mode::SIGNATURE){
+        m_signatures.resize(2 * SIGNATURE_GRID_WIDTH * SIGNATURE_GRID_HEIGHT);
+    }
+}
 void FrozenImageDetector::make_overlays(VideoOverlaySet& set) const{
     set.add(m_color, m_box);
 }
 bool FrozenImageDetector::process_frame(const VideoSnapshot& frame){
+    if (m_mode == Mode::SIGNATURE){
+        return process_signature(*frame.frame, frame.timestamp);
+    }
+
     if (m_previous->width() != frame->width() || m_previous->height() != frame->height()){
         m_previous = frame;
         return false;
@@ -53,8 +77,57 @@ bool FrozenImageDetector::process_frame(const VideoSnapshot& frame){
 //    return false;
 }
 bool FrozenImageDetector::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
+    if (m_mode == Mode::SIGNATURE){
+        return process_signature(frame, timestamp);
+    }
     return process_frame(VideoSnapshot(frame.copy(), timestamp));
 }
+bool FrozenImageDetector::process_signature(const ImageViewRGB32& frame, WallClock timestamp){
+    if (!frame){
+        return false;
+    }
+
+    size_t current_index = m_previous_index ^ 1;
+    size_t grid_width = std::min(frame.width(), SIGNATURE_GRID_WIDTH);
+    size_t grid_height = std::min(frame.height(), SIGNATURE_GRID_HEIGHT);
+    uint32_t* current = m_signatures.data() + current_index * SIGNATURE_GRID_WIDTH * SIGNATURE_GRID_HEIGHT;
+    const uint32_t* previous = m_signatures.data() + m_previous_index * SIGNATURE_GRID_WIDTH * SIGNATURE_GRID_HEIGHT;
+
+    Kernels::image_block_mean(
+        current, grid_width, grid_height,
+        frame.data(), frame.bytes_per_row(),
+        frame.width(), frame.height()
+    );
+
+    //  Resolution changed. Start over.
+    if (m_previous_frame_width != frame.width() || m_previous_frame_height != frame.height()){
+        m_previous_index = current_index;
+        m_signature_width = grid_width;
+        m_signature_height = grid_height;
+        m_previous_frame_width = frame.width();
+        m_previous_frame_height = frame.height();
+        m_previous_timestamp = timestamp;
+        return false;
+    }
+
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation(
+        count, sumsqrs,
+        m_signature_width, m_signature_height,
+        previous, m_signature_width * sizeof(uint32_t),
+        current, m_signature_width * sizeof(uint32_t)
+    );
+    double rmsd = std::sqrt((double)sumsqrs / (double)count);
+//    cout << "rmsd = " << rmsd << endl;
+    if (rmsd > m_rmsd_threshold){
+        m_previous_index = current_index;
+        m_previous_timestamp = timestamp;
+        return false;
+    }
+
+    return timestamp - m_previous_timestamp > m_timeout;
+}
 
 
 }
@@ -8,6 +8,7 @@
 #ifndef PokemonAutomation_CommonFramework_FrozenImageDetector_H
 #define PokemonAutomation_CommonFramework_FrozenImageDetector_H
 
+#include <vector>
 #include "Common/Cpp/Color.h"
 //#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
@@ -19,22 +20,56 @@ namespace PokemonAutomation{
 
 class FrozenImageDetector : public VisualInferenceCallback{
 public:
-    FrozenImageDetector(std::chrono::milliseconds timeout, double rmsd_threshold);
+    enum class Mode{
+        //  Keep the last changed frame and compare at full resolution.
+        FULL_FRAME,
+
+        //  Keep only a small grid of block averages of each frame and compare
+        //  those instead. No frame copies and no allocations after construction.
+        //  Since each block averages out compression noise, the RMSD is lower
+        //  than the full-frame RMSD for the same pair of frames. So thresholds
+        //  tuned for FULL_FRAME can't be reused as is.
+        SIGNATURE,
+    };
+
+public:
+    FrozenImageDetector(
+        std::chrono::milliseconds timeout, double rmsd_threshold,
+        Mode mode = Mode::FULL_FRAME
+    );
     FrozenImageDetector(
         Color color, const ImageFloatBox& box,
-        std::chrono::milliseconds timeout, double rmsd_threshold
+        std::chrono::milliseconds timeout, double rmsd_threshold,
+        Mode mode = Mode::FULL_FRAME
     );
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool process_frame(const VideoSnapshot& frame) override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
+private:
+    bool process_signature(const ImageViewRGB32& frame, WallClock timestamp);
+
 private:
     Color m_color;
     ImageFloatBox m_box;
     std::chrono::milliseconds m_timeout;
     double m_rmsd_threshold;
+    Mode m_mode;
+
+    //  FULL_FRAME
     VideoSnapshot m_previous;
+
+    //  SIGNATURE
+    //  Ring of 2 signatures. One holds the last changed frame. The other is
+    //  scratch space for the current frame. They swap when the screen changes.
+    std::vector<uint32_t> m_signatures;
+    size_t m_signature_width;
+    size_t m_signature_height;
+    size_t m_previous_index;
+    size_t m_previous_frame_width;
+    size_t m_previous_frame_height;
+    WallClock m_previous_timestamp;
 };
 
 
@@ -7,12 +7,14 @@
 #ifndef PokemonAutomation_CommonFramework_VisualDetector_H
 #define PokemonAutomation_CommonFramework_VisualDetector_H
 
+#include <vector>
 #include "CommonFramework/InferenceInfra/VisualInferenceCallback.h"
 
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 class VideoOverlaySet;
+struct ImageFloatBox;
 
 
 class StaticScreenDetector{
@@ -20,6 +22,10 @@ public:
     virtual ~StaticScreenDetector() = default;
     virtual void make_overlays(VideoOverlaySet& items) const = 0;
     virtual bool detect(const ImageViewRGB32& screen) const = 0;
+
+    //  Optional: The parts of the screen that detect() looks at.
+    //  See VisualInferenceCallback::regions_of_interest().
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const{ return false; }
 };
 
 
@@ -67,16 +73,35 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override{
         Detector::make_overlays(items);
     }
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const override{
+        return Detector::regions_of_interest(boxes);
+    }
 
     //  If m_finder_type is PRESENT, return true only when it is consecutively detected.
     //  If m_finder_type is GONE, return true only when it is consecutively not detected.
     //  if m_finder_type is CONSISTENT, return true when it is consecutively detected, or consecutively not detected.
     using VisualInferenceCallback::process_frame;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override{
+        m_last_result = this->detect(frame);
+        return process_result(m_last_result, timestamp);
+    }
+
+    //  Nothing the detector looks at has changed. So it would return the same
+    //  result as last time. Keep the clock running with that.
+    virtual bool process_unchanged_frame(WallClock timestamp) override{
+        return process_result(m_last_result, timestamp);
+    }
+
+    //  If m_finder_type is CONSISTENT and process_frame() returns true,
+    //  whether it is consecutively detected , or consecutively not detected.
+    bool consistent_result() const { return m_consistent_result; }
+
+private:
+    bool process_result(bool detected, WallClock timestamp){
         switch (m_finder_type){
         case FinderType::PRESENT:
         case FinderType::GONE:
-            if (this->detect(frame) == (m_finder_type == FinderType::GONE)){
+            if (detected == (m_finder_type == FinderType::GONE)){
                 m_start_of_detection = WallClock::min();
                 return false;
             }
@@ -85,7 +110,7 @@ public:
             }
             return timestamp - m_start_of_detection >= m_duration;
         case FinderType::CONSISTENT:{
-            const bool result = this->detect(frame);
+            const bool result = detected;
             const bool result_changed = (result && m_last_detected < 0) || (!result && m_last_detected > 0);
 
             m_last_detected = (result ? 1 : -1);
@@ -109,16 +134,13 @@ public:
         return false;
     }
 
-    //  If m_finder_type is CONSISTENT and process_frame() returns true,
-    //  whether it is consecutively detected , or consecutively not detected.
-    bool consistent_result() const { return m_consistent_result; }
-
 private:
     std::chrono::milliseconds m_duration;
     FinderType m_finder_type;
     WallClock m_start_of_detection = WallClock::min();
     int8_t m_last_detected = 0; // 0: no prior detection, 1: last detected positive, -1: last detected negative
     bool m_consistent_result = false;
+    bool m_last_result = false;
 };
 
 
@@ -40,8 +40,12 @@ struct AudioInferencePivot::PeriodicCallback{
 };
 
 
-AudioInferencePivot::AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher)
+AudioInferencePivot::AudioInferencePivot(
+    CancellableScope& scope, AudioFeed& feed,
+    AsyncDispatcher& dispatcher, InferenceExecutor::Client& executor
+)
     : PeriodicRunner(dispatcher)
+    , m_executor(executor)
     , m_feed(feed)
 {
     attach(scope);
@@ -87,6 +91,13 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
+        InferenceExecutor::Lease lease(
+            m_executor,
+            callback.callback.time_critical()
+                ? InferenceExecutor::Priority::TIME_CRITICAL
+                : InferenceExecutor::Priority::NORMAL
+        );
+
         std::vector<AudioSpectrum> spectrums;
 
         if (callback.last_seqnum == ~(uint64_t)0){
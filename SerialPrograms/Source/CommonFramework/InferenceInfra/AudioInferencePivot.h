@@ -11,6 +11,7 @@
 #include "Common/Cpp/Concurrency/PeriodicScheduler.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
 #include "CommonFramework/Inference/StatAccumulator.h"
+#include "InferenceExecutor.h"
 #include "AudioInferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -21,7 +22,10 @@ class AudioFeed;
 
 class AudioInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher);
+    AudioInferencePivot(
+        CancellableScope& scope, AudioFeed& feed,
+        AsyncDispatcher& dispatcher, InferenceExecutor::Client& executor
+    );
     virtual ~AudioInferencePivot();
 
     //  If this callback returns true:
@@ -45,6 +49,7 @@ private:
 private:
     struct PeriodicCallback;
 
+    InferenceExecutor::Client& m_executor;
     AudioFeed& m_feed;
     SpinLock m_lock;
     std::map<AudioInferenceCallback*, PeriodicCallback> m_map;
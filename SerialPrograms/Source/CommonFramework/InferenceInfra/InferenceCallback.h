@@ -31,6 +31,9 @@ public:
     InferenceType type() const{ return m_type; }
     // Name of the inference object.
     const std::string& label() const{ return m_label; }
+    // Whether it runs ahead of other callbacks when the inference workers
+    // are all busy. See InferenceExecutor.h.
+    bool time_critical() const{ return m_time_critical; }
 
 
 protected:
@@ -39,10 +42,15 @@ protected:
         , m_label(label)
     {}
 
+    // Set this for callbacks that react to something as it happens and would
+    // be wrong if they run late.
+    void set_time_critical(bool enabled = true){ m_time_critical = enabled; }
+
 
 private:
     InferenceType m_type;
     std::string m_label;
+    bool m_time_critical = false;
 };
 
 
@@ -0,0 +1,156 @@
+/*  Inference Executor
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <thread>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "InferenceExecutor.h"
+
+namespace PokemonAutomation{
+
+
+struct InferenceExecutor::Waiter{
+    bool granted = false;
+    std::condition_variable cv;
+};
+
+
+
+InferenceExecutor& InferenceExecutor::instance(){
+    static InferenceExecutor executor([]{
+        size_t workers = GlobalSettings::instance().INFERENCE_WORKERS;
+        if (workers == 0){
+            workers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+        return workers;
+    }());
+    return executor;
+}
+
+InferenceExecutor::InferenceExecutor(size_t workers)
+    : m_workers(workers)
+    , m_free(workers)
+    , m_min_share_time(WallClock::duration(0))
+{
+    if (workers == 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "InferenceExecutor needs at least 1 worker.");
+    }
+}
+
+
+size_t InferenceExecutor::waiting() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    size_t ret = m_critical.size();
+    for (const Client* client : m_clients){
+        ret += client->m_waiting.size();
+    }
+    return ret;
+}
+
+
+void InferenceExecutor::acquire(Client& client, Priority priority){
+    std::unique_lock<std::mutex> lg(m_lock);
+
+    //  A free worker means nobody is waiting.
+    if (m_free > 0){
+        m_free--;
+        return;
+    }
+
+    Waiter waiter;
+    switch (priority){
+    case Priority::NORMAL:
+        if (client.m_waiting.empty() && client.m_share_time < m_min_share_time){
+            client.m_share_time = m_min_share_time;
+        }
+        client.m_waiting.emplace_back(&waiter);
+        break;
+    case Priority::TIME_CRITICAL:
+        m_critical.emplace_back(&waiter);
+        break;
+    }
+    waiter.cv.wait(lg, [&]{ return waiter.granted; });
+}
+void InferenceExecutor::release(Client& client, WallClock::duration elapsed){
+    std::lock_guard<std::mutex> lg(m_lock);
+    client.m_share_time += elapsed;
+    client.m_busy_time += elapsed;
+
+    //  Hand the worker straight to the next waiter.
+    Waiter* next = pop_next_waiter();
+    if (next == nullptr){
+        m_free++;
+        return;
+    }
+    next->granted = true;
+    next->cv.notify_one();
+}
+InferenceExecutor::Waiter* InferenceExecutor::pop_next_waiter(){
+    if (!m_critical.empty()){
+        Waiter* ret = m_critical.front();
+        m_critical.pop_front();
+        return ret;
+    }
+
+    Client* best = nullptr;
+    for (Client* client : m_clients){
+        if (client->m_waiting.empty()){
+            continue;
+        }
+        if (best == nullptr || client->m_share_time < best->m_share_time){
+            best = client;
+        }
+    }
+    if (best == nullptr){
+        return nullptr;
+    }
+    m_min_share_time = std::max(m_min_share_time, best->m_share_time);
+    Waiter* ret = best->m_waiting.front();
+    best->m_waiting.pop_front();
+    return ret;
+}
+
+
+
+InferenceExecutor::Client::Client(InferenceExecutor& executor)
+    : m_executor(executor)
+    , m_share_time(WallClock::duration(0))
+    , m_busy_time(WallClock::duration(0))
+{
+    std::lock_guard<std::mutex> lg(executor.m_lock);
+    m_share_time = executor.m_min_share_time;
+    executor.m_clients.insert(this);
+}
+InferenceExecutor::Client::~Client(){
+    std::lock_guard<std::mutex> lg(m_executor.m_lock);
+    m_executor.m_clients.erase(this);
+}
+WallClock::duration InferenceExecutor::Client::busy_time() const{
+    std::lock_guard<std::mutex> lg(m_executor.m_lock);
+    return m_busy_time;
+}
+WallClock::duration InferenceExecutor::Client::share_time() const{
+    std::lock_guard<std::mutex> lg(m_executor.m_lock);
+    return m_share_time;
+}
+
+
+
+InferenceExecutor::Lease::Lease(Client& client, Priority priority)
+    : m_client(client)
+{
+    client.m_executor.acquire(client, priority);
+    m_start = current_time();
+}
+InferenceExecutor::Lease::~Lease(){
+    m_client.m_executor.release(m_client, current_time() - m_start);
+}
+
+
+
+
+}
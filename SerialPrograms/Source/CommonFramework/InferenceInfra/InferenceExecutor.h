@@ -0,0 +1,130 @@
+/*  Inference Executor
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Limit how many inference callbacks run at the same time across all
+ *  consoles.
+ *
+ *  Every console has its own inference pivot threads. With several consoles,
+ *  they would all run their callbacks at once and oversubscribe the CPU.
+ *  Instead, a pivot must hold a lease from this executor while it runs a
+ *  callback. There are only as many leases as there are workers.
+ *
+ *  When more callbacks are ready than there are workers:
+ *      1.  Time-critical callbacks go first in the order they asked.
+ *      2.  Otherwise, the console that has used the least worker time goes
+ *          first. So a console with expensive callbacks can't starve the
+ *          others.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_InferenceExecutor_H
+#define PokemonAutomation_CommonFramework_InferenceExecutor_H
+
+#include <string>
+#include <deque>
+#include <set>
+#include <mutex>
+#include <condition_variable>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+
+class InferenceExecutor{
+public:
+    enum class Priority{
+        NORMAL,
+        TIME_CRITICAL,
+    };
+
+    class Client;
+    class Lease;
+
+public:
+    //  The worker count is read from the settings on first use.
+    static InferenceExecutor& instance();
+
+    InferenceExecutor(size_t workers);
+
+    size_t workers() const{ return m_workers; }
+
+    //  Number of leases waiting for a worker.
+    size_t waiting() const;
+
+
+private:
+    struct Waiter;
+
+    void acquire(Client& client, Priority priority);
+    void release(Client& client, WallClock::duration elapsed);
+
+    //  Must be called with the lock held. Returns null if nobody is waiting.
+    Waiter* pop_next_waiter();
+
+private:
+    const size_t m_workers;
+
+    mutable std::mutex m_lock;
+    size_t m_free;
+    std::set<Client*> m_clients;
+    std::deque<Waiter*> m_critical;
+
+    //  Share time of the last client to be picked. A client that has been
+    //  idle is brought up to this so it can't monopolize the workers while it
+    //  catches up with the others.
+    WallClock::duration m_min_share_time;
+};
+
+
+
+//  One per console. Shared by all of that console's pivots.
+class InferenceExecutor::Client{
+    Client(const Client&) = delete;
+    void operator=(const Client&) = delete;
+
+public:
+    Client(InferenceExecutor& executor);
+    ~Client();
+
+    //  Total worker time used by this client.
+    WallClock::duration busy_time() const;
+
+    //  Worker time used for fair-share ordering.
+    WallClock::duration share_time() const;
+
+private:
+    friend class InferenceExecutor;
+    friend class Lease;
+
+    InferenceExecutor& m_executor;
+
+    //  Protected by the executor's lock.
+    std::deque<Waiter*> m_waiting;
+    //  Worker time used for fair-share ordering. Raised to the executor's
+    //  minimum whenever the client has been idle.
+    WallClock::duration m_share_time;
+    WallClock::duration m_busy_time;
+};
+
+
+
+//  Hold one worker for the lifetime of this object.
+class InferenceExecutor::Lease{
+    Lease(const Lease&) = delete;
+    void operator=(const Lease&) = delete;
+
+public:
+    Lease(Client& client, Priority priority);
+    ~Lease();
+
+private:
+    Client& m_client;
+    WallClock m_start;
+};
+
+
+
+
+}
+#endif
@@ -0,0 +1,138 @@
+/*  Visual Change Tracker
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
+#include "VisualChangeTracker.h"
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+void copy_block(
+    uint32_t* dest, size_t dest_bytes_per_row,
+    const uint32_t* src, size_t src_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        memcpy(dest, src, width * sizeof(uint32_t));
+        dest = (uint32_t*)((char*)dest + dest_bytes_per_row);
+        src = (const uint32_t*)((const char*)src + src_bytes_per_row);
+    }
+}
+
+}
+
+
+
+VisualChangeTracker::VisualChangeTracker(double msd_threshold)
+    : m_msd_threshold(msd_threshold)
+{}
+
+void VisualChangeTracker::reset(const ImageViewRGB32& frame, uint64_t seqnum){
+    m_reference = frame.copy();
+    m_blocks_x = (frame.width() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    m_blocks_y = (frame.height() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    m_last_change.assign(m_blocks_x * m_blocks_y, seqnum);
+    m_blocks_changed = m_blocks_x * m_blocks_y;
+}
+
+void VisualChangeTracker::push_frame(const ImageViewRGB32& frame, uint64_t seqnum){
+    m_seqnum = seqnum;
+
+    if (!frame){
+        m_reference = ImageRGB32();
+        m_blocks_x = 0;
+        m_blocks_y = 0;
+        m_last_change.clear();
+        m_blocks_changed = 0;
+        return;
+    }
+
+    if (frame.width() != m_reference.width() || frame.height() != m_reference.height()){
+        reset(frame, seqnum);
+        return;
+    }
+
+    const size_t width = frame.width();
+    const size_t height = frame.height();
+    const size_t frame_bytes_per_row = frame.bytes_per_row();
+    const size_t ref_bytes_per_row = m_reference.bytes_per_row();
+
+    size_t changed = 0;
+    for (size_t by = 0; by < m_blocks_y; by++){
+        const size_t min_y = by * BLOCK_SIZE;
+        const size_t block_height = std::min(BLOCK_SIZE, height - min_y);
+        const uint32_t* frame_row = (const uint32_t*)((const char*)frame.data() + min_y * frame_bytes_per_row);
+        uint32_t* ref_row = (uint32_t*)((char*)m_reference.data() + min_y * ref_bytes_per_row);
+        for (size_t bx = 0; bx < m_blocks_x; bx++){
+            const size_t min_x = bx * BLOCK_SIZE;
+            const size_t block_width = std::min(BLOCK_SIZE, width - min_x);
+
+            uint64_t count = 0;
+            uint64_t sumsqrs = 0;
+            Kernels::sum_sqr_deviation(
+                count, sumsqrs,
+                block_width, block_height,
+                ref_row + min_x, ref_bytes_per_row,
+                frame_row + min_x, frame_bytes_per_row
+            );
+
+            //  Transparent pixels are skipped by the kernel. Frames should
+            //  never have any, but if they do, always treat them as changed.
+            const size_t area = block_width * block_height;
+            if (count == area && (double)sumsqrs <= m_msd_threshold * (double)area){
+                continue;
+            }
+
+            copy_block(
+                ref_row + min_x, ref_bytes_per_row,
+                frame_row + min_x, frame_bytes_per_row,
+                block_width, block_height
+            );
+            m_last_change[by * m_blocks_x + bx] = seqnum;
+            changed++;
+        }
+    }
+    m_blocks_changed = changed;
+}
+
+uint64_t VisualChangeTracker::last_change(const ImageFloatBox& box) const{
+    if (m_blocks_x == 0 || m_blocks_y == 0){
+        return m_seqnum;
+    }
+
+    //  Round outwards so that any block the box touches is included.
+    const size_t width = m_reference.width();
+    const size_t height = m_reference.height();
+    double x0 = std::max(box.x * width - 1, 0.);
+    double y0 = std::max(box.y * height - 1, 0.);
+    double x1 = std::min((box.x + box.width) * width + 1, (double)width);
+    double y1 = std::min((box.y + box.height) * height + 1, (double)height);
+    if (x1 <= x0 || y1 <= y0){
+        return 0;
+    }
+    size_t min_bx = (size_t)x0 / BLOCK_SIZE;
+    size_t min_by = (size_t)y0 / BLOCK_SIZE;
+    size_t max_bx = std::min(((size_t)x1 + BLOCK_SIZE - 1) / BLOCK_SIZE, m_blocks_x);
+    size_t max_by = std::min(((size_t)y1 + BLOCK_SIZE - 1) / BLOCK_SIZE, m_blocks_y);
+
+    uint64_t last = 0;
+    for (size_t by = min_by; by < max_by; by++){
+        const uint64_t* row = m_last_change.data() + by * m_blocks_x;
+        for (size_t bx = min_bx; bx < max_bx; bx++){
+            last = std::max(last, row[bx]);
+        }
+    }
+    return last;
+}
+
+
+
+}
@@ -0,0 +1,74 @@
+/*  Visual Change Tracker
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Track which parts of the screen have changed between video snapshots.
+ *
+ *  The screen is split into BLOCK_SIZE x BLOCK_SIZE blocks. Each new frame is
+ *  compared block-by-block against a reference copy of the screen. Blocks
+ *  whose mean squared deviation exceeds the threshold are marked as changed
+ *  (with the seqnum of the frame) and are copied into the reference.
+ *
+ *  Since unchanged blocks are never copied into the reference, a slow drift
+ *  accumulates against the reference and will eventually register as a
+ *  change. It isn't lost between consecutive frames.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_VisualChangeTracker_H
+#define PokemonAutomation_CommonFramework_VisualChangeTracker_H
+
+#include <stdint.h>
+#include <vector>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+
+class VisualChangeTracker{
+public:
+    static constexpr size_t BLOCK_SIZE = 32;
+
+public:
+    //  "msd_threshold" is the mean squared deviation per pixel (summed over
+    //  the 3 color channels) above which a block is considered changed.
+    VisualChangeTracker(double msd_threshold = 48);
+
+    //  Compare "frame" against the reference and record changed blocks.
+    //  "seqnum" must be non-zero and increase with every call.
+    //  If the resolution changes, everything is marked as changed.
+    void push_frame(const ImageViewRGB32& frame, uint64_t seqnum);
+
+    uint64_t seqnum() const{ return m_seqnum; }
+
+    //  # of blocks that changed in the last push_frame() call.
+    size_t blocks_changed() const{ return m_blocks_changed; }
+    size_t blocks_total() const{ return m_blocks_x * m_blocks_y; }
+
+    //  Return the seqnum of the last frame where anything inside "box"
+    //  changed. Returns zero if no frame has been pushed yet.
+    uint64_t last_change(const ImageFloatBox& box) const;
+
+
+private:
+    void reset(const ImageViewRGB32& frame, uint64_t seqnum);
+
+private:
+    const double m_msd_threshold;
+
+    ImageRGB32 m_reference;
+    size_t m_blocks_x = 0;
+    size_t m_blocks_y = 0;
+
+    //  Seqnum of the last change for each block. Row-major.
+    std::vector<uint64_t> m_last_change;
+
+    uint64_t m_seqnum = 0;
+    size_t m_blocks_changed = 0;
+};
+
+
+
+}
+#endif
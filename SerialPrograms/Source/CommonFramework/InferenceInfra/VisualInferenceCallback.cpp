@@ -18,6 +18,12 @@ bool VisualInferenceCallback::process_frame(const VideoSnapshot& frame){
 bool VisualInferenceCallback::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
     throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "You must override one of the two process_frame() functions.");
 }
+bool VisualInferenceCallback::regions_of_interest(std::vector<ImageFloatBox>& boxes) const{
+    return false;
+}
+bool VisualInferenceCallback::process_unchanged_frame(WallClock timestamp){
+    return false;
+}
 
 
 
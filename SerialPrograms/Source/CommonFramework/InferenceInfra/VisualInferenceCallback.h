@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
 #include "InferenceCallback.h"
@@ -19,6 +20,7 @@ class ImageViewRGB32;
 class ImageRGB32;
 struct VideoSnapshot;
 class VideoOverlaySet;
+struct ImageFloatBox;
 
 //  Base class for a visual inference object to be called perioridically by
 //  inference routines in InferenceRoutines.h.
@@ -39,6 +41,31 @@ public:
     //  You must override at least one of the overloaded `process_frame()`.
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp);
 
+
+public:
+    //  Change-Based Skipping
+    //
+    //  If a callback only looks at fixed parts of the screen, it can declare
+    //  them here. When none of them have changed since the last frame this
+    //  callback processed, the inference pivot will call
+    //  process_unchanged_frame() instead of process_frame().
+    //
+    //  Only opt in if the result of process_frame() depends on nothing but
+    //  the pixels inside these boxes.
+
+    //  Return false (the default) to be called on every frame.
+    //  Otherwise, append the boxes (in screen-relative coordinates) and
+    //  return true. This is called once when the callback is added.
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const;
+
+    //  Called instead of process_frame() when the regions of interest have
+    //  not changed. Return true if the inference session should stop.
+    //
+    //  The default returns false. That is the same result that the last
+    //  process_frame() call gave. (otherwise the session would have stopped)
+    //  Override this if the callback needs to see the passage of time.
+    virtual bool process_unchanged_frame(WallClock timestamp);
+
 };
 
 
@@ -5,6 +5,9 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -24,6 +27,13 @@ struct VisualInferencePivot::PeriodicCallback{
     StatAccumulatorI32 stats;
     uint64_t last_seqnum;
 
+    //  Empty if the callback wants every frame.
+    std::vector<ImageFloatBox> regions;
+
+    //  Seqnum of the last frame that was passed to process_frame(), if that
+    //  frame was also pushed into the change tracker. Zero otherwise.
+    uint64_t processed_seqnum;
+
     PeriodicCallback(
         Cancellable& p_scope,
         std::atomic<InferenceCallback*>* p_set_when_triggered,
@@ -35,14 +45,25 @@ struct VisualInferencePivot::PeriodicCallback{
         , callback(p_callback)
         , period(p_period)
         , last_seqnum(0)
-    {}
+        , processed_seqnum(0)
+    {
+        if (!callback.regions_of_interest(regions)){
+            regions.clear();
+        }
+    }
 };
 
 
 
-VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
+VisualInferencePivot::VisualInferencePivot(
+    CancellableScope& scope, VideoFeed& feed,
+    AsyncDispatcher& dispatcher, InferenceExecutor::Client& executor
+)
     : PeriodicRunner(dispatcher)
+    , m_executor(executor)
     , m_feed(feed)
+    , m_processed(0)
+    , m_skipped(0)
 {
     attach(scope);
 }
@@ -87,6 +108,13 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
+        InferenceExecutor::Lease lease(
+            m_executor,
+            callback.callback.time_critical()
+                ? InferenceExecutor::Priority::TIME_CRITICAL
+                : InferenceExecutor::Priority::NORMAL
+        );
+
         //  Reuse the cached screenshot.
         if (!is_back_to_back || callback.last_seqnum == m_seqnum){
 //            cout << "back-to-back" << endl;
@@ -94,10 +122,18 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             m_seqnum++;
         }
 
-        WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
-        WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        bool stop;
+        if (is_unchanged(callback)){
+            stop = callback.callback.process_unchanged_frame(m_last.timestamp);
+            m_skipped.fetch_add(1, std::memory_order_relaxed);
+        }else{
+            WallClock time0 = current_time();
+            stop = callback.callback.process_frame(m_last);
+            WallClock time1 = current_time();
+            callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+            callback.processed_seqnum = m_changes.seqnum() == m_seqnum ? m_seqnum : 0;
+            m_processed.fetch_add(1, std::memory_order_relaxed);
+        }
         callback.last_seqnum = m_seqnum;
         if (stop){
             if (callback.set_when_triggered){
@@ -112,8 +148,49 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
 }
 
 
+bool VisualInferencePivot::is_unchanged(const PeriodicCallback& callback){
+    if (callback.regions.empty() || !m_last.frame){
+        return false;
+    }
+    if (!GlobalSettings::instance().SKIP_UNCHANGED_INFERENCE){
+        return false;
+    }
+
+    //  Push before deciding anything, including on the callback's first frame.
+    //  The frame the callback processes here becomes its "processed_seqnum"
+    //  and must be in the tracker. Otherwise the tracker compares against an
+    //  older frame than the one the callback saw, and a screen that changed
+    //  and then changed back would look unchanged to the callback.
+    if (m_changes.seqnum() != m_seqnum){
+        m_changes.push_frame(*m_last.frame, m_seqnum);
+    }
+    if (callback.processed_seqnum == 0){
+        return false;
+    }
+    for (const ImageFloatBox& box : callback.regions){
+        if (m_changes.last_change(box) > callback.processed_seqnum){
+            return false;
+        }
+    }
+    return true;
+}
+
+
 OverlayStatSnapshot VisualInferencePivot::get_current(){
-    return m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
+    OverlayStatSnapshot ret = m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
+
+    uint64_t processed = m_processed.load(std::memory_order_relaxed);
+    uint64_t skipped = m_skipped.load(std::memory_order_relaxed);
+    uint64_t new_processed = processed - m_last_processed;
+    uint64_t new_skipped = skipped - m_last_skipped;
+    m_last_processed = processed;
+    m_last_skipped = skipped;
+
+    if (!ret.text.empty() && new_skipped != 0){
+        double ratio = (double)new_skipped / (new_processed + new_skipped);
+        ret.text += " (Skipped: " + tostr_fixed(ratio * 100, 0) + " %)";
+    }
+    return ret;
 }
 
 
@@ -12,7 +12,9 @@
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
 #include "CommonFramework/Inference/StatAccumulator.h"
+#include "InferenceExecutor.h"
 #include "VisualInferenceCallback.h"
+#include "VisualChangeTracker.h"
 
 namespace PokemonAutomation{
 
@@ -22,7 +24,10 @@ class VideoFeed;
 
 class VisualInferencePivot final : public PeriodicRunner, public OverlayStat{
 public:
-    VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher);
+    VisualInferencePivot(
+        CancellableScope& scope, VideoFeed& feed,
+        AsyncDispatcher& dispatcher, InferenceExecutor::Client& executor
+    );
     virtual ~VisualInferencePivot();
 
     //  If this callback returns true:
@@ -46,12 +51,28 @@ private:
 private:
     struct PeriodicCallback;
 
+    //  Returns true if none of the callback's regions of interest have
+    //  changed since the last frame it processed.
+    //  Also pushes the current frame into "m_changes" for callbacks that have
+    //  regions of interest, even when it returns false.
+    bool is_unchanged(const PeriodicCallback& callback);
+
+    InferenceExecutor::Client& m_executor;
     VideoFeed& m_feed;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
     uint64_t m_seqnum = 0;
 
+    //  Only updated for frames that a callback with regions of interest
+    //  wants to check.
+    VisualChangeTracker m_changes;
+
+    std::atomic<uint64_t> m_processed;
+    std::atomic<uint64_t> m_skipped;
+    uint64_t m_last_processed = 0;
+    uint64_t m_last_skipped = 0;
+
     OverlayStatUtilizationPrinter m_printer;
 };
 
@@ -12,6 +12,8 @@
 #include "Tests/CommandLineTests.h"
 #include "CrashDump.h"
 #include "Environment/HardwareValidation.h"
+#include "Environment/KernelAutotuner.h"
+#include "Resources/BinaryResourceCache.h"
 #include "Logging/Logger.h"
 #include "Logging/OutputRedirector.h"
 //#include "Tools/StatsDatabase.h"
@@ -86,11 +88,27 @@ int main(int argc, char *argv[]){
         return run_command_line_tests();
     }
 
+    //  Prebuild the binary resource cache and exit. (for build/install scripts)
+    if (application.arguments().contains("--build-resource-cache")){
+        build_all_resource_caches(global_logger_tagged());
+        return 0;
+    }
+
     //  Check whether the hardware is powerful enough to run this program.
     if (!check_hardware()){
         return 1;
     }
 
+    //  Save global settings in the background as soon as they change. Past
+    //  the early returns above since those exit without shutdown().
+    PERSISTENT_SETTINGS().track_section(
+        "20-GlobalSettings", GlobalSettings::instance(),
+        []{ return GlobalSettings::instance().to_json(); }
+    );
+
+    //  Pick the fastest kernel variants for this machine.
+    load_or_tune_kernel_profile(global_logger_tagged(), GlobalSettings::instance().KERNEL_PROFILE);
+
     check_new_version(global_logger_tagged());
 
     Integration::DiscordIntegrationSettingsOption& discord_settings = GlobalSettings::instance().DISCORD.integration;
@@ -121,6 +139,7 @@ int main(int argc, char *argv[]){
 
     // Write program settings back to the json file.
     PERSISTENT_SETTINGS().write();
+    PERSISTENT_SETTINGS().shutdown();
 
 #ifdef PA_SLEEPY
     Integration::SleepyDiscordRunner::sleepy_terminate();
@@ -6,7 +6,10 @@
 
 #include <QDir>
 #include <QFile>
+#include <QBuffer>
+#include <QImage>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Concurrency/FireForgetDispatcher.h"
 #include "CommonFramework/Globals.h"
 #include "MessageAttachment.h"
 
@@ -27,10 +30,11 @@ ImageAttachment::ImageAttachment(
 
 
 PendingFileSend::~PendingFileSend(){
+    std::lock_guard<std::mutex> lg(m_lock);
     if (m_filepath.empty()){
         return;
     }
-    if (m_keep_file){
+    if (m_keep_file && !m_temp_file){
         return;
     }
 
@@ -59,7 +63,10 @@ PendingFileSend::PendingFileSend(Logger& logger, const std::string& text_attachm
     QFile file(QString::fromStdString(m_filepath));
 }
 #endif
-PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
+PendingFileSend::PendingFileSend(
+    Logger& logger, const ImageAttachment& image,
+    int jpg_quality, size_t max_height
+)
     : m_keep_file(image.keep_file)
     , m_extend_lifetime(false)
 {
@@ -71,35 +78,116 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
         return;
     }
 
-    std::string format;
+    const char* format = nullptr;
+    int quality = -1;
     switch (image.mode){
     case ImageAttachmentMode::NO_SCREENSHOT:
-        break;
+        return;
     case ImageAttachmentMode::JPG:
-        format = ".jpg";
+        format = "JPG";
+        quality = jpg_quality;
+        m_filename = now_to_filestring() + ".jpg";
         break;
     case ImageAttachmentMode::PNG:
-        format = ".png";
+        format = "PNG";
+        m_filename = now_to_filestring() + ".png";
         break;
     }
 
-    m_filename = now_to_filestring() + format;
+    //  The view may not outlive this call. Copying is much cheaper than
+    //  encoding so that's the only thing done on the caller's thread.
+    std::shared_ptr<ImageRGB32> pixels = std::make_shared<ImageRGB32>(image.image.copy());
+    std::shared_ptr<std::promise<EncodedImage>> promise = std::make_shared<std::promise<EncodedImage>>();
+    m_encoded = promise->get_future().share();
+
+    std::string save_path = image.keep_file ? SCREENSHOTS_PATH() + m_filename : "";
+    global_dispatcher.dispatch([pixels, promise, format, quality, max_height, filename = m_filename, save_path]{
+        auto encode = [&](const QImage& qimage, int encode_quality){
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+            if (!qimage.save(&buffer, format, encode_quality)){
+                global_logger_tagged().log("Unable to encode screenshot: " + filename, COLOR_RED);
+                data.clear();
+            }
+            buffer.close();
+            return data;
+        };
+
+        //  The saved copy is always full size at the default quality. The
+        //  notification settings only apply to what is sent.
+        const bool scale = max_height != 0 && pixels->height() > max_height;
+        const bool same_bytes = !scale && quality < 0;
+
+        EncodedImage encoded;
+        if (!save_path.empty()){
+            QByteArray full = encode(pixels->to_QImage_ref(), -1);
+            QFile file(QString::fromStdString(save_path));
+            if (!full.isEmpty() && file.open(QIODevice::WriteOnly) && file.write(full) == full.size()){
+                if (same_bytes){
+                    encoded.saved_path = save_path;
+                }
+                global_logger_tagged().log("Saved image to: " + save_path, COLOR_BLUE);
+            }else{
+                global_logger_tagged().log("Unable to save screenshot to: " + save_path, COLOR_RED);
+            }
+            if (same_bytes){
+                encoded.data = std::move(full);
+            }
+        }
+        if (scale){
+            size_t width = std::max<size_t>(pixels->width() * max_height / pixels->height(), 1);
+            encoded.data = encode(pixels->scaled_to_QImage(width, max_height), quality);
+        }else if (save_path.empty() || !same_bytes){
+            encoded.data = encode(pixels->to_QImage_ref(), quality);
+        }
+
+        promise->set_value(std::move(encoded));
+    });
+}
+PendingFileSend::EncodedImage PendingFileSend::encoded() const{
+    if (!m_encoded.valid()){
+        return EncodedImage();
+    }
+    try{
+        return m_encoded.get();
+    }catch (std::future_error&){
+        //  The encoder was shut down before it got to this one.
+        return EncodedImage();
+    }
+}
+bool PendingFileSend::ready() const{
+    return !m_encoded.valid() || m_encoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+QByteArray PendingFileSend::data() const{
+    return encoded().data;
+}
+const std::string& PendingFileSend::filepath() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!m_filepath.empty() || !m_encoded.valid()){
+        return m_filepath;
+    }
 
-    if (image.keep_file){
-        m_filepath = SCREENSHOTS_PATH() + m_filename;
-    }else{
-        QDir().mkdir("TempFiles");
-//        m_filename = "temp-" + m_filename;
-        m_filepath = "TempFiles/" + m_filename;
+    EncodedImage image = encoded();
+    if (!image.saved_path.empty()){
+        m_filepath = std::move(image.saved_path);
+        return m_filepath;
+    }
+    if (image.data.isEmpty()){
+        return m_filepath;
     }
 
-    if (image.image.save(m_filepath)){
-        logger.log("Saved image to: " + m_filepath, COLOR_BLUE);
-    }else{
-        logger.log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
-        m_filename.clear();
-        m_filepath.clear();
+    //  Someone needs an actual file. Spill it.
+    QDir().mkdir("TempFiles");
+    std::string path = "TempFiles/" + m_filename;
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly) || file.write(image.data) != image.data.size()){
+        global_logger_tagged().log("Unable to write attachment to: " + path, COLOR_RED);
+        return m_filepath;
     }
+    m_filepath = std::move(path);
+    m_temp_file = true;
+    return m_filepath;
 }
 void PendingFileSend::extend_lifetime(){
     m_extend_lifetime.store(true, std::memory_order_release);
@@ -9,6 +9,9 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <future>
+#include <QByteArray>
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Options/ScreenshotFormatOption.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
@@ -33,27 +36,64 @@ struct ImageAttachment{
 
 //  Represents a file that's in the process of being sent.
 //  If (keep_file = false), the file is automatically deleted after being sent.
+//
+//  Screenshots are encoded once on a background thread. The bytes stay in
+//  memory and are shared by every integration that sends them. They are only
+//  written to disk if (keep_file = true) or if something asks for filepath().
 class PendingFileSend{
 public:
     ~PendingFileSend();
 
     PendingFileSend(const std::string& file, bool keep_file);
 //    PendingFileSend(Logger& logger, const std::string& text_attachment);
-    PendingFileSend(Logger& logger, const ImageAttachment& image);
 
+    //  "jpg_quality" is 1-100 or -1 for the default. Images taller than
+    //  "max_height" are scaled down before sending. Zero means no limit.
+    //  If (keep_file = true), the saved copy is always full size at the
+    //  default quality.
+    PendingFileSend(
+        Logger& logger, const ImageAttachment& image,
+        int jpg_quality = -1, size_t max_height = 0
+    );
+
+    //  Empty if there is nothing to send.
     const std::string& filename() const{ return m_filename; }
-    const std::string& filepath() const{ return m_filepath; }
+
+    //  Path of the file on disk. For in-memory attachments, this waits for the
+    //  encode and writes a temporary file the first time it's called.
+    //  Empty if there is no file.
+    const std::string& filepath() const;
+
+    //  The encoded bytes. Waits for the encode if it's still running.
+    //  Empty if the encode failed or if the attachment is a file that was
+    //  never loaded into memory.
+    QByteArray data() const;
+
+    //  True if data() and filepath() won't block.
+    bool ready() const;
+
     bool keep_file() const{ return m_keep_file; }
 
     //  Work around bug in Sleepy that destroys file before it's not needed anymore.
     void extend_lifetime();
 
+private:
+    struct EncodedImage{
+        QByteArray data;
+        std::string saved_path;     //  Set if the saved file has the same bytes as "data".
+    };
+    EncodedImage encoded() const;
+
 private:
     bool m_keep_file;
     std::atomic<bool> m_extend_lifetime;
 //    QFile m_file;
     std::string m_filename;
-    std::string m_filepath;
+
+    mutable std::mutex m_lock;
+    mutable std::string m_filepath;
+    mutable bool m_temp_file = false;
+    std::shared_future<EncodedImage> m_encoded;
 };
 
 
@@ -93,8 +93,17 @@ void send_raw_notification(
     const std::vector<std::pair<std::string, std::string>>& messages,
     const ImageAttachment& image
 ){
-    std::shared_ptr<PendingFileSend> file(new PendingFileSend(logger, image));
-    bool hasFile = !file->filepath().empty();
+    const NotificationScreenshotOption& screenshot_settings = GlobalSettings::instance().NOTIFICATION_SCREENSHOTS;
+    std::shared_ptr<PendingFileSend> file(new PendingFileSend(
+        logger, image,
+        screenshot_settings.JPG_QUALITY,
+        screenshot_settings.MAX_HEIGHT
+    ));
+
+    //  The encode is still running so we don't know yet whether it worked.
+    //  The integrations check the bytes before attaching them. (The webhook
+    //  sender also drops the embed image if the encode failed.)
+    bool hasFile = !file->filename().empty();
 
     JsonObject embed;
     JsonArray embeds;
@@ -32,7 +32,7 @@ void PanelInstance::save_settings() const{
         PERSISTENT_SETTINGS().panels[identifier] = to_json();
     }
     global_logger_tagged().log("Saving panel settings...");
-    PERSISTENT_SETTINGS().write();
+    PERSISTENT_SETTINGS().write_deferred();
 }
 
 
@@ -15,6 +15,7 @@ class QWidget;
 namespace PokemonAutomation{
 
 class JsonValue;
+class ConfigOption;
 struct PanelHolder;
 
 // Class to represent one instance of a pokemon automation program.
@@ -39,6 +40,10 @@ public:
     virtual void from_json(const JsonValue& json){}
     virtual JsonValue to_json() const;
 
+    //  The options saved by to_json(). If not null, changes to them are saved
+    //  automatically while the panel is open.
+    virtual ConfigOption* options_root(){ return nullptr; }
+
 protected:
     const PanelDescriptor& m_descriptor;
 };
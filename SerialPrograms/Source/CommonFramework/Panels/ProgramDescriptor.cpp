@@ -14,6 +14,9 @@ namespace PokemonAutomation{
 std::unique_ptr<StatsTracker> ProgramDescriptor::make_stats() const{
     return nullptr;
 }
+std::vector<std::string> ProgramDescriptor::warmup_resources() const{
+    return {};
+}
 
 
 
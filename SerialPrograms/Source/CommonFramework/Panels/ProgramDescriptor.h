@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_CommonFramework_ProgramDescriptor_H
 #define PokemonAutomation_CommonFramework_ProgramDescriptor_H
 
+#include <vector>
 #include "PanelDescriptor.h"
 
 namespace PokemonAutomation{
@@ -19,6 +20,10 @@ public:
     using PanelDescriptor::PanelDescriptor;
 
     virtual std::unique_ptr<StatsTracker> make_stats() const;
+
+    //  Names of resources to load in the background when the program starts.
+    //  See "CommonFramework/Resources/ResourceWarmup.h".
+    virtual std::vector<std::string> warmup_resources() const;
 };
 
 
@@ -29,6 +29,7 @@ public:
     //  Serialization
     virtual void from_json(const JsonValue& json) override;
     virtual JsonValue to_json() const override;
+    virtual ConfigOption* options_root() override{ return &m_options; }
 
 protected:
     friend class SettingsPanelWidget;
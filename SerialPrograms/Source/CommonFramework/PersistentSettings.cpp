@@ -4,13 +4,24 @@
  *
  */
 
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <QCoreApplication>
+#include <QSaveFile>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonWriter.h"
+#include "Common/Cpp/Options/BatchOption.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Panels/PanelInstance.h"
 #include "NintendoSwitch/Framework/NintendoSwitch_VirtualControllerMapping.h"
 #include "PersistentSettings.h"
 
@@ -28,11 +39,285 @@ PersistentSettings& PERSISTENT_SETTINGS(){
 }
 
 
-PersistentSettings::PersistentSettings(){}
 
+namespace{
 
+std::string settings_path(){
+    return SETTINGS_PATH() + QCoreApplication::applicationName().toStdString() + "-Settings.json";
+}
+
+//  Listen to "option" and everything under it.
+void watch_option_tree(ConfigOption& option, ConfigOption::Listener& listener, std::vector<ConfigOption*>& watched){
+    option.add_listener(listener);
+    watched.emplace_back(&option);
+    BatchOption* batch = dynamic_cast<BatchOption*>(&option);
+    if (batch == nullptr){
+        return;
+    }
+    for (ConfigOption* child : batch->options()){
+        watch_option_tree(*child, listener, watched);
+    }
+}
+
+}
+
+
+
+class PersistentSettings::Writer{
+public:
+    //  Wait this long after the last change before writing...
+    static constexpr auto WRITE_DELAY = std::chrono::milliseconds(1000);
+    //  ...but never hold a change for longer than this.
+    static constexpr auto MAX_WRITE_DELAY = std::chrono::milliseconds(5000);
+
+public:
+    ~Writer(){
+        stop();
+    }
+
+    void track(std::string id, std::string root_key, std::string panel_key, ConfigOption& option, std::function<JsonValue()> serialize){
+        untrack(id);
+        std::unique_ptr<Section> section(new Section(*this, std::move(root_key), std::move(panel_key), std::move(serialize)));
+        watch_option_tree(option, *section, section->watched);
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_sections[std::move(id)] = std::move(section);
+    }
+    void untrack(const std::string& id){
+        std::unique_ptr<Section> section;
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            auto iter = m_sections.find(id);
+            if (iter == m_sections.end()){
+                return;
+            }
+            section = std::move(iter->second);
+            m_sections.erase(iter);
+        }
+
+        //  Listeners are called with the option's listener lock held, and
+        //  they take "m_lock". So this must be done without holding "m_lock".
+        for (ConfigOption* option : section->watched){
+            option->remove_listener(*section);
+        }
+    }
+    void untrack_all(){
+        std::vector<std::string> ids;
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            for (const auto& item : m_sections){
+                ids.emplace_back(item.first);
+            }
+        }
+        for (const std::string& id : ids){
+            untrack(id);
+        }
+    }
+
+    //  The tree as it was loaded from disk. Tracked sections are written on
+    //  top of it until the first full snapshot.
+    void set_base(JsonObject root){
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (!m_has_full_snapshot){
+            m_full_snapshot = std::move(root);
+            m_has_full_snapshot = true;
+        }
+    }
+
+    //  Replace the entire tree. Tracked sections are serialized again on top
+    //  of it since they may be newer.
+    void schedule_full(JsonObject root){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_full_snapshot = std::move(root);
+        m_has_full_snapshot = true;
+        for (auto& item : m_sections){
+            item.second->dirty = true;
+        }
+        mark_pending();
+    }
+    void flush(){
+        std::unique_lock<std::mutex> lg(m_lock);
+        if (m_written == m_requested){
+            return;
+        }
+        uint64_t target = m_requested;
+        m_flush = true;
+        m_cv.notify_all();
+        m_done_cv.wait(lg, [&]{ return m_written >= target; });
+        m_flush = false;
+    }
+    void stop(){
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_stopping = true;
+            m_cv.notify_all();
+        }
+        if (m_thread.joinable()){
+            m_thread.join();
+        }
+        m_done_cv.notify_all();
+    }
+
+
+private:
+    struct Section : public ConfigOption::Listener{
+        Writer& writer;
+        std::string root_key;
+        std::string panel_key;
+        std::function<JsonValue()> serialize;
+        std::vector<ConfigOption*> watched;
+        bool dirty = false;
+
+        Section(Writer& p_writer, std::string p_root_key, std::string p_panel_key, std::function<JsonValue()> p_serialize)
+            : writer(p_writer)
+            , root_key(std::move(p_root_key))
+            , panel_key(std::move(p_panel_key))
+            , serialize(std::move(p_serialize))
+        {}
+        virtual void value_changed(void* object) override{
+            std::lock_guard<std::mutex> lg(writer.m_lock);
+            dirty = true;
+            writer.mark_pending();
+        }
+    };
+
+    //  Must hold "m_lock".
+    void mark_pending(){
+        if (m_stopping){
+            return;
+        }
+        WallClock now = current_time();
+        if (m_requested == m_collected){
+            m_first_change = now;
+        }
+        m_last_change = now;
+        m_requested++;
+        if (!m_thread.joinable()){
+            m_thread = std::thread(run_with_catch, "PersistentSettings::Writer::thread_loop()", [this]{ thread_loop(); });
+        }
+        m_cv.notify_all();
+    }
+
+    void thread_loop(){
+        std::unique_lock<std::mutex> lg(m_lock);
+        while (true){
+            if (m_requested == m_collected){
+                if (m_stopping){
+                    return;
+                }
+                m_cv.wait(lg);
+                continue;
+            }
+
+            WallClock now = current_time();
+            WallClock deadline = std::min(m_last_change + WRITE_DELAY, m_first_change + MAX_WRITE_DELAY);
+            if (!m_flush && !m_stopping && now < deadline){
+                m_cv.wait_until(lg, deadline);
+                continue;
+            }
+
+            //  Collect everything that changed. "m_root" is only touched by
+            //  this thread.
+            uint64_t collected = m_requested;
+            if (m_root.empty() && !m_has_full_snapshot){
+                //  Nothing was loaded and there hasn't been a full snapshot.
+                //  Writing now would drop everything that isn't tracked.
+                //  Keep the sections dirty until the full tree arrives.
+                m_collected = collected;
+                m_written = collected;
+                m_done_cv.notify_all();
+                continue;
+            }
+            if (m_has_full_snapshot){
+                for (auto& item : m_full_snapshot){
+                    m_root[item.first] = std::move(item.second);
+                }
+                m_full_snapshot = JsonObject();
+                m_has_full_snapshot = false;
+            }
+            for (auto& item : m_sections){
+                Section& section = *item.second;
+                if (!section.dirty){
+                    continue;
+                }
+                section.dirty = false;
+                JsonValue value = section.serialize();
+                if (section.panel_key.empty()){
+                    m_root[section.root_key] = std::move(value);
+                    continue;
+                }
+                JsonValue& panels = m_root[section.root_key];
+                if (panels.to_object() == nullptr){
+                    panels = JsonObject();
+                }
+                (*panels.to_object())[section.panel_key] = std::move(value);
+            }
+            m_collected = collected;
+
+            //  Serialize and write without holding the lock.
+            lg.unlock();
+            write_file();
+            lg.lock();
+
+            m_written = collected;
+            m_done_cv.notify_all();
+        }
+    }
+
+    void write_file(){
+        std::string text;
+        write_json(text, m_root);
+
+        const std::string path = settings_path();
+        QSaveFile file(QString::fromStdString(path));
+        if (!file.open(QIODevice::WriteOnly) ||
+            file.write(text.data(), text.size()) != (qint64)text.size() ||
+            !file.commit()
+        ){
+            global_logger_tagged().log("Unable to save settings to: " + path, COLOR_RED);
+        }
+    }
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::condition_variable m_done_cv;
+    bool m_stopping = false;
+    bool m_flush = false;
+
+    std::map<std::string, std::unique_ptr<Section>> m_sections;
+
+    bool m_has_full_snapshot = false;
+    JsonObject m_full_snapshot;
+
+    //  # of changes requested, collected by the writer, and written to disk.
+    uint64_t m_requested = 0;
+    uint64_t m_collected = 0;
+    uint64_t m_written = 0;
+    WallClock m_first_change;
+    WallClock m_last_change;
+
+    JsonObject m_root;
 
-void PersistentSettings::write() const{
+    std::thread m_thread;
+};
+
+
+
+
+PersistentSettings::PersistentSettings()
+    : m_writer(new Writer())
+{}
+PersistentSettings::~PersistentSettings(){
+    m_writer->stop();
+}
+
+
+
+void PersistentSettings::write(){
+    write_deferred();
+    flush();
+}
+void PersistentSettings::write_deferred(){
     JsonObject root;
 
     root["20-GlobalSettings"] = GlobalSettings::instance().to_json();
@@ -40,20 +325,52 @@ void PersistentSettings::write() const{
 
     root["99-Panels"] = panels.clone();
 
-    try{
-        std::string settings_path = SETTINGS_PATH() + QCoreApplication::applicationName().toStdString() + "-Settings.json";
-        root.dump(settings_path);
-    }catch (FileException&){}
+    m_writer->schedule_full(std::move(root));
+}
+void PersistentSettings::flush(){
+    m_writer->flush();
+}
+
+
+void PersistentSettings::track_section(const std::string& key, ConfigOption& option, std::function<JsonValue()> serialize){
+    m_writer->track(key, key, "", option, std::move(serialize));
+}
+void PersistentSettings::untrack_section(const std::string& key){
+    m_writer->untrack(key);
+}
+void PersistentSettings::track_panel(PanelInstance& panel){
+    const std::string& identifier = panel.descriptor().identifier();
+    ConfigOption* option = panel.options_root();
+    if (identifier.empty() || option == nullptr){
+        return;
+    }
+    m_writer->track(
+        "99-Panels/" + identifier, "99-Panels", identifier,
+        *option, [&panel]{ return panel.to_json(); }
+    );
+}
+void PersistentSettings::untrack_panel(PanelInstance& panel){
+    const std::string& identifier = panel.descriptor().identifier();
+    if (identifier.empty()){
+        return;
+    }
+    m_writer->untrack("99-Panels/" + identifier);
+}
+void PersistentSettings::shutdown(){
+    m_writer->untrack_all();
+    m_writer->flush();
+    m_writer->stop();
 }
 
 
 void PersistentSettings::read(){
-    std::string settings_path = SETTINGS_PATH() + QCoreApplication::applicationName().toStdString() + "-Settings.json";
-    JsonValue json = load_json_file(settings_path);
+    const std::string path = settings_path();
+    JsonValue json = load_json_file(path);
     JsonObject* obj = json.to_object();
     if (obj == nullptr){
-        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid settings file.", settings_path);
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid settings file.", path);
     }
+    m_writer->set_base(obj->clone());
 
     //  Need to load this subset of settings first because they will affect how
     //  "GlobalSettings" is constructed.
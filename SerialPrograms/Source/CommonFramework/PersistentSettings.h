@@ -8,10 +8,16 @@
 #ifndef PokemonAutomation_PersistentSettings_H
 #define PokemonAutomation_PersistentSettings_H
 
+#include <memory>
+#include <functional>
 #include "Common/Cpp/Json/JsonObject.h"
 
 namespace PokemonAutomation{
 
+class ConfigOption;
+class PanelInstance;
+
+
 // Global setting of the whole program.
 // The setting is stored in the local folder, named as SerialPrograms-Settings.json.
 // The settings json has three fields:
@@ -20,17 +26,48 @@ namespace PokemonAutomation{
 // - "50-SwitchKeyboardMapping": keyboard mapping.
 // - "99-Panels": settings for all the programs listed in the program panels.
 //   Access via PersistentSettings::panels.
+//
+// Saving is done by a background writer. Changes are debounced so that a
+// burst of edits results in a single write. The file is replaced atomically
+// so a crash in the middle of a save never leaves a truncated file behind.
+//
+// Tracked options (the global settings and the currently open panel) are
+// watched through ConfigOption listeners. When one of them changes, only
+// that subtree is serialized again before the next write.
 class PersistentSettings{
 public:
     PersistentSettings();
+    ~PersistentSettings();
 
-    // Write settings to the json file.
-    void write() const;
+    // Write settings to the json file. Blocks until the file is written.
+    void write();
+    // Schedule a write of all the settings and return immediately.
+    void write_deferred();
+    // Wait for any scheduled write to finish.
+    void flush();
     // Load settings from the json file.
     void read();
 
+    // Save a subtree automatically whenever "option" or anything under it
+    // changes. "key" is the top-level key in the settings json.
+    void track_section(const std::string& key, ConfigOption& option, std::function<JsonValue()> serialize);
+    void untrack_section(const std::string& key);
+
+    // Same as above for the panel's options. Its json goes under "99-Panels".
+    // Must be untracked before the panel is destroyed.
+    void track_panel(PanelInstance& panel);
+    void untrack_panel(PanelInstance& panel);
+
+    // Stop tracking everything, finish any pending write and stop the
+    // writer. Call this before the tracked options are destroyed.
+    void shutdown();
+
 public:
     JsonObject panels;
+
+private:
+    class Writer;
+    std::unique_ptr<Writer> m_writer;
 };
 
 // Return the singleton PersistentSettings.
@@ -0,0 +1,216 @@
+/*  Binary Resource Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "BinaryResourceCache.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+//  Bump this if the header or any of the basic encodings change.
+const uint32_t CACHE_FORMAT_VERSION = 1;
+
+const char CACHE_MAGIC[8] = {'P', 'A', 'B', 'i', 'n', 'R', 'e', 's'};
+
+struct CacheHeader{
+    char magic[8];
+    uint32_t format_version;
+    uint32_t artifact_version;
+    uint64_t source_hash;
+    uint64_t payload_bytes;
+    char reserved[32];
+};
+static_assert(sizeof(CacheHeader) == 64);
+
+
+std::string cache_path(const std::string& name){
+    return SETTINGS_PATH() + "ResourceCache/" + name + ".bin";
+}
+
+}
+
+
+
+uint64_t hash_resource_bytes(const void* data, size_t bytes, uint64_t hash){
+    const unsigned char* ptr = (const unsigned char*)data;
+    for (size_t c = 0; c < bytes; c++){
+        hash ^= ptr[c];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+uint64_t hash_resource_file(const std::string& path, uint64_t hash){
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QFile::ReadOnly)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", path);
+    }
+    const uchar* data = file.size() == 0 ? nullptr : file.map(0, file.size());
+    if (data != nullptr){
+        hash = hash_resource_bytes(data, (size_t)file.size(), hash);
+    }else{
+        QByteArray bytes = file.readAll();
+        hash = hash_resource_bytes(bytes.data(), bytes.size(), hash);
+    }
+    return hash;
+}
+
+
+
+const char* BinaryResourceReader::read_bytes(size_t bytes){
+    if (bytes > m_bytes - m_offset){
+        throw_corrupt();
+    }
+    const char* ret = m_data + m_offset;
+    m_offset += bytes;
+    return ret;
+}
+void BinaryResourceReader::align(size_t alignment){
+    size_t offset = (m_offset + alignment - 1) / alignment * alignment;
+    if (offset > m_bytes){
+        throw_corrupt();
+    }
+    m_offset = offset;
+}
+size_t BinaryResourceReader::checked_size(uint64_t count, size_t element_size) const{
+    if (count > (m_bytes - m_offset) / element_size){
+        throw_corrupt();
+    }
+    return (size_t)count;
+}
+void BinaryResourceReader::throw_corrupt() const{
+    throw FileException(nullptr, PA_CURRENT_FUNCTION, "Resource cache entry is truncated or corrupt.", m_name);
+}
+
+
+
+bool load_cached_resource(
+    const std::string& name, uint32_t version, uint64_t source_hash,
+    const std::function<void(BinaryResourceReader& reader)>& read
+){
+    const std::string path = cache_path(name);
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QFile::ReadOnly)){
+        return false;
+    }
+    if ((size_t)file.size() < sizeof(CacheHeader)){
+        return false;
+    }
+    const uchar* data = file.map(0, file.size());
+    if (data == nullptr){
+        return false;
+    }
+
+    CacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.format_version != CACHE_FORMAT_VERSION ||
+        header.artifact_version != version ||
+        header.source_hash != source_hash ||
+        header.payload_bytes != (uint64_t)file.size() - sizeof(CacheHeader)
+    ){
+        return false;
+    }
+
+    try{
+        BinaryResourceReader reader((const char*)data + sizeof(CacheHeader), (size_t)header.payload_bytes, path);
+        read(reader);
+        if (!reader.at_end()){
+            global_logger_tagged().log("Resource Cache: Ignoring entry with trailing data: " + name, COLOR_RED);
+            return false;
+        }
+    }catch (FileException& e){
+        global_logger_tagged().log("Resource Cache: " + e.message(), COLOR_RED);
+        return false;
+    }
+    return true;
+}
+
+void store_cached_resource(
+    const std::string& name, uint32_t version, uint64_t source_hash,
+    const BinaryResourceWriter& writer
+){
+    const std::string path = cache_path(name);
+    const QString qpath = QString::fromStdString(path);
+    if (!QDir().mkpath(QFileInfo(qpath).absolutePath())){
+        global_logger_tagged().log("Resource Cache: Unable to create folder for: " + path, COLOR_RED);
+        return;
+    }
+
+    CacheHeader header{};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.format_version = CACHE_FORMAT_VERSION;
+    header.artifact_version = version;
+    header.source_hash = source_hash;
+    header.payload_bytes = writer.data().size();
+
+    //  QSaveFile writes to a uniquely named temporary file and atomically
+    //  replaces the entry on commit(). So a crash or a second instance never
+    //  sees a partial entry.
+    const std::string& payload = writer.data();
+    QSaveFile file(qpath);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write((const char*)&header, sizeof(header)) != (qint64)sizeof(header) ||
+        file.write(payload.data(), payload.size()) != (qint64)payload.size() ||
+        !file.commit()
+    ){
+        global_logger_tagged().log("Resource Cache: Unable to write: " + path, COLOR_RED);
+        return;
+    }
+    global_logger_tagged().log(
+        "Resource Cache: Stored " + name + " (" + std::to_string(writer.data().size()) + " bytes)",
+        COLOR_BLUE
+    );
+}
+
+
+
+namespace{
+
+struct ResourceCacheBuilders{
+    std::mutex lock;
+    std::map<std::string, std::function<void()>> builders;
+
+    static ResourceCacheBuilders& instance(){
+        static ResourceCacheBuilders builders;
+        return builders;
+    }
+};
+
+}
+
+bool register_resource_cache_builder(const char* name, std::function<void()> build){
+    ResourceCacheBuilders& builders = ResourceCacheBuilders::instance();
+    std::lock_guard<std::mutex> lg(builders.lock);
+    builders.builders[name] = std::move(build);
+    return true;
+}
+void build_all_resource_caches(Logger& logger){
+    std::map<std::string, std::function<void()>> builders;
+    {
+        ResourceCacheBuilders& registry = ResourceCacheBuilders::instance();
+        std::lock_guard<std::mutex> lg(registry.lock);
+        builders = registry.builders;
+    }
+    for (const auto& item : builders){
+        logger.log("Resource Cache: Building " + item.first + "...", COLOR_BLUE);
+        item.second();
+    }
+    logger.log("Resource Cache: Done.", COLOR_BLUE);
+}
+
+
+
+}
@@ -0,0 +1,211 @@
+/*  Binary Resource Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Versioned on-disk cache for data that is expensive to rebuild from the
+ *  PNG/JSON resources. (preprocessed templates, sprite features, etc...)
+ *
+ *  Each artifact is stored in its own file under "<SETTINGS_PATH>/ResourceCache/"
+ *  as a fixed header followed by the payload. The header records the
+ *  artifact version and a hash of the source resources. If either doesn't
+ *  match, the file is ignored and rebuilt. Cache files are memory-mapped
+ *  and the payload is copied out of the mapping into the owning containers.
+ *
+ */
+
+#ifndef PokemonAutomation_Resources_BinaryResourceCache_H
+#define PokemonAutomation_Resources_BinaryResourceCache_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <type_traits>
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+//  FNV-1a. Chain calls by passing the previous result as "hash".
+const uint64_t RESOURCE_HASH_SEED = 0xcbf29ce484222325;
+uint64_t hash_resource_bytes(const void* data, size_t bytes, uint64_t hash = RESOURCE_HASH_SEED);
+uint64_t hash_resource_file(const std::string& path, uint64_t hash = RESOURCE_HASH_SEED);
+
+
+
+//  Serializes an artifact into the cache format.
+class BinaryResourceWriter{
+public:
+    const std::string& data() const{ return m_data; }
+
+    void write_bytes(const void* data, size_t bytes){
+        m_data.append((const char*)data, bytes);
+    }
+
+    template <typename Type>
+    void write(const Type& x){
+        static_assert(std::is_trivially_copyable<Type>::value);
+        write_bytes(&x, sizeof(Type));
+    }
+
+    void write_string(const std::string& str){
+        write<uint64_t>(str.size());
+        write_bytes(str.data(), str.size());
+    }
+
+    template <typename Type>
+    void write_vector(const std::vector<Type>& vec){
+        static_assert(std::is_trivially_copyable<Type>::value);
+        write<uint64_t>(vec.size());
+        align(alignof(Type));
+        write_bytes(vec.data(), vec.size() * sizeof(Type));
+    }
+
+    //  Works with any 32-bit planar image. (ImageViewRGB32, ImageViewHSV32, ...)
+    //  Rows are stored packed and 64-byte aligned.
+    template <typename ImageType>
+    void write_image(const ImageType& image){
+        write<uint64_t>(image.width());
+        write<uint64_t>(image.height());
+        align(64);
+        for (size_t r = 0; r < image.height(); r++){
+            write_bytes((const char*)image.data() + r * image.bytes_per_row(), image.width() * sizeof(uint32_t));
+        }
+    }
+
+private:
+    void align(size_t alignment){
+        m_data.resize((m_data.size() + alignment - 1) / alignment * alignment);
+    }
+
+private:
+    std::string m_data;
+};
+
+
+
+//  Reads an artifact back out of the cache. Throws FileException if the
+//  payload is truncated or malformed.
+class BinaryResourceReader{
+public:
+    BinaryResourceReader(const char* data, size_t bytes, std::string name)
+        : m_data(data)
+        , m_bytes(bytes)
+        , m_name(std::move(name))
+    {}
+
+    //  Returns a pointer into the mapped file. Valid until the read callback
+    //  returns, so anything kept must be copied out.
+    const char* read_bytes(size_t bytes);
+
+    template <typename Type>
+    Type read(){
+        static_assert(std::is_trivially_copyable<Type>::value);
+        Type ret;
+        memcpy(&ret, read_bytes(sizeof(Type)), sizeof(Type));
+        return ret;
+    }
+
+    std::string read_string(){
+        size_t size = checked_size(read<uint64_t>(), 1);
+        return std::string(read_bytes(size), size);
+    }
+
+    template <typename Type>
+    std::vector<Type> read_vector(){
+        static_assert(std::is_trivially_copyable<Type>::value);
+        size_t size = checked_size(read<uint64_t>(), sizeof(Type));
+        align(alignof(Type));
+        std::vector<Type> ret(size);
+        memcpy(ret.data(), read_bytes(size * sizeof(Type)), size * sizeof(Type));
+        return ret;
+    }
+
+    //  ImageType must be an owning 32-bit image. (ImageRGB32, ImageHSV32, ...)
+    template <typename ImageType>
+    ImageType read_image(){
+        size_t width = checked_size(read<uint64_t>(), sizeof(uint32_t));
+        size_t height = checked_size(read<uint64_t>(), 1);
+        align(64);
+        const size_t row_bytes = width * sizeof(uint32_t);
+        const char* pixels = read_bytes(checked_size(height, row_bytes) * row_bytes);
+        ImageType ret(width, height);
+        for (size_t r = 0; r < height; r++){
+            memcpy((char*)ret.data() + r * ret.bytes_per_row(), pixels + r * row_bytes, row_bytes);
+        }
+        return ret;
+    }
+
+    bool at_end() const{ return m_offset == m_bytes; }
+
+private:
+    void align(size_t alignment);
+    size_t checked_size(uint64_t count, size_t element_size) const;
+    [[noreturn]] void throw_corrupt() const;
+
+private:
+    const char* m_data;
+    size_t m_bytes;
+    size_t m_offset = 0;
+    std::string m_name;
+};
+
+
+
+//  Look up "name" in the cache. If the entry exists and matches "version"
+//  and "source_hash", calls "read" on it and returns true. Otherwise (or if
+//  "read" throws), returns false.
+bool load_cached_resource(
+    const std::string& name, uint32_t version, uint64_t source_hash,
+    const std::function<void(BinaryResourceReader& reader)>& read
+);
+
+//  Write an entry to the cache. Failures are logged and otherwise ignored.
+void store_cached_resource(
+    const std::string& name, uint32_t version, uint64_t source_hash,
+    const BinaryResourceWriter& writer
+);
+
+
+//  Load "name" from the cache if it's up-to-date. Otherwise build it and
+//  store it for next time.
+template <typename Type>
+Type load_or_build_cached_resource(
+    const std::string& name, uint32_t version, uint64_t source_hash,
+    const std::function<Type()>& build,
+    const std::function<void(BinaryResourceWriter& writer, const Type& value)>& write,
+    const std::function<Type(BinaryResourceReader& reader)>& read
+){
+    Type ret;
+    bool loaded = load_cached_resource(
+        name, version, source_hash,
+        [&](BinaryResourceReader& reader){
+            ret = read(reader);
+        }
+    );
+    if (loaded){
+        return ret;
+    }
+    ret = build();
+    BinaryResourceWriter writer;
+    write(writer, ret);
+    store_cached_resource(name, version, source_hash, writer);
+    return ret;
+}
+
+
+
+//  Ahead-of-time cache generation.
+//
+//  Artifacts that are worth prebuilding register a function that forces them
+//  to load. "SerialPrograms --build-resource-cache" runs all of them and exits,
+//  so the cache can be filled as a build or install step.
+bool register_resource_cache_builder(const char* name, std::function<void()> build);
+void build_all_resource_caches(Logger& logger);
+
+
+
+}
+#endif
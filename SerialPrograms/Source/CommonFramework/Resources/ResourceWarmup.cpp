@@ -0,0 +1,191 @@
+/*  Resource Warm-up
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <map>
+#include <thread>
+#include <future>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "ResourceWarmup.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+struct WarmupEntry{
+    int priority;
+    std::function<void()> load;
+
+    //  Set by the first warm-up that picks this resource. Other programs
+    //  running at the same time skip it instead of loading it twice, and
+    //  getters wait on "loaded". Cleared again if the load fails.
+    std::mutex lock;
+    bool started = false;
+    std::shared_future<void> loaded;
+};
+
+//  The entry whose "load" is running on this thread. Its getter must not
+//  wait on its own future.
+thread_local const WarmupEntry* t_loading = nullptr;
+
+struct WarmupRegistry{
+    std::mutex lock;
+    std::map<std::string, std::unique_ptr<WarmupEntry>> entries;
+
+    static WarmupRegistry& instance(){
+        static WarmupRegistry registry;
+        return registry;
+    }
+    WarmupEntry* find(const std::string& name){
+        std::lock_guard<std::mutex> lg(lock);
+        auto iter = entries.find(name);
+        return iter == entries.end() ? nullptr : iter->second.get();
+    }
+};
+
+
+std::string ms_since(WallClock start){
+    return std::to_string(
+        std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start).count()
+    ) + " ms";
+}
+
+
+//  Load the resource if no warm-up has started it yet.
+void warm_up(Logger& logger, const std::string& name, WarmupEntry& entry){
+    std::promise<void> promise;
+    {
+        std::lock_guard<std::mutex> lg(entry.lock);
+        if (entry.started){
+            return;
+        }
+        entry.started = true;
+        entry.loaded = promise.get_future().share();
+    }
+    WallClock start = current_time();
+    t_loading = &entry;
+    try{
+        entry.load();
+    }catch (...){
+        t_loading = nullptr;
+        //  Not fatal. The detector that needs it will retry through the getter.
+        logger.log("Resource Warm-up: Failed to load " + name, COLOR_RED);
+        {
+            std::lock_guard<std::mutex> lg(entry.lock);
+            entry.started = false;
+        }
+        promise.set_value();
+        return;
+    }
+    t_loading = nullptr;
+    promise.set_value();
+    logger.log("Resource Warm-up: Loaded " + name + " in " + ms_since(start), COLOR_BLUE);
+}
+
+
+}
+
+
+
+bool register_warmup_resource(const char* name, int priority, std::function<void()> load){
+    WarmupRegistry& registry = WarmupRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    std::unique_ptr<WarmupEntry>& entry = registry.entries[name];
+    if (entry){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, std::string("Duplicate warm-up resource: ") + name);
+    }
+    entry.reset(new WarmupEntry());
+    entry->priority = priority;
+    entry->load = std::move(load);
+    return true;
+}
+void wait_for_warmup_resource(const char* name){
+    WarmupEntry* entry = WarmupRegistry::instance().find(name);
+    if (entry == nullptr || entry == t_loading){
+        return;
+    }
+    std::shared_future<void> loaded;
+    {
+        std::lock_guard<std::mutex> lg(entry->lock);
+        loaded = entry->loaded;
+    }
+    if (loaded.valid()){
+        loaded.wait();
+    }
+}
+
+ResourceWarmup::ResourceWarmup(
+    Logger& logger,
+    AsyncDispatcher& dispatcher,
+    const std::vector<std::string>& resources
+)
+    : m_logger(logger)
+{
+    WarmupRegistry& registry = WarmupRegistry::instance();
+
+    std::vector<std::pair<int, std::string>> sorted;
+    for (const std::string& name : resources){
+        WarmupEntry* entry = registry.find(name);
+        if (entry == nullptr){
+            logger.log("Resource Warm-up: Unknown resource: " + name, COLOR_RED);
+            continue;
+        }
+        sorted.emplace_back(entry->priority, name);
+    }
+    if (sorted.empty()){
+        return;
+    }
+    std::stable_sort(
+        sorted.begin(), sorted.end(),
+        [](const std::pair<int, std::string>& a, const std::pair<int, std::string>& b){
+            return a.first > b.first;
+        }
+    );
+    for (auto& item : sorted){
+        m_queue.emplace_back(std::move(item.second));
+    }
+
+    //  Leave room for the program's own inference threads.
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency() / 2, 1);
+    threads = std::min(threads, m_queue.size());
+    for (size_t c = 0; c < threads; c++){
+        m_workers.emplace_back(dispatcher.dispatch([this]{ worker_loop(); }));
+    }
+}
+ResourceWarmup::~ResourceWarmup(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+    }
+    m_workers.clear();
+}
+void ResourceWarmup::worker_loop(){
+    WarmupRegistry& registry = WarmupRegistry::instance();
+    while (true){
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            if (m_stopping || m_queue.empty()){
+                return;
+            }
+            name = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        WarmupEntry* entry = registry.find(name);
+        if (entry != nullptr){
+            warm_up(m_logger, name, *entry);
+        }
+    }
+}
+
+
+
+}
@@ -0,0 +1,82 @@
+/*  Resource Warm-up
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Loads heavy resources (OCR dictionaries, sprite databases, matching data,
+ *  etc...) in the background when a program starts instead of inline in
+ *  whichever detector touches them first.
+ *
+ *  Resources register themselves by name with a function that forces them to
+ *  load. This is usually a call to the resource's existing getter, which is
+ *  a function-local static. Program descriptors list the names they need in
+ *  ProgramDescriptor::warmup_resources().
+ *
+ *  Each getter calls wait_for_warmup_resource() before touching its static.
+ *  A detector that reaches a resource while its warm-up is in progress waits
+ *  on that warm-up's future instead of starting a second load. If the warm-up
+ *  fails, the getter loads the resource on its own thread as before.
+ *
+ */
+
+#ifndef PokemonAutomation_Resources_ResourceWarmup_H
+#define PokemonAutomation_Resources_ResourceWarmup_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+
+namespace PokemonAutomation{
+
+class Logger;
+class AsyncTask;
+class AsyncDispatcher;
+
+
+//  Register a resource that can be warmed up. Higher priority loads first.
+//  Returns true so it can be used to initialize a namespace-scope constant.
+//  "load" may call the resource's own getter.
+bool register_warmup_resource(const char* name, int priority, std::function<void()> load);
+
+//  If a warm-up of this resource is in progress, block until it finishes.
+//  Returns right away if the resource isn't registered, no warm-up has
+//  started it, or it is called from inside that warm-up's "load".
+void wait_for_warmup_resource(const char* name);
+
+
+
+//  Loads the listed resources in parallel on "dispatcher" for the lifetime of
+//  this object. Loading is mostly file I/O, so it stays off the global compute
+//  pool. At most half the CPU threads are used so the program's own inference
+//  isn't starved. Declare this right after the program environment.
+//
+//  The destructor doesn't start anything new and waits only for loads that
+//  are already in progress.
+class ResourceWarmup{
+public:
+    ResourceWarmup(
+        Logger& logger,
+        AsyncDispatcher& dispatcher,
+        const std::vector<std::string>& resources
+    );
+    ~ResourceWarmup();
+
+private:
+    void worker_loop();
+
+private:
+    Logger& m_logger;
+
+    std::mutex m_lock;
+    bool m_stopping = false;
+    std::deque<std::string> m_queue;
+
+    std::vector<std::unique_ptr<AsyncTask>> m_workers;
+};
+
+
+
+}
+#endif
@@ -21,6 +21,7 @@ ConsoleHandle::ConsoleHandle(ConsoleHandle&& x) = default;
 ConsoleHandle::~ConsoleHandle(){
     m_overlay.remove_stat(*m_audio_pivot);
     m_overlay.remove_stat(*m_video_pivot);
+    m_overlay.remove_stat(*m_inference_utilization);
     m_overlay.remove_stat(*m_thread_utilization);
 }
 
@@ -46,8 +47,14 @@ ConsoleHandle::ConsoleHandle(
 }
 
 void ConsoleHandle::initialize_inference_threads(CancellableScope& scope, AsyncDispatcher& dispatcher){
-    m_video_pivot = std::make_unique<VisualInferencePivot>(scope, m_video, dispatcher);
-    m_audio_pivot = std::make_unique<AudioInferencePivot>(scope, m_audio, dispatcher);
+    m_inference_client = std::make_unique<InferenceExecutor::Client>(InferenceExecutor::instance());
+    m_inference_utilization = std::make_unique<ThreadUtilizationStat>(
+        [client = m_inference_client.get()]{ return client->busy_time(); },
+        "Inference Workers:"
+    );
+    m_video_pivot = std::make_unique<VisualInferencePivot>(scope, m_video, dispatcher, *m_inference_client);
+    m_audio_pivot = std::make_unique<AudioInferencePivot>(scope, m_audio, dispatcher, *m_inference_client);
+    m_overlay.add_stat(*m_inference_utilization);
     m_overlay.add_stat(*m_video_pivot);
     m_overlay.add_stat(*m_audio_pivot);
 }
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include "Common/Cpp/AbstractLogger.h"
+#include "CommonFramework/InferenceInfra/InferenceExecutor.h"
 
 namespace PokemonAutomation{
 
@@ -78,6 +79,8 @@ private:
     VideoOverlay& m_overlay;
     AudioFeed& m_audio;
     std::unique_ptr<ThreadUtilizationStat> m_thread_utilization;
+    std::unique_ptr<InferenceExecutor::Client> m_inference_client;
+    std::unique_ptr<ThreadUtilizationStat> m_inference_utilization;
     std::unique_ptr<VisualInferencePivot> m_video_pivot;
     std::unique_ptr<AudioInferencePivot> m_audio_pivot;
 };
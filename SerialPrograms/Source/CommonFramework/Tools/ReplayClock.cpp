@@ -0,0 +1,47 @@
+/*  Replay Clock
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "ReplayClock.h"
+
+namespace PokemonAutomation{
+
+
+ReplayClock::ReplayClock(ReplayPacing pacing, double units_per_second)
+    : m_pacing(pacing)
+    , m_units_per_second(units_per_second > 0 ? units_per_second : 1)
+    , m_start(current_time())
+    , m_next(0)
+{}
+void ReplayClock::restart(WallClock now){
+    m_start = now;
+    m_next = 0;
+}
+uint64_t ReplayClock::current_index(WallClock now) const{
+    switch (m_pacing){
+    case ReplayPacing::REAL_TIME:{
+        if (now <= m_start){
+            return 0;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_start);
+        return (uint64_t)((double)elapsed.count() * m_units_per_second / 1000000);
+    }
+    case ReplayPacing::AS_FAST_AS_POSSIBLE:
+        return m_next;
+    }
+    return 0;
+}
+void ReplayClock::step(){
+    if (m_pacing == ReplayPacing::AS_FAST_AS_POSSIBLE){
+        m_next++;
+    }
+}
+WallClock ReplayClock::timestamp_of(uint64_t index) const{
+    auto offset = std::chrono::microseconds((int64_t)((double)index * 1000000 / m_units_per_second));
+    return m_start + std::chrono::duration_cast<WallClock::duration>(offset);
+}
+
+
+}
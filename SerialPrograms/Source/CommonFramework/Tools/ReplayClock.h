@@ -0,0 +1,66 @@
+/*  Replay Clock
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Decides which recorded frame/spectrum should be "live" when replaying
+ *  recorded footage through the inference pipeline.
+ *
+ *  In real-time mode, the index advances with the wall clock.
+ *  In as-fast-as-possible mode, the index only advances when whoever drives
+ *  the replay calls step(). It does this once per tick, after every consumer
+ *  has seen the current unit. So every recorded unit is seen exactly once by
+ *  every consumer regardless of how many there are or how fast they are.
+ *  Timestamps are synthesized from the recorded rate so that timing-based
+ *  logic behaves the same as it did during the recording.
+ *
+ *  This class is not thread-safe.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ReplayClock_H
+#define PokemonAutomation_CommonFramework_ReplayClock_H
+
+#include <stdint.h>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+
+enum class ReplayPacing{
+    REAL_TIME,
+    AS_FAST_AS_POSSIBLE,
+};
+
+
+class ReplayClock{
+public:
+    //  "units_per_second" is the recorded rate. (fps for video)
+    ReplayClock(ReplayPacing pacing, double units_per_second);
+
+    ReplayPacing pacing() const{ return m_pacing; }
+    double units_per_second() const{ return m_units_per_second; }
+
+    //  Start over from unit zero.
+    void restart(WallClock now = current_time());
+
+    //  Return the index of the unit that is current as of now.
+    uint64_t current_index(WallClock now = current_time()) const;
+
+    //  AS_FAST_AS_POSSIBLE: Move on to the next unit.
+    //  REAL_TIME: Does nothing. The wall clock decides.
+    void step();
+
+    //  The timestamp to report for the specified unit.
+    WallClock timestamp_of(uint64_t index) const;
+
+private:
+    ReplayPacing m_pacing;
+    double m_units_per_second;
+    WallClock m_start;
+    uint64_t m_next;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,261 @@
+/*  Camera File Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <QDir>
+#include <QFileInfo>
+#include <QPainter>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/VideoPipeline/CameraOption.h"
+#include "CameraFileReplay.h"
+
+namespace PokemonAutomation{
+namespace CameraFileReplay{
+
+
+const std::string& REPLAY_FOOTAGE_PATH(){
+    static std::string path = USER_FILE_PATH() + "ReplayFootage/";
+    return path;
+}
+
+
+
+std::vector<CameraInfo> CameraBackend::get_all_cameras() const{
+    QDir dir(QString::fromStdString(REPLAY_FOOTAGE_PATH()));
+    QStringList entries = dir.entryList(
+        QStringList() << "*" << QString::fromStdString("*" + RAW_FRAME_DUMP_EXTENSION),
+        QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot, QDir::Name
+    );
+    std::vector<CameraInfo> ret;
+    for (const QString& entry : entries){
+        QFileInfo info(dir.filePath(entry));
+        if (info.isDir() || entry.endsWith(QString::fromStdString(RAW_FRAME_DUMP_EXTENSION))){
+            ret.emplace_back(info.filePath().toStdString());
+        }
+    }
+    return ret;
+}
+std::string CameraBackend::get_camera_name(const CameraInfo& info) const{
+    return "Replay: " + QFileInfo(QString::fromStdString(info.device_name())).fileName().toStdString();
+}
+std::unique_ptr<PokemonAutomation::CameraSession> CameraBackend::make_camera(Logger& logger, Resolution default_resolution) const{
+    return std::make_unique<CameraSession>(logger, m_pacing);
+}
+
+
+
+
+void CameraSession::add_listener(Listener& listener){
+    m_sanitizer.check_usage();
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_listeners.insert(&listener);
+}
+void CameraSession::remove_listener(Listener& listener){
+    m_sanitizer.check_usage();
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_listeners.erase(&listener);
+}
+
+CameraSession::~CameraSession(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+}
+CameraSession::CameraSession(Logger& logger, ReplayPacing pacing)
+    : m_logger(logger)
+    , m_pacing(pacing)
+    , m_last_index(0)
+    , m_finished(false)
+{}
+
+void CameraSession::get(CameraOption& option){
+    std::lock_guard<std::mutex> lg(m_lock);
+    option.info = m_device;
+    option.current_resolution = m_source ? m_source->resolution() : Resolution();
+}
+void CameraSession::set(const CameraOption& option){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+    m_device = option.info;
+    startup();
+}
+void CameraSession::reset(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+    startup();
+}
+void CameraSession::set_source(CameraInfo device){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+    m_device = std::move(device);
+    startup();
+}
+void CameraSession::set_resolution(Resolution resolution){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_source && resolution != m_source->resolution()){
+        m_logger.log("Replay sources cannot change resolution: " + resolution.to_string(), COLOR_RED);
+    }
+}
+CameraInfo CameraSession::current_device() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_device;
+}
+Resolution CameraSession::current_resolution() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_source ? m_source->resolution() : Resolution();
+}
+std::vector<Resolution> CameraSession::supported_resolutions() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::vector<Resolution> ret;
+    if (m_source){
+        ret.emplace_back(m_source->resolution());
+    }
+    return ret;
+}
+
+VideoSnapshot CameraSession::snapshot(){
+    //  Prevent multiple concurrent screenshots from entering here.
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    if (!m_source){
+        return VideoSnapshot();
+    }
+
+    size_t last = m_source->frames() - 1;
+    size_t index = (size_t)std::min<uint64_t>(m_clock->current_index(), last);
+
+    //  Frame is already cached and is not stale.
+    if (m_last_snapshot && index == m_last_index){
+        return m_last_snapshot;
+    }
+
+    ImageRGB32 image = m_source->load_frame(index);
+    if (!image){
+        m_logger.log("Unable to load replay frame: " + std::to_string(index), COLOR_RED);
+        return m_last_snapshot ? m_last_snapshot : VideoSnapshot();
+    }
+
+    WallClock timestamp = m_clock->timestamp_of(index);
+    m_last_snapshot = VideoSnapshot(std::move(image), timestamp);
+    m_last_index = index;
+    m_fps_tracker_source.push_event(timestamp);
+
+    if (index == last && !m_finished){
+        m_finished = true;
+        m_logger.log("Replay finished: " + m_device.device_name());
+    }
+
+    return m_last_snapshot;
+}
+double CameraSession::fps_source(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_fps_tracker_source.events_per_second();
+}
+double CameraSession::fps_display(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_fps_tracker_display.events_per_second();
+}
+void CameraSession::step(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_clock){
+        m_clock->step();
+    }
+}
+bool CameraSession::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_finished;
+}
+void CameraSession::report_rendered_frame(WallClock timestamp){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_fps_tracker_display.push_event(timestamp);
+}
+
+
+void CameraSession::shutdown(){
+    if (!m_source){
+        return;
+    }
+    m_logger.log("Stopping Replay...");
+    for (Listener* listener : m_listeners){
+        listener->shutdown();
+    }
+    m_source.reset();
+    m_clock.reset();
+    m_last_snapshot.clear();
+    m_last_index = 0;
+    m_finished = false;
+}
+void CameraSession::startup(){
+    if (!m_device){
+        return;
+    }
+    m_logger.log(
+        std::string("Starting Camera: Backend = CameraFileReplay (") +
+        (m_pacing == ReplayPacing::REAL_TIME ? "real-time" : "as fast as possible") + ")"
+    );
+
+    try{
+        m_source = open_replay_source(m_device.device_name());
+    }catch (FileException& e){
+        m_logger.log(e.message(), COLOR_RED);
+        return;
+    }
+    m_clock.reset(new ReplayClock(m_pacing, m_source->fps()));
+
+    Resolution resolution = m_source->resolution();
+    m_logger.log(
+        "Replay source: " + std::to_string(m_source->frames()) + " frames, " +
+        resolution.to_string() + ", " + std::to_string(m_source->fps()) + " fps"
+    );
+
+    for (Listener* listener : m_listeners){
+        listener->new_source(m_device, resolution);
+    }
+}
+
+PokemonAutomation::VideoWidget* CameraSession::make_QtWidget(QWidget* parent){
+    return new VideoWidget(parent, *this);
+}
+
+
+
+
+VideoWidget::VideoWidget(QWidget* parent, CameraSession& session)
+    : PokemonAutomation::VideoWidget(parent)
+    , m_session(session)
+    , m_last_timestamp(WallClock::min())
+{
+    this->setMinimumSize(80, 45);
+    connect(
+        &m_refresh_timer, &QTimer::timeout,
+        this, [this]{ this->update(); }
+    );
+    m_refresh_timer.start(33);
+}
+void VideoWidget::paintEvent(QPaintEvent* event){
+    QWidget::paintEvent(event);
+
+    //  Not a cached copy. Otherwise the display only moves when something
+    //  else calls snapshot().
+    VideoSnapshot frame = m_session.snapshot();
+    if (!frame){
+        return;
+    }
+
+    QPainter painter(this);
+    painter.drawImage(QRect(0, 0, this->width(), this->height()), frame->to_QImage_ref());
+
+    if (m_last_timestamp != frame.timestamp){
+        m_last_timestamp = frame.timestamp;
+        m_session.report_rendered_frame(current_time());
+    }
+}
+
+
+
+
+}
+}
@@ -0,0 +1,146 @@
+/*  Camera File Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A camera backend that replays recorded footage instead of reading
+ *  from a capture card. Sources are the folders and raw frame dumps inside
+ *  "UserFiles/ReplayFootage/". (see ReplayFrameSource.h)
+ *
+ *  This does not need any Qt multimedia support and can be constructed
+ *  directly without a UI to drive the inference pipeline from a benchmark.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_CameraFileReplay_H
+#define PokemonAutomation_VideoPipeline_CameraFileReplay_H
+
+#include <set>
+#include <mutex>
+#include <QTimer>
+#include "Common/Cpp/EventRateTracker.h"
+#include "Common/Cpp/LifetimeSanitizer.h"
+#include "CommonFramework/Tools/ReplayClock.h"
+#include "CommonFramework/VideoPipeline/CameraInfo.h"
+#include "CommonFramework/VideoPipeline/CameraSession.h"
+#include "CommonFramework/VideoPipeline/UI/VideoWidget.h"
+#include "ReplayFrameSource.h"
+#include "CameraImplementations.h"
+
+namespace PokemonAutomation{
+namespace CameraFileReplay{
+
+
+//  Folder that is scanned for replay sources.
+const std::string& REPLAY_FOOTAGE_PATH();
+
+
+class CameraBackend : public PokemonAutomation::CameraBackend{
+public:
+    CameraBackend(ReplayPacing pacing)
+        : m_pacing(pacing)
+    {}
+
+    virtual std::vector<CameraInfo> get_all_cameras() const override;
+    virtual std::string get_camera_name(const CameraInfo& info) const override;
+
+    virtual std::unique_ptr<PokemonAutomation::CameraSession> make_camera(Logger& logger, Resolution default_resolution) const override;
+
+private:
+    ReplayPacing m_pacing;
+};
+
+
+
+class CameraSession : public PokemonAutomation::CameraSession{
+public:
+    virtual void add_listener(Listener& listener) override;
+    virtual void remove_listener(Listener& listener) override;
+
+
+public:
+    virtual ~CameraSession();
+    CameraSession(Logger& logger, ReplayPacing pacing);
+
+    virtual void get(CameraOption& option) override;
+    virtual void set(const CameraOption& option) override;
+
+    virtual void reset() override;
+    virtual void set_source(CameraInfo device) override;
+    virtual void set_resolution(Resolution resolution) override;
+
+    virtual CameraInfo current_device() const override;
+    virtual Resolution current_resolution() const override;
+    virtual std::vector<Resolution> supported_resolutions() const override;
+
+    //  Serves the current recorded frame according to the pacing.
+    //  After the last frame, it keeps returning the last frame.
+    //  The widget calls this on every repaint. So in real time the display
+    //  keeps up with the clock even when no inference is pulling frames.
+    virtual VideoSnapshot snapshot() override;
+
+    //  AS_FAST_AS_POSSIBLE: Move on to the next frame. Call this once per
+    //  tick after every consumer has seen the current one.
+    void step();
+    virtual double fps_source() override;
+    virtual double fps_display() override;
+
+    //  Returns true once the last recorded frame has been served.
+    bool finished() const;
+
+    void report_rendered_frame(WallClock timestamp);
+
+    virtual VideoWidget* make_QtWidget(QWidget* parent) override;
+
+
+private:
+    void shutdown();
+    void startup();
+
+
+private:
+    Logger& m_logger;
+    const ReplayPacing m_pacing;
+
+    mutable std::mutex m_lock;
+
+    CameraInfo m_device;
+    std::unique_ptr<ReplayFrameSource> m_source;
+    std::unique_ptr<ReplayClock> m_clock;
+
+    size_t m_last_index;
+    VideoSnapshot m_last_snapshot;
+    bool m_finished;
+
+    EventRateTracker m_fps_tracker_source;
+    EventRateTracker m_fps_tracker_display;
+
+    std::set<Listener*> m_listeners;
+
+    LifetimeSanitizer m_sanitizer;
+};
+
+
+
+
+class VideoWidget : public PokemonAutomation::VideoWidget{
+public:
+    VideoWidget(QWidget* parent, CameraSession& session);
+
+    virtual PokemonAutomation::CameraSession& camera() override{ return m_session; }
+
+private:
+    virtual void paintEvent(QPaintEvent* event) override;
+
+private:
+    CameraSession& m_session;
+    QTimer m_refresh_timer;
+    WallClock m_last_timestamp;
+};
+
+
+
+
+
+}
+}
+#endif
@@ -7,6 +7,7 @@
 #include <QtGlobal>
 //#include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "CameraFileReplay.h"
 #include "CameraImplementations.h"
 
 //#include <iostream>
@@ -70,6 +71,12 @@ struct CameraBackends{
             std::make_unique<CameraQt65QMediaCaptureSession::CameraBackend>()
         );
 #endif
+        m_backends.emplace_back(
+            "file-replay-realtime", "File Replay: Real-time",
+            std::make_unique<CameraFileReplay::CameraBackend>(ReplayPacing::REAL_TIME)
+        );
+        //  As-fast-as-possible replays need something to step them. So only
+        //  InferencePivot_Benchmark uses them.
 
         size_t items = 0;
         for (const auto& item : m_backends){
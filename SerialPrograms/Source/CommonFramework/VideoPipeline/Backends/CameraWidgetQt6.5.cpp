@@ -21,6 +21,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/GlobalServices.h"
 #include "CommonFramework/VideoPipeline/CameraOption.h"
+#include "CommonFramework/VideoPipeline/VideoBurst.h"
 #include "MediaServicesQt6.h"
 #include "CameraWidgetQt6.5.h"
 
@@ -244,18 +245,72 @@ double CameraSession::fps_display(){
     return m_fps_tracker_display.events_per_second();
 }
 
+std::shared_ptr<VideoBurst> CameraSession::start_burst(
+    WallClock start, WallClock end,
+    const ImageFloatBox& box,
+    size_t capacity,
+    const ImageViewRGB32& size_hint
+){
+    auto burst = std::make_shared<VideoBurst>(start, end, box, capacity, size_hint);
+    std::lock_guard<std::mutex> lg0(m_lock);
+    if (m_camera == nullptr){
+        return nullptr;
+    }
+    WriteSpinLock lg1(m_frame_lock);
+    m_bursts.emplace_back(burst);
+    return burst;
+}
+void CameraSession::push_to_bursts(const QVideoFrame& frame, WallClock timestamp){
+    std::vector<std::shared_ptr<VideoBurst>> bursts;
+    {
+        ReadSpinLock lg(m_frame_lock);
+        bursts = m_bursts;
+    }
+
+    //  Every frame needs to be converted while a burst is active. So this
+    //  can't share the cached image with snapshot().
+    QImage image = frame.toImage();
+    QImage::Format format = image.format();
+    if (format != QImage::Format_ARGB32 && format != QImage::Format_RGB32){
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+    ImageViewRGB32 view(image);
+
+    bool finished = false;
+    for (const std::shared_ptr<VideoBurst>& burst : bursts){
+        finished |= !burst->push_frame(view, timestamp);
+    }
+    if (!finished){
+        return;
+    }
+
+    WriteSpinLock lg(m_frame_lock);
+    for (auto iter = m_bursts.begin(); iter != m_bursts.end();){
+        if (timestamp > (*iter)->end()){
+            iter = m_bursts.erase(iter);
+        }else{
+            ++iter;
+        }
+    }
+}
+
 void CameraSession::connect_video_sink(QVideoSink* sink){
 #if 1
     connect(
         sink, &QVideoSink::videoFrameChanged,
         this, [&](const QVideoFrame& frame){
+            WallClock now = current_time();
+            bool bursting;
             {
-                WallClock now = current_time();
                 WriteSpinLock lg(m_frame_lock);
                 m_last_frame = frame;
                 m_last_frame_timestamp = now;
                 m_last_frame_seqnum++;
                 m_fps_tracker_source.push_event(now);
+                bursting = !m_bursts.empty();
+            }
+            if (bursting){
+                push_to_bursts(frame, now);
             }
 //            cout << now_to_filestring() << endl;
             std::lock_guard<std::mutex> lg(m_lock);
@@ -317,6 +372,10 @@ void CameraSession::shutdown(){
     m_last_image_timestamp = m_last_frame_timestamp;
     m_last_image_seqnum = m_last_frame_seqnum;
 
+    for (const std::shared_ptr<VideoBurst>& burst : m_bursts){
+        burst->close();
+    }
+    m_bursts.clear();
 }
 void CameraSession::startup(){
     if (!m_device){
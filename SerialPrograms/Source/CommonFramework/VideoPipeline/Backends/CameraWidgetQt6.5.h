@@ -85,6 +85,13 @@ public:
     virtual double fps_source() override;
     virtual double fps_display() override;
 
+    virtual std::shared_ptr<VideoBurst> start_burst(
+        WallClock start, WallClock end,
+        const ImageFloatBox& box,
+        size_t capacity,
+        const ImageViewRGB32& size_hint
+    ) override;
+
     std::pair<QVideoFrame, uint64_t> latest_frame();
     void report_rendered_frame(WallClock timestamp);
 
@@ -97,6 +104,7 @@ private:
     void startup();
 
     void connect_video_sink(QVideoSink* sink);
+    void push_to_bursts(const QVideoFrame& frame, WallClock timestamp);
     void clear_video_output();
     void set_video_output(QVideoWidget& widget);
     void set_video_output(QGraphicsVideoItem& item);
@@ -141,6 +149,9 @@ private:
     uint64_t m_last_image_seqnum = 0;
     PeriodicStatsReporterI32 m_stats_conversion;
 
+    //  Active bursts. Protected by "m_frame_lock".
+    std::vector<std::shared_ptr<VideoBurst>> m_bursts;
+
     std::set<Listener*> m_ui_listeners;
     std::set<FrameListener*> m_frame_listeners;
 
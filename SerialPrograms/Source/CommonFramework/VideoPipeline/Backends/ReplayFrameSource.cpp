@@ -0,0 +1,180 @@
+/*  Replay Frame Source
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <QDir>
+#include <QFileInfo>
+#include "Common/Cpp/Exceptions.h"
+#include "ReplayFrameSource.h"
+
+namespace PokemonAutomation{
+
+
+const char RAW_FRAME_DUMP_MAGIC[8] = {'P', 'A', '-', 'R', 'G', 'B', '3', '2'};
+const double DEFAULT_IMAGE_SEQUENCE_FPS = 30;
+
+
+
+class ImageSequenceSource : public ReplayFrameSource{
+public:
+    ImageSequenceSource(const std::string& path)
+        : m_fps(DEFAULT_IMAGE_SEQUENCE_FPS)
+    {
+        QDir dir(QString::fromStdString(path));
+        QStringList files = dir.entryList(
+            QStringList() << "*.png" << "*.jpg" << "*.jpeg",
+            QDir::Files, QDir::Name
+        );
+        for (const QString& file : files){
+            m_files.emplace_back(dir.filePath(file).toStdString());
+        }
+        if (m_files.empty()){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "No images found in replay folder.", path);
+        }
+
+        std::ifstream fps_file(dir.filePath("fps.txt").toStdString());
+        double fps;
+        if (fps_file >> fps && fps > 0){
+            m_fps = fps;
+        }
+
+        ImageRGB32 first(m_files[0]);
+        if (!first){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to decode first frame.", m_files[0]);
+        }
+        m_resolution = Resolution(first.width(), first.height());
+    }
+
+    virtual size_t frames() const override{ return m_files.size(); }
+    virtual double fps() const override{ return m_fps; }
+    virtual Resolution resolution() const override{ return m_resolution; }
+
+    virtual ImageRGB32 load_frame(size_t index) override{
+        if (index >= m_files.size()){
+            return ImageRGB32();
+        }
+        return ImageRGB32(m_files[index]);
+    }
+
+private:
+    std::vector<std::string> m_files;
+    double m_fps;
+    Resolution m_resolution;
+};
+
+
+
+class RawFrameDumpSource : public ReplayFrameSource{
+public:
+    RawFrameDumpSource(const std::string& path)
+        : m_file(path, std::ios::binary)
+    {
+        if (!m_file){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open raw frame dump.", path);
+        }
+        RawFrameDumpHeader header;
+        if (!m_file.read((char*)&header, sizeof(header)) ||
+            memcmp(header.magic, RAW_FRAME_DUMP_MAGIC, sizeof(RAW_FRAME_DUMP_MAGIC)) != 0 ||
+            header.width == 0 || header.height == 0
+        ){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid raw frame dump header.", path);
+        }
+        m_resolution = Resolution(header.width, header.height);
+        m_fps = header.fps_x1000 == 0 ? DEFAULT_IMAGE_SEQUENCE_FPS : header.fps_x1000 / 1000.;
+        m_bytes_per_frame = (size_t)header.width * header.height * sizeof(uint32_t);
+
+        m_file.seekg(0, std::ios::end);
+        size_t bytes = (size_t)m_file.tellg() - sizeof(RawFrameDumpHeader);
+        m_frames = bytes / m_bytes_per_frame;
+        if (m_frames == 0){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Raw frame dump has no frames.", path);
+        }
+    }
+
+    virtual size_t frames() const override{ return m_frames; }
+    virtual double fps() const override{ return m_fps; }
+    virtual Resolution resolution() const override{ return m_resolution; }
+
+    virtual ImageRGB32 load_frame(size_t index) override{
+        if (index >= m_frames){
+            return ImageRGB32();
+        }
+        ImageRGB32 image(m_resolution.width, m_resolution.height);
+        m_file.seekg(sizeof(RawFrameDumpHeader) + index * m_bytes_per_frame);
+
+        //  Rows may be padded in memory.
+        size_t bytes_per_row = m_resolution.width * sizeof(uint32_t);
+        char* row = (char*)image.data();
+        for (size_t r = 0; r < m_resolution.height; r++){
+            if (!m_file.read(row, bytes_per_row)){
+                m_file.clear();
+                return ImageRGB32();
+            }
+            row += image.bytes_per_row();
+        }
+        return image;
+    }
+
+private:
+    std::ifstream m_file;
+    Resolution m_resolution;
+    double m_fps;
+    size_t m_bytes_per_frame;
+    size_t m_frames;
+};
+
+
+
+std::unique_ptr<ReplayFrameSource> open_replay_source(const std::string& path){
+    QFileInfo info(QString::fromStdString(path));
+    if (info.isDir()){
+        return std::make_unique<ImageSequenceSource>(path);
+    }
+    if (info.isFile() && info.fileName().endsWith(QString::fromStdString(RAW_FRAME_DUMP_EXTENSION))){
+        return std::make_unique<RawFrameDumpSource>(path);
+    }
+    throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unrecognized replay source.", path);
+}
+
+
+
+RawFrameDumpWriter::RawFrameDumpWriter(const std::string& path, Resolution resolution, double fps)
+    : m_path(path)
+    , m_resolution(resolution)
+    , m_file(path, std::ios::binary | std::ios::trunc)
+{
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create raw frame dump.", path);
+    }
+    RawFrameDumpHeader header;
+    memcpy(header.magic, RAW_FRAME_DUMP_MAGIC, sizeof(RAW_FRAME_DUMP_MAGIC));
+    header.width = (uint32_t)resolution.width;
+    header.height = (uint32_t)resolution.height;
+    header.fps_x1000 = (uint32_t)(fps * 1000);
+    header.reserved = 0;
+    m_file.write((const char*)&header, sizeof(header));
+}
+bool RawFrameDumpWriter::append(const ImageViewRGB32& frame){
+    if (frame.width() != m_resolution.width || frame.height() != m_resolution.height){
+        return false;
+    }
+    size_t bytes_per_row = m_resolution.width * sizeof(uint32_t);
+    const char* row = (const char*)frame.data();
+    for (size_t r = 0; r < m_resolution.height; r++){
+        m_file.write(row, bytes_per_row);
+        row += frame.bytes_per_row();
+    }
+    if (!m_file){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Failed to write frame.", m_path);
+    }
+    return true;
+}
+
+
+
+}
@@ -0,0 +1,78 @@
+/*  Replay Frame Source
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Random access to recorded video frames for the file replay camera.
+ *
+ *  Two formats are supported:
+ *
+ *    - Image sequence: A folder of .png/.jpg files played in filename order.
+ *      An optional "fps.txt" in the folder holds the frame rate. (default 30)
+ *
+ *    - Raw frame dump: A single ".rgb32" file with a RawFrameDumpHeader
+ *      followed by tightly packed 32-bit ARGB frames. This avoids decoding
+ *      entirely and is the fastest format to replay.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_ReplayFrameSource_H
+#define PokemonAutomation_VideoPipeline_ReplayFrameSource_H
+
+#include <memory>
+#include <string>
+#include <fstream>
+#include "Common/Cpp/ImageResolution.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+const std::string RAW_FRAME_DUMP_EXTENSION = ".rgb32";
+
+
+struct RawFrameDumpHeader{
+    char magic[8];          //  "PA-RGB32"
+    uint32_t width;
+    uint32_t height;
+    uint32_t fps_x1000;     //  Frame rate in milli-frames/second.
+    uint32_t reserved;
+};
+
+
+
+class ReplayFrameSource{
+public:
+    virtual ~ReplayFrameSource() = default;
+
+    virtual size_t frames() const = 0;
+    virtual double fps() const = 0;
+    virtual Resolution resolution() const = 0;
+
+    //  Decode the specified frame. Returns an empty image on failure.
+    virtual ImageRGB32 load_frame(size_t index) = 0;
+};
+
+//  Open the specified folder (image sequence) or ".rgb32" file (raw dump).
+//  Throws FileException if the source cannot be opened.
+std::unique_ptr<ReplayFrameSource> open_replay_source(const std::string& path);
+
+
+
+//  Record frames into a raw frame dump that can be replayed later.
+class RawFrameDumpWriter{
+public:
+    RawFrameDumpWriter(const std::string& path, Resolution resolution, double fps);
+
+    //  Frames with a different resolution are rejected.
+    bool append(const ImageViewRGB32& frame);
+
+private:
+    std::string m_path;
+    Resolution m_resolution;
+    std::ofstream m_file;
+};
+
+
+
+}
+#endif
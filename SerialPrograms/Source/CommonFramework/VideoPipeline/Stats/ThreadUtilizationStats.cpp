@@ -15,16 +15,19 @@ namespace PokemonAutomation{
 
 
 ThreadUtilizationStat::ThreadUtilizationStat(ThreadHandle handle, std::string label)
-    : m_handle(handle)
+    : ThreadUtilizationStat([handle]{ return thread_cpu_time(handle); }, std::move(label))
+{}
+ThreadUtilizationStat::ThreadUtilizationStat(std::function<WallClock::duration()> clock, std::string label)
+    : m_clock(std::move(clock))
     , m_label(std::move(label))
-    , m_last_clock(thread_cpu_time(handle))
+    , m_last_clock(m_clock())
 {}
 
 OverlayStatSnapshot ThreadUtilizationStat::get_current(){
     std::lock_guard<std::mutex> lg(m_lock);
 
     WallClock now = current_time();
-    WallClock::duration clock = thread_cpu_time(m_handle);
+    WallClock::duration clock = m_clock();
     if (clock == WallClock::duration::min()){
         return OverlayStatSnapshot{m_label + " ---"};
     }
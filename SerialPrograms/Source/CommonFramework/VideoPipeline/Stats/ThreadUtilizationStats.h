@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_ThreadUtilizationStats_H
 #define PokemonAutomation_ThreadUtilizationStats_H
 
+#include <functional>
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/EventRateTracker.h"
 #include "CommonFramework/Environment/Environment.h"
@@ -19,10 +20,14 @@ class ThreadUtilizationStat : public OverlayStat{
 public:
     ThreadUtilizationStat(ThreadHandle handle, std::string label);
 
+    //  Use any source of cumulative busy time instead of a thread's CPU time.
+    //  "clock" returns WallClock::duration::min() if it isn't available.
+    ThreadUtilizationStat(std::function<WallClock::duration()> clock, std::string label);
+
     virtual OverlayStatSnapshot get_current() override;
 
 private:
-    ThreadHandle m_handle;
+    std::function<WallClock::duration()> m_clock;
     std::string m_label;
 
     std::mutex m_lock;
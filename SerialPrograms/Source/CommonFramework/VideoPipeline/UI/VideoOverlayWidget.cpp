@@ -31,10 +31,6 @@ VideoOverlayWidget::~VideoOverlayWidget(){
 VideoOverlayWidget::VideoOverlayWidget(QWidget& parent, VideoOverlaySession& session)
     : QWidget(&parent)
     , m_session(session)
-    , m_boxes(std::make_shared<std::vector<OverlayBox>>(session.boxes()))
-    , m_texts(std::make_shared<std::vector<OverlayText>>(session.texts()))
-    , m_log(std::make_shared<std::vector<OverlayLogLine>>(session.log_texts()))
-    , m_stats(nullptr)
 {
     setAttribute(Qt::WA_NoSystemBackground);
     setAttribute(Qt::WA_TranslucentBackground);
@@ -63,29 +59,6 @@ void VideoOverlayWidget::enabled_stats(bool enabled){
     QMetaObject::invokeMethod(this, [this]{ this->update(); });
 }
 
-void VideoOverlayWidget::update_boxes(const std::shared_ptr<const std::vector<OverlayBox>>& boxes){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_boxes()");
-    m_boxes = boxes;
-}
-void VideoOverlayWidget::update_text(const std::shared_ptr<const std::vector<OverlayText>>& texts){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_text()");
-    m_texts = texts;
-}
-void VideoOverlayWidget::update_log(const std::shared_ptr<const std::vector<OverlayLogLine>>& texts){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_log_text()");
-    m_log = texts;
-}
-#if 0
-void VideoOverlayWidget::update_log_background(const std::shared_ptr<const std::vector<VideoOverlaySession::Box>>& bg_boxes){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_log_background()");
-    m_log_text_bg_boxes = bg_boxes;
-}
-#endif
-void VideoOverlayWidget::update_stats(const std::list<OverlayStat*>* stats){
-    WriteSpinLock lg(m_lock, "VideoOverlay::update_stats()");
-    m_stats = stats;
-}
-
 void VideoOverlayWidget::on_watchdog_timeout(){
     QMetaObject::invokeMethod(this, [this]{ this->update(); });
 //    static int c = 0;
@@ -96,31 +69,30 @@ void VideoOverlayWidget::resizeEvent(QResizeEvent* event){}
 void VideoOverlayWidget::paintEvent(QPaintEvent*){
     QPainter painter(this);
 
-    {
-        WriteSpinLock lg(m_lock, "VideoOverlay::paintEvent()");
+    //  Every change since the last paint is picked up here at once.
+    std::shared_ptr<const VideoOverlaySnapshot> snapshot = m_session.snapshot();
 
-        if (m_session.enabled_boxes()){
-            update_boxes(painter);
-        }
-        if (m_session.enabled_text()){
-            update_text(painter);
-        }
-        if (m_session.enabled_log()){
-            update_log(painter);
-        }
-        if (m_session.enabled_stats() && m_stats){
-            update_stats(painter);
-        }
+    if (m_session.enabled_boxes()){
+        update_boxes(painter, snapshot->boxes);
+    }
+    if (m_session.enabled_text()){
+        update_text(painter, snapshot->texts);
+    }
+    if (m_session.enabled_log()){
+        update_log(painter, snapshot->log);
+    }
+    if (m_session.enabled_stats()){
+        update_stats(painter, m_session.stats());
     }
 
     global_watchdog().delay(*this);
 }
 
 
-void VideoOverlayWidget::update_boxes(QPainter& painter){
+void VideoOverlayWidget::update_boxes(QPainter& painter, const std::vector<OverlayBox>& boxes){
     int width = this->width();
     int height = this->height();
-    for (const auto& item : *m_boxes){
+    for (const auto& item : boxes){
         QColor color = QColor((uint32_t)item.color);
         painter.setPen(color);
 //        cout << box->x << " " << box->y << ", " << box->width << " x " << box->height << endl;
@@ -195,10 +167,10 @@ void VideoOverlayWidget::update_boxes(QPainter& painter){
         painter.drawText(QPoint(xmin + padding_width, ymin - 2*padding_height), text);
     }
 }
-void VideoOverlayWidget::update_text(QPainter& painter){
+void VideoOverlayWidget::update_text(QPainter& painter, const std::vector<OverlayText>& texts){
     int width = this->width();
     int height = this->height();
-    for (const auto& item: *m_texts){
+    for (const auto& item: texts){
         painter.setPen(QColor((uint32_t)item.color));
         QFont text_font = this->font();
         text_font.setPointSizeF(item.font_size * height / 100.0);
@@ -210,8 +182,8 @@ void VideoOverlayWidget::update_text(QPainter& painter){
         painter.drawText(QPoint(xmin, ymin), QString::fromStdString(item.message));
     }
 }
-void VideoOverlayWidget::update_log(QPainter& painter){
-    if (m_log->empty()){
+void VideoOverlayWidget::update_log(QPainter& painter, const std::vector<OverlayLogLine>& log){
+    if (log.empty()){
         return;
     }
 
@@ -242,7 +214,7 @@ void VideoOverlayWidget::update_log(QPainter& painter){
     //  Draw the text lines.
     double x = LOG_MIN_X + LOG_BORDER_X;
     double y = LOG_MAX_Y - LOG_BORDER_Y;
-    for (const OverlayLogLine& item: *m_log){
+    for (const OverlayLogLine& item: log){
         painter.setPen(QColor((uint32_t)item.color));
         QFont text_font = this->font();
         text_font.setPointSizeF(height * LOG_FONT_SIZE);
@@ -256,7 +228,7 @@ void VideoOverlayWidget::update_log(QPainter& painter){
         y -= LOG_LINE_SPACING;
     }
 }
-void VideoOverlayWidget::update_stats(QPainter& painter){
+void VideoOverlayWidget::update_stats(QPainter& painter, const std::vector<OverlayStatSnapshot>& stats){
     const double TEXT_SIZE = 0.02;
     const double ROW_HEIGHT = 0.03;
 
@@ -267,11 +239,10 @@ void VideoOverlayWidget::update_stats(QPainter& painter){
     int height = this->height();
     int start_x = (int)(width * 0.75);
 
-    std::vector<OverlayStatSnapshot> lines;
-    for (const auto& stat : *m_stats){
-        OverlayStatSnapshot snapshot = stat->get_current();
-        if (!snapshot.text.empty()){
-            lines.emplace_back(std::move(snapshot));
+    std::vector<const OverlayStatSnapshot*> lines;
+    for (const OverlayStatSnapshot& stat : stats){
+        if (!stat.text.empty()){
+            lines.emplace_back(&stat);
         }
     }
 
@@ -285,8 +256,8 @@ void VideoOverlayWidget::update_stats(QPainter& painter){
     );
 
     size_t c = 0;
-    for (const auto& stat : lines){
-        painter.setPen(QColor((uint32_t)stat.color));
+    for (const OverlayStatSnapshot* stat : lines){
+        painter.setPen(QColor((uint32_t)stat->color));
 
         QFont text_font = this->font();
         text_font.setPointSizeF(height * TEXT_SIZE);
@@ -295,7 +266,7 @@ void VideoOverlayWidget::update_stats(QPainter& painter){
         int x = start_x + width * 0.01;
         int y = height * ((c + 1) * ROW_HEIGHT + 0.005);
 
-        painter.drawText(QPoint(x, y), QString::fromStdString(stat.text));
+        painter.drawText(QPoint(x, y), QString::fromStdString(stat->text));
 
         c++;
     }
@@ -7,9 +7,8 @@
 #ifndef PokemonAutomation_VideoPipeline_VideoOverlayWidget_H
 #define PokemonAutomation_VideoPipeline_VideoOverlayWidget_H
 
-#include <map>
+#include <vector>
 #include <QWidget>
-#include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/Watchdog.h"
 #include "CommonFramework/VideoPipeline/VideoOverlaySession.h"
 
@@ -38,30 +37,19 @@ private:
     virtual void enabled_log  (bool enabled) override;
     virtual void enabled_stats(bool enabled) override;
 
-    virtual void update_boxes(const std::shared_ptr<const std::vector<OverlayBox>>& boxes) override;
-    virtual void update_text (const std::shared_ptr<const std::vector<OverlayText>>& texts) override;
-    virtual void update_log  (const std::shared_ptr<const std::vector<OverlayLogLine>>& texts) override;
-    virtual void update_stats(const std::list<OverlayStat*>* stats) override;
-
     virtual void on_watchdog_timeout() override;
 
     virtual void resizeEvent(QResizeEvent* event) override;
     virtual void paintEvent(QPaintEvent*) override;
 
 private:
-    void update_boxes(QPainter& painter);
-    void update_text (QPainter& painter);
-    void update_log  (QPainter& painter);
-    void update_stats(QPainter& painter);
+    void update_boxes(QPainter& painter, const std::vector<OverlayBox>& boxes);
+    void update_text (QPainter& painter, const std::vector<OverlayText>& texts);
+    void update_log  (QPainter& painter, const std::vector<OverlayLogLine>& log);
+    void update_stats(QPainter& painter, const std::vector<OverlayStatSnapshot>& stats);
 
 private:
     VideoOverlaySession& m_session;
-
-    SpinLock m_lock;
-    std::shared_ptr<const std::vector<OverlayBox>> m_boxes;
-    std::shared_ptr<const std::vector<OverlayText>> m_texts;
-    std::shared_ptr<const std::vector<OverlayLogLine>> m_log;
-    const std::list<OverlayStat*>* m_stats;
 };
 
 
@@ -0,0 +1,138 @@
+/*  Video Burst
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/Exceptions.h"
+#include "VideoBurst.h"
+
+namespace PokemonAutomation{
+
+
+VideoBurst::VideoBurst(
+    WallClock start, WallClock end,
+    const ImageFloatBox& box,
+    size_t capacity,
+    const ImageViewRGB32& size_hint
+)
+    : m_start(start)
+    , m_end(end)
+    , m_box(box)
+    , m_slots(capacity)
+{
+    if (capacity == 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "VideoBurst needs a capacity of at least 1.");
+    }
+    if (!size_hint){
+        return;
+    }
+    ImageViewRGB32 cropped = extract_box_reference(size_hint, m_box);
+    for (Slot& slot : m_slots){
+        slot.image = ImageRGB32(cropped.width(), cropped.height());
+    }
+}
+
+size_t VideoBurst::frames() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_tail;
+}
+size_t VideoBurst::dropped() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_dropped;
+}
+
+
+bool VideoBurst::push_frame(const ImageViewRGB32& frame, WallClock timestamp){
+    if (!frame){
+        return true;
+    }
+
+    ImageViewRGB32 cropped = extract_box_reference(frame, m_box);
+    const size_t width = cropped.width();
+    const size_t height = cropped.height();
+
+    size_t index;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_closed){
+            return false;
+        }
+        if (timestamp > m_end){
+            m_closed = true;
+            m_cv.notify_all();
+            return false;
+        }
+        if (timestamp < m_start){
+            //  Use the frames before the window to allocate the ring so that
+            //  nothing needs to be allocated once it starts.
+            //  Nothing is being read yet so every slot is free.
+            for (Slot& slot : m_slots){
+                if (slot.image.width() != width || slot.image.height() != height){
+                    slot.image = ImageRGB32(width, height);
+                }
+            }
+            return true;
+        }
+        size_t used = m_tail - m_head + (m_reading ? 1 : 0);
+        if (used >= m_slots.size()){
+            m_dropped++;
+            return true;
+        }
+        index = m_tail % m_slots.size();
+    }
+
+    //  There is only one writer and the reader doesn't touch this slot until
+    //  it's published below. So it's safe to copy without the lock.
+    Slot& slot = m_slots[index];
+    if (slot.image.width() != width || slot.image.height() != height){
+        slot.image = ImageRGB32(width, height);
+    }
+    const char* src = (const char*)cropped.data();
+    char* dst = (char*)slot.image.data();
+    for (size_t r = 0; r < height; r++){
+        memcpy(dst, src, width * sizeof(uint32_t));
+        src += cropped.bytes_per_row();
+        dst += slot.image.bytes_per_row();
+    }
+    slot.timestamp = timestamp;
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_tail++;
+    m_cv.notify_all();
+    return true;
+}
+void VideoBurst::close(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_closed = true;
+    m_cv.notify_all();
+}
+
+
+bool VideoBurst::next_frame(ImageViewRGB32& frame, WallClock& timestamp){
+    std::unique_lock<std::mutex> lg(m_lock);
+
+    //  Release the previous frame.
+    m_reading = false;
+
+    m_cv.wait_until(lg, m_end + LATE_FRAME_TIMEOUT, [this]{
+        return m_closed || m_head < m_tail;
+    });
+    if (m_head == m_tail){
+        m_closed = true;
+        frame = ImageViewRGB32();
+        return false;
+    }
+
+    const Slot& slot = m_slots[m_head % m_slots.size()];
+    frame = slot.image;
+    timestamp = slot.timestamp;
+    m_head++;
+    m_reading = true;
+    return true;
+}
+
+
+
+}
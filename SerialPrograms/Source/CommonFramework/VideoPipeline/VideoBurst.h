@@ -0,0 +1,108 @@
+/*  Video Burst
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Every frame from the video source over a short time window.
+ *
+ *  Inference normally samples the video with VideoFeed::snapshot() at a fixed
+ *  period. An event that only lasts a few frames can fall between two samples.
+ *  Instead of raising the sampling rate for the whole program, a detector can
+ *  start a burst for just the window where it expects the event.
+ *
+ *  The video backend copies every new frame in the window (cropped to the
+ *  requested box) into a ring of preallocated images. The detector reads them
+ *  in order. If the detector falls behind and the ring fills up, new frames
+ *  are dropped and counted.
+ *
+ *  The ring is allocated up front if the caller passes a frame of the right
+ *  size (usually its last snapshot). Otherwise it's sized from the frames that
+ *  arrive before the window opens.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoBurst_H
+#define PokemonAutomation_VideoPipeline_VideoBurst_H
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+
+class VideoBurst{
+public:
+    //  If no frame arrives for this long after the window ends, assume the
+    //  backend has stopped and end the burst.
+    static constexpr std::chrono::milliseconds LATE_FRAME_TIMEOUT = std::chrono::milliseconds(500);
+
+public:
+    //  If "size_hint" is not empty, allocate the ring for the crop of a frame
+    //  of the same size.
+    VideoBurst(
+        WallClock start, WallClock end,
+        const ImageFloatBox& box,
+        size_t capacity,
+        const ImageViewRGB32& size_hint
+    );
+
+    WallClock start() const{ return m_start; }
+    WallClock end() const{ return m_end; }
+    const ImageFloatBox& box() const{ return m_box; }
+    size_t capacity() const{ return m_slots.size(); }
+
+    //  # of frames pushed into the ring so far.
+    size_t frames() const;
+    //  # of frames in the window that were dropped because the ring was full.
+    size_t dropped() const;
+
+
+public:
+    //  Called by the video backend for every new frame.
+    //  Frames before the window are ignored. Returns false once the frame is
+    //  past the window. The burst is then closed and the backend can forget it.
+    bool push_frame(const ImageViewRGB32& frame, WallClock timestamp);
+
+    //  Called by the video backend if it stops before the window ends.
+    void close();
+
+
+public:
+    //  Wait for the next frame in order.
+    //  "frame" points into the ring and stays valid until the next call.
+    //  Returns false when the burst is over and every frame has been read.
+    bool next_frame(ImageViewRGB32& frame, WallClock& timestamp);
+
+
+private:
+    struct Slot{
+        ImageRGB32 image;
+        WallClock timestamp;
+    };
+
+    const WallClock m_start;
+    const WallClock m_end;
+    const ImageFloatBox m_box;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+
+    std::vector<Slot> m_slots;
+
+    //  Total # of frames written and read. Slot index is modulo capacity.
+    //  The slot at "m_head - 1" is still held by the reader.
+    size_t m_head = 0;
+    size_t m_tail = 0;
+    bool m_reading = false;
+
+    size_t m_dropped = 0;
+    bool m_closed = false;
+};
+
+
+
+}
+#endif
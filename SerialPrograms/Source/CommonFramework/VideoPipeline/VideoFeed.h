@@ -10,9 +10,12 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 
 namespace PokemonAutomation{
 
+class VideoBurst;
+
 
 struct VideoSnapshot{
     //  The frame itself. Null means no snapshot was available.
@@ -62,6 +65,21 @@ public:
     //  Use this for diagnostic purposes.
     virtual double fps_source() = 0;
     virtual double fps_display() = 0;
+
+    //  Capture every frame from "start" to "end" cropped to "box". Up to
+    //  "capacity" frames are buffered for the caller to read.
+    //  Pass a recent snapshot as "size_hint" so the buffers can be allocated
+    //  before the window opens.
+    //  Returns null if the video source doesn't support it. Callers should
+    //  then fall back to snapshot().
+    virtual std::shared_ptr<VideoBurst> start_burst(
+        WallClock start, WallClock end,
+        const ImageFloatBox& box,
+        size_t capacity,
+        const ImageViewRGB32& size_hint
+    ){
+        return nullptr;
+    }
 };
 
 
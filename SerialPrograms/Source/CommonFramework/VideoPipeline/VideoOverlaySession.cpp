@@ -4,6 +4,8 @@
  *
  */
 
+#include <thread>
+#include "Common/Cpp/Concurrency/SpinPause.h"
 #include "VideoOverlaySession.h"
 
 //#include <iostream>
@@ -24,14 +26,11 @@ void VideoOverlaySession::remove_listener(Listener& listener){
 }
 
 
-VideoOverlaySession::~VideoOverlaySession(){
-    ReadSpinLock lg(m_lock);
-    for (Listener* listeners : m_listeners){
-        listeners->update_stats(nullptr);
-    }
-}
 VideoOverlaySession::VideoOverlaySession(VideoOverlayOption& option)
     : m_option(option)
+    , m_dirty(false)
+    , m_copying(false)
+    , m_snapshot(std::make_shared<VideoOverlaySnapshot>())
 {}
 
 
@@ -95,77 +94,57 @@ void VideoOverlaySession::set_enabled_stats(bool enabled){
 
 
 
+//  The writers below only mark the state dirty. snapshot() does the copy.
+
+void VideoOverlaySession::wait_for_copy() const{
+    //  Yield after a while so the reader can run if it shares a core.
+    size_t spins = 0;
+    while (m_copying.load(std::memory_order_acquire)){
+        if (++spins < 64){
+            pause();
+        }else{
+            std::this_thread::yield();
+        }
+    }
+}
+
 void VideoOverlaySession::add_box(const OverlayBox& box){
+    OverlayBox copy = box;
+    wait_for_copy();
     WriteSpinLock lg(m_lock, "VideoOverlaySession::add_box()");
-    m_boxes.insert(&box);
-    push_box_update();
+    m_boxes.insert_or_assign(&box, std::move(copy));
+    m_dirty.store(true, std::memory_order_relaxed);
 }
 void VideoOverlaySession::remove_box(const OverlayBox& box){
+    //  Declared before the lock so the box is freed after it's released.
+    std::map<const OverlayBox*, OverlayBox>::node_type node;
+    wait_for_copy();
     WriteSpinLock lg(m_lock, "VideoOverlaySession::remove_box()");
-    m_boxes.erase(&box);
-    push_box_update();
-}
-
-void VideoOverlaySession::push_box_update(){
-    if (m_listeners.empty()){
-        return;
-    }
-    
-    // We create a newly allocated Box vector to avoid listeners accessing `m_boxes` asynchronously.
-    std::shared_ptr<std::vector<OverlayBox>> ptr = std::make_shared<std::vector<OverlayBox>>();
-    for (const auto& item : m_boxes){
-        ptr->emplace_back(*item);
-    }
-    for (Listener* listeners : m_listeners){
-        listeners->update_boxes(ptr);
-    }
-}
-
-std::vector<OverlayBox> VideoOverlaySession::boxes() const{
-    ReadSpinLock lg(m_lock);
-    std::vector<OverlayBox> ret;
-    for (const auto& item : m_boxes){
-        ret.emplace_back(*item);
+    node = m_boxes.extract(&box);
+    if (node){
+        m_dirty.store(true, std::memory_order_relaxed);
     }
-    return ret;
 }
 
 void VideoOverlaySession::add_text(const OverlayText& text){
+    OverlayText copy = text;
+    wait_for_copy();
     WriteSpinLock lg(m_lock, "VideoOverlaySession::add_text()");
-    m_texts.insert(&text);
-    push_text_update();
+    m_texts.insert_or_assign(&text, std::move(copy));
+    m_dirty.store(true, std::memory_order_relaxed);
 }
 void VideoOverlaySession::remove_text(const OverlayText& text){
+    std::map<const OverlayText*, OverlayText>::node_type node;
+    wait_for_copy();
     WriteSpinLock lg(m_lock, "VideoOverlaySession::remove_text()");
-    m_texts.erase(&text);
-    push_text_update();
-}
-
-void VideoOverlaySession::push_text_update(){
-    if (m_listeners.empty()){
-        return;
-    }
-
-    // We create a newly allocated Box vector to avoid listeners accessing `m_texts` asynchronously.
-    std::shared_ptr<std::vector<OverlayText>> ptr = std::make_shared<std::vector<OverlayText>>();
-    for (const auto& item : m_texts){
-        ptr->emplace_back(*item);
-    }
-    for (Listener* listeners : m_listeners){
-        listeners->update_text(ptr);
-    }
-}
-
-std::vector<OverlayText> VideoOverlaySession::texts() const{
-    ReadSpinLock lg(m_lock);
-    std::vector<OverlayText> ret;
-    for (const auto& item : m_texts){
-        ret.emplace_back(*item);
+    node = m_texts.extract(&text);
+    if (node){
+        m_dirty.store(true, std::memory_order_relaxed);
     }
-    return ret;
 }
 
 void VideoOverlaySession::add_log(std::string message, Color color){
+    wait_for_copy();
     WriteSpinLock lg(m_lock, "VideoOverlaySession::add_log_text()");
     m_log_texts.emplace_front(color, std::move(message));
 
@@ -173,54 +152,90 @@ void VideoOverlaySession::add_log(std::string message, Color color){
         m_log_texts.pop_back();
     }
 
-    push_log_text_update();
+    m_dirty.store(true, std::memory_order_relaxed);
 }
 
 void VideoOverlaySession::clear_log(){
+    wait_for_copy();
     WriteSpinLock lg(m_lock, "VideoOverlaySession::clear_log_texts()");
-    m_log_texts.clear();
-    push_log_text_update();
+    if (!m_log_texts.empty()){
+        m_log_texts.clear();
+        m_dirty.store(true, std::memory_order_relaxed);
+    }
 }
 
-void VideoOverlaySession::push_log_text_update(){
-    if (m_listeners.empty()){
-        return;
+
+
+std::shared_ptr<const VideoOverlaySnapshot> VideoOverlaySession::snapshot() const{
+    if (!m_dirty.load(std::memory_order_relaxed)){
+        ReadSpinLock lg(m_snapshot_lock, "VideoOverlaySession::snapshot()");
+        return m_snapshot;
     }
-    
-    // We create a newly allocated Box vector to avoid listeners accessing `m_log_texts` asynchronously.
-    std::shared_ptr<std::vector<OverlayLogLine>> ptr = std::make_shared<std::vector<OverlayLogLine>>();
-    for(const auto& item : m_log_texts){
-        ptr->emplace_back(item);
+
+    std::lock_guard<std::mutex> lg0(m_build_lock);
+    std::shared_ptr<const VideoOverlaySnapshot> old;
+    {
+        ReadSpinLock lg(m_snapshot_lock, "VideoOverlaySession::snapshot()");
+        old = m_snapshot;
     }
-    for (Listener* listeners : m_listeners){
-        listeners->update_log(ptr);
+
+    //  Another reader built it while we were waiting.
+    if (!m_dirty.load(std::memory_order_relaxed)){
+        return old;
+    }
+
+    std::shared_ptr<VideoOverlaySnapshot> ptr = std::make_shared<VideoOverlaySnapshot>();
+    ptr->version = old->version + 1;
+    {
+        //  Writers only wait for the copy. Any write after this marks the
+        //  state dirty again.
+        m_copying.store(true, std::memory_order_release);
+        ReadSpinLock lg(m_lock, "VideoOverlaySession::snapshot()");
+        try{
+            ptr->boxes.reserve(m_boxes.size());
+            for (const auto& item : m_boxes){
+                ptr->boxes.emplace_back(item.second);
+            }
+            ptr->texts.reserve(m_texts.size());
+            for (const auto& item : m_texts){
+                ptr->texts.emplace_back(item.second);
+            }
+            ptr->log.assign(m_log_texts.begin(), m_log_texts.end());
+        }catch (...){
+            m_copying.store(false, std::memory_order_release);
+            throw;
+        }
+        m_dirty.store(false, std::memory_order_relaxed);
+        m_copying.store(false, std::memory_order_release);
+    }
+
+    {
+        WriteSpinLock lg(m_snapshot_lock, "VideoOverlaySession::snapshot()");
+        m_snapshot = ptr;
     }
+    return ptr;
 }
 
+std::vector<OverlayBox> VideoOverlaySession::boxes() const{
+    return snapshot()->boxes;
+}
+std::vector<OverlayText> VideoOverlaySession::texts() const{
+    return snapshot()->texts;
+}
 std::vector<OverlayLogLine> VideoOverlaySession::log_texts() const{
-    ReadSpinLock lg(m_lock);
-    std::vector<OverlayLogLine> ret;
-    for(const auto& item : m_log_texts){
-        ret.emplace_back(item);
-    }
-    return ret;
+    return snapshot()->log;
 }
 
 
 
 
 void VideoOverlaySession::add_stat(OverlayStat& stat){
-    WriteSpinLock lg(m_lock);
+    WriteSpinLock lg(m_stats_lock);
     auto map_iter = m_stats.find(&stat);
     if (map_iter != m_stats.end()){
         return;
     }
 
-    //  Remove all stats so they aren't being referenced.
-    for (Listener* listeners : m_listeners){
-        listeners->update_stats(nullptr);
-    }
-
     m_stats_order.emplace_back(&stat);
     auto list_iter = m_stats_order.end();
     --list_iter;
@@ -230,31 +245,32 @@ void VideoOverlaySession::add_stat(OverlayStat& stat){
         m_stats_order.pop_back();
         throw;
     }
-
-    //  Add all the stats back.
-    for (Listener* listeners : m_listeners){
-        listeners->update_stats(&m_stats_order);
-    }
 }
 void VideoOverlaySession::remove_stat(OverlayStat& stat){
-    WriteSpinLock lg(m_lock);
+    std::lock_guard<std::mutex> lg0(m_stats_read_lock);
+    WriteSpinLock lg(m_stats_lock);
     auto iter = m_stats.find(&stat);
     if (iter == m_stats.end()){
         return;
     }
 
-    //  Remove all stats so they aren't being referenced.
-    for (Listener* listeners : m_listeners){
-        listeners->update_stats(nullptr);
-    }
-
     m_stats_order.erase(iter->second);
     m_stats.erase(iter);
-
-    //  Add all the stats back.
-    for (Listener* listeners : m_listeners){
-        listeners->update_stats(&m_stats_order);
+}
+std::vector<OverlayStatSnapshot> VideoOverlaySession::stats() const{
+    //  get_current() can take a while. Don't call it with the spin lock held.
+    std::lock_guard<std::mutex> lg0(m_stats_read_lock);
+    std::vector<OverlayStat*> stats;
+    {
+        ReadSpinLock lg(m_stats_lock, "VideoOverlaySession::stats()");
+        stats.assign(m_stats_order.begin(), m_stats_order.end());
+    }
+    std::vector<OverlayStatSnapshot> ret;
+    ret.reserve(stats.size());
+    for (OverlayStat* stat : stats){
+        ret.emplace_back(stat->get_current());
     }
+    return ret;
 }
 
 
@@ -5,8 +5,15 @@
  *  This class holds the real-time state of the video overlays. You can
  *  asychronously add/remove objects to it.
  *
- *  This class is not responsible for any UI. However, any changes made to this
- *  class will be forwarded to any UI components that are attached to it.
+ *  This class is not responsible for any UI. UI components pull the latest
+ *  state with snapshot() whenever they repaint.
+ *
+ *  Inference threads add and remove boxes and log lines every frame while the
+ *  UI repaints. A write only changes the state and marks it dirty. The next
+ *  snapshot() builds an immutable copy and publishes it by swapping a
+ *  shared_ptr. Until something changes again, readers only copy that pointer.
+ *  So at most one snapshot is built per repaint no matter how often the
+ *  detectors write.
  *
  */
 
@@ -19,6 +26,8 @@
 #include <set>
 #include <map>
 #include <deque>
+#include <atomic>
+#include <mutex>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
@@ -28,10 +37,21 @@
 
 namespace PokemonAutomation{
 
+
+//  An immutable copy of the overlays at one point in time.
+struct VideoOverlaySnapshot{
+    //  Goes up by one for every snapshot built.
+    uint64_t version = 0;
+    std::vector<OverlayBox> boxes;
+    std::vector<OverlayText> texts;
+    std::vector<OverlayLogLine> log;
+};
+
+
 //  This class holds the real-time state of the video overlays. You can
 //  asychronously add/remove objects to it.
-//  This class is not responsible for any UI. However, any changes made to this
-//  class will be forwarded to any UI components that are attached to it.
+//  This class is not responsible for any UI. UI components pull the latest
+//  state with snapshot() whenever they repaint.
 class VideoOverlaySession : public VideoOverlay{
 public:
     static constexpr size_t LOG_MAX_LINES = 20;
@@ -47,17 +67,8 @@ public:
         virtual void enabled_log  (bool enabled){}
         virtual void enabled_stats(bool enabled){}
 
-        virtual void update_boxes(const std::shared_ptr<const std::vector<OverlayBox>>& boxes){}
-        virtual void update_text (const std::shared_ptr<const std::vector<OverlayText>>& texts){}
-        virtual void update_log  (const std::shared_ptr<const std::vector<OverlayLogLine>>& boxes){}
-
-        //  This one is different from the others. The listeners will store this
-        //  pointer and access it directly and asynchronously. If you need to
-        //  change the structure of the list itself, you must first call this
-        //  with null to remove it from all the listeners. Then add the updated
-        //  one back when you're done.
-        virtual void update_stats(const std::list<OverlayStat*>* stats){}
-
+        //  The overlays themselves are not pushed to listeners. Read them with
+        //  snapshot() and stats() when repainting.
     };
 
     // Add a UI class to listen to any overlay change. The UI class needs to inherit Listener.
@@ -67,7 +78,6 @@ public:
     void remove_listener(Listener& listener);
 
 public:
-    ~VideoOverlaySession();
     VideoOverlaySession(VideoOverlayOption& option);
 
     void get(VideoOverlayOption& option);
@@ -83,10 +93,19 @@ public:
     void set_enabled_log  (bool enabled);
     void set_enabled_stats(bool enabled);
 
+    //  The latest boxes, text and log. If nothing changed since the last
+    //  call, this only copies a pointer. Otherwise it builds a new snapshot.
+    std::shared_ptr<const VideoOverlaySnapshot> snapshot() const;
+
     std::vector<OverlayBox> boxes() const;
     std::vector<OverlayText> texts() const;
     std::vector<OverlayLogLine> log_texts() const;
 
+    //  The current value of every stat in the order they were added.
+    //  remove_stat() waits for this to finish so a stat can't be destroyed
+    //  while it's being read.
+    std::vector<OverlayStatSnapshot> stats() const;
+
     virtual void add_box(const OverlayBox& box) override;
     virtual void remove_box(const OverlayBox& box) override;
 
@@ -100,20 +119,45 @@ public:
     virtual void remove_stat(OverlayStat& stat) override;
 
 private:
-    //  Push updates to the various listeners.
-    void push_box_update();
-    void push_text_update();
-    void push_log_text_update();
+    //  Called by the writers before taking "m_lock". Wait while snapshot() is
+    //  trying to copy the state. Otherwise the writers could keep "m_lock"
+    //  busy and starve the repaint.
+    void wait_for_copy() const;
 
 private:
-    mutable SpinLock m_lock;
-
     VideoOverlayOption& m_option;
 
-    std::set<const OverlayBox*> m_boxes;
-    std::set<const OverlayText*> m_texts;
+    //  Serializes the writers. Protects the boxes, text and log. Also the
+    //  listeners. snapshot() only takes this to copy the state.
+    mutable SpinLock m_lock;
+
+    //  Copies are made when they are added. So the caller can change its own
+    //  object and add it again without racing with snapshot().
+    std::map<const OverlayBox*, OverlayBox> m_boxes;
+    std::map<const OverlayText*, OverlayText> m_texts;
     std::deque<OverlayLogLine> m_log_texts;
 
+    //  Set by every write to the boxes, text or log. Cleared when snapshot()
+    //  copies them.
+    mutable std::atomic<bool> m_dirty;
+
+    //  Held while building a snapshot. Readers that find the state dirty at
+    //  the same time wait here and then use the one that was just built.
+    mutable std::mutex m_build_lock;
+    //  Set while snapshot() is waiting for or holding "m_lock".
+    mutable std::atomic<bool> m_copying;
+
+    //  The published snapshot. This lock is only held to copy or swap the
+    //  pointer.
+    mutable SpinLock m_snapshot_lock;
+    mutable std::shared_ptr<const VideoOverlaySnapshot> m_snapshot;
+
+    //  The stats have their own lock so that reading them doesn't hold up the
+    //  boxes and log. The spin lock only guards the list itself. stats() holds
+    //  the mutex while it calls into the stats so remove_stat() can wait on it
+    //  without spinning.
+    mutable std::mutex m_stats_read_lock;
+    mutable SpinLock m_stats_lock;
     std::list<OverlayStat*> m_stats_order;
     std::map<OverlayStat*, std::list<OverlayStat*>::iterator> m_stats;
 
@@ -16,6 +16,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Logging/FileWindowLogger.h"
 #include "CommonFramework/NewVersionCheck.h"
+#include "CommonFramework/PersistentSettings.h"
 #include "PanelLists.h"
 #include "WindowTracker.h"
 #include "ButtonDiagram.h"
@@ -216,6 +217,7 @@ void MainWindow::close_panel(){
         return;
     }
 
+    PERSISTENT_SETTINGS().untrack_panel(*m_current_panel);
     m_current_panel->save_settings();
 #if 0
     const std::string& identifier = m_current_panel->descriptor().identifier();
@@ -254,6 +256,7 @@ void MainWindow::load_panel(
     m_current_panel_descriptor = std::move(descriptor);
     m_current_panel = std::move(panel);
     m_right_panel_layout->addWidget(m_current_panel_widget);
+    PERSISTENT_SETTINGS().track_panel(*m_current_panel);
 }
 void MainWindow::on_busy(){
     if (m_program_list){
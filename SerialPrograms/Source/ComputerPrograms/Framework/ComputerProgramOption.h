@@ -31,6 +31,7 @@ public:
 
     virtual void from_json(const JsonValue& json) override;
     virtual JsonValue to_json() const override;
+    virtual ConfigOption* options_root() override{ return &options(); }
 
 public:
     const ComputerProgramDescriptor& descriptor() const{ return m_descriptor; }
@@ -11,6 +11,7 @@
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
+#include "CommonFramework/Resources/ResourceWarmup.h"
 #include "ComputerProgramOption.h"
 #include "ComputerProgramSession.h"
 
@@ -95,6 +96,7 @@ void ComputerProgramSession::internal_run_program(){
         *this,
         current_stats_tracker(), historical_stats_tracker()
     );
+    ResourceWarmup warmup(env.logger(), env.inference_dispatcher(), descriptor().warmup_resources());
 
     try{
         logger().log("<b>Starting Program: " + identifier() + "</b>");
@@ -7,16 +7,9 @@
 #ifndef PokemonAutomation_DiscordWebhook_H
 #define PokemonAutomation_DiscordWebhook_H
 
-#include <deque>
-#include <condition_variable>
-#include <QNetworkReply>
-#include "Common/Cpp/Time.h"
-#include "Common/Cpp/Concurrency/ScheduledTaskRunner.h"
 #include "CommonFramework/Logging/Logger.h"
-#include "CommonFramework/Options/ScreenshotFormatOption.h"
 #include "CommonFramework/Notifications/MessageAttachment.h"
-
-class QEventLoop;
+#include "DiscordWebhookDelivery.h"
 
 namespace PokemonAutomation{
     class JsonArray;
@@ -26,15 +19,9 @@ namespace DiscordWebhook{
 
 
 
-class DiscordWebhookSender : public QObject{
-    Q_OBJECT
-
-    static constexpr auto THROTTLE_DURATION = std::chrono::seconds(1);
-//    static constexpr size_t MAX_IN_WINDOW = 2;
-
+class DiscordWebhookSender{
 private:
     DiscordWebhookSender();
-    ~DiscordWebhookSender();
 
 
 public:
@@ -54,27 +41,11 @@ public:
 
 
 private:
-    void cleanup_stuck_requests();
-//    void thread_loop();
-    void throttle();
-
-    void process_reply(QNetworkReply* reply);
-    void internal_send_json(const QUrl& url, const QByteArray& data);
-    void internal_send_file(const QUrl& url, const std::string& filename);
-    void internal_send_image_embed(const QUrl& url, const QByteArray& data, const std::string& filepath, const std::string& filename);
-
-signals:
-    void stop_event_loop();
+    void send(Logger& logger, WebhookMessage message);
 
 private:
     TaggedLogger m_logger;
-    bool m_stopping;
-    std::mutex m_lock;
-    std::condition_variable m_cv;
-
-    std::deque<WallClock> m_sent;
-    AsyncDispatcher m_dispatcher;
-    ScheduledTaskRunner m_queue;
+    WebhookDeliveryEngine m_engine;
 };
 
 
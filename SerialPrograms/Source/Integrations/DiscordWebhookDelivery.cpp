@@ -0,0 +1,597 @@
+/*  Discord Webhook Delivery
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <set>
+#include <algorithm>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <QHttpMultiPart>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonParser.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Notifications/MessageAttachment.h"
+#include "DiscordWebhookDelivery.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace Integration{
+namespace DiscordWebhook{
+
+
+
+namespace{
+
+const int REQUEST_TIMEOUT_MS = 30000;
+
+
+WallClock seconds_from(WallClock now, double seconds){
+    seconds = std::min(std::max(seconds, 0.), 3600.);
+    return now + std::chrono::milliseconds((int64_t)(seconds * 1000) + 1);
+}
+
+size_t embed_count(const JsonObject& payload){
+    const JsonArray* embeds = payload.get_array("embeds");
+    return embeds == nullptr ? 0 : embeds->size();
+}
+size_t content_length(const JsonObject& payload){
+    const std::string* content = payload.get_string("content");
+    return content == nullptr ? 0 : content->size();
+}
+const size_t UNKNOWN_SIZE = (size_t)-1;
+
+//  Remove embed images that point at an attachment we couldn't send.
+void drop_attachment_references(JsonObject& payload, const std::string& filename){
+    JsonArray* embeds = payload.get_array("embeds");
+    if (embeds == nullptr){
+        return;
+    }
+    const std::string url = "attachment://" + filename;
+    for (JsonValue& value : *embeds){
+        JsonObject* embed = value.to_object();
+        if (embed == nullptr){
+            continue;
+        }
+        const JsonObject* image = embed->get_object("image");
+        const std::string* image_url = image == nullptr ? nullptr : image->get_string("url");
+        if (image_url == nullptr || *image_url != url){
+            continue;
+        }
+        JsonObject stripped;
+        for (auto& item : *embed){
+            if (item.first != "image"){
+                stripped[item.first] = std::move(item.second);
+            }
+        }
+        *embed = std::move(stripped);
+    }
+}
+
+bool attachments_ready(const WebhookMessage& message){
+    for (const WebhookAttachment& attachment : message.attachments){
+        if (attachment.file && !attachment.file->ready()){
+            return false;
+        }
+    }
+    return true;
+}
+size_t attachment_size(const WebhookAttachment& attachment){
+    if (!attachment.data.isEmpty() || !attachment.file){
+        return attachment.data.size();
+    }
+    if (!attachment.file->ready()){
+        return UNKNOWN_SIZE;
+    }
+    QByteArray data = attachment.file->data();
+    if (!data.isEmpty()){
+        return data.size();
+    }
+    return (size_t)QFileInfo(QString::fromStdString(attachment.file->filepath())).size();
+}
+
+//  Only plain messages can be merged. Anything that sets the username,
+//  avatar, etc... is sent on its own.
+bool is_mergeable(const JsonObject& payload){
+    for (const auto& item : payload){
+        if (item.first != "content" && item.first != "embeds"){
+            return false;
+        }
+    }
+    return true;
+}
+
+JsonObject merge_payloads(const std::vector<WebhookMessage>& batch){
+    if (batch.size() == 1){
+        return batch[0].payload.clone();
+    }
+    std::string content;
+    JsonArray embeds;
+    for (const WebhookMessage& message : batch){
+        const std::string* str = message.payload.get_string("content");
+        if (str != nullptr && !str->empty()){
+            if (!content.empty()){
+                content += "\n";
+            }
+            content += *str;
+        }
+        const JsonArray* array = message.payload.get_array("embeds");
+        if (array != nullptr){
+            for (const JsonValue& embed : *array){
+                embeds.push_back(embed.clone());
+            }
+        }
+    }
+    JsonObject ret;
+    if (!content.empty()){
+        ret["content"] = std::move(content);
+    }
+    if (!embeds.empty()){
+        ret["embeds"] = std::move(embeds);
+    }
+    return ret;
+}
+
+const char* content_type(const std::string& filename){
+    QString suffix = QFileInfo(QString::fromStdString(filename)).suffix().toLower();
+    if (suffix == "png"){
+        return "image/png";
+    }
+    if (suffix == "jpg" || suffix == "jpeg"){
+        return "image/jpeg";
+    }
+    if (suffix == "txt" || suffix == "log"){
+        return "text/plain";
+    }
+    return "application/octet-stream";
+}
+
+}
+
+
+
+WebhookDeliveryEngine::WebhookDeliveryEngine(Logger& logger, size_t max_sends_per_second)
+    : m_logger(logger)
+    , m_max_sends_per_second(std::max<size_t>(max_sends_per_second, 1))
+    , m_context(new QObject())
+{
+    m_context->moveToThread(&m_thread);
+    m_thread.start();
+    QMetaObject::invokeMethod(m_context, [this]{
+        m_manager = new QNetworkAccessManager(m_context);
+        m_timer = new QTimer(m_context);
+        m_timer->setSingleShot(true);
+        QObject::connect(
+            m_timer, &QTimer::timeout,
+            m_context, [this]{ pump(); }
+        );
+        QObject::connect(
+            m_manager, &QNetworkAccessManager::finished,
+            m_context, [this](QNetworkReply* reply){ on_finished(reply); }
+        );
+    }, Qt::BlockingQueuedConnection);
+}
+WebhookDeliveryEngine::~WebhookDeliveryEngine(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    if (m_thread.isRunning()){
+        QMetaObject::invokeMethod(m_context, [this]{
+            m_timer->stop();
+            std::vector<QNetworkReply*> replies;
+            {
+                std::lock_guard<std::mutex> lg(m_lock);
+                for (const auto& item : m_in_flight){
+                    replies.emplace_back(item.first);
+                }
+            }
+            for (QNetworkReply* reply : replies){
+                reply->abort();
+            }
+            delete m_manager;
+            delete m_timer;
+            m_manager = nullptr;
+            m_timer = nullptr;
+        }, Qt::BlockingQueuedConnection);
+        m_thread.quit();
+        m_thread.wait();
+    }
+    delete m_context;
+}
+
+
+void WebhookDeliveryEngine::set_max_sends_per_second(size_t max_sends_per_second){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_max_sends_per_second = std::max<size_t>(max_sends_per_second, 1);
+}
+size_t WebhookDeliveryEngine::enqueue(WebhookMessage message){
+    size_t pending;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_stopping){
+            return 0;
+        }
+        QString key = message.url.toString();
+        m_queues[key].messages.emplace_back(std::move(message));
+        m_stats.messages_queued++;
+        pending = ++m_pending;
+    }
+    schedule_pump();
+    return pending;
+}
+size_t WebhookDeliveryEngine::pending() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_pending;
+}
+WebhookDeliveryStats WebhookDeliveryEngine::stats() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_stats;
+}
+bool WebhookDeliveryEngine::wait_until_idle(std::chrono::milliseconds timeout){
+    std::unique_lock<std::mutex> lg(m_lock);
+    return m_cv.wait_for(lg, timeout, [this]{ return m_stopping || is_idle(); });
+}
+bool WebhookDeliveryEngine::is_idle() const{
+    return m_pending == 0 && m_in_flight.empty();
+}
+
+
+std::string WebhookDeliveryEngine::redact(const QUrl& url) const{
+    //  The path of a webhook URL is its token.
+    return url.scheme().toStdString() + "://" + url.authority().toStdString() + "/****************";
+}
+
+
+bool WebhookDeliveryEngine::local_limit_allows(WallClock now, WallClock& next){
+    const auto WINDOW = std::chrono::seconds(1);
+    while (!m_sent.empty() && m_sent.front() + WINDOW <= now){
+        m_sent.pop_front();
+    }
+    if (m_sent.size() >= m_max_sends_per_second){
+        next = std::min(next, m_sent.front() + WINDOW);
+        return false;
+    }
+    m_sent.emplace_back(now);
+    return true;
+}
+std::vector<WebhookMessage> WebhookDeliveryEngine::take_batch(UrlQueue& queue, WallClock now){
+    std::vector<WebhookMessage> batch;
+    size_t embeds = 0;
+    size_t content = 0;
+    size_t attachments = 0;
+    size_t bytes = 0;
+    std::set<std::string> filenames;
+
+    while (!queue.messages.empty()){
+        WebhookMessage& message = queue.messages.front();
+
+        size_t message_bytes = 0;
+        bool duplicate_name = false;
+        for (const WebhookAttachment& attachment : message.attachments){
+            size_t size = attachment_size(attachment);
+            message_bytes = size == UNKNOWN_SIZE || message_bytes == UNKNOWN_SIZE
+                ? UNKNOWN_SIZE
+                : message_bytes + size;
+            duplicate_name |= filenames.find(attachment.filename) != filenames.end();
+        }
+
+        if (!batch.empty()){
+            if (message.not_before > now ||
+                !is_mergeable(batch[0].payload) ||
+                !is_mergeable(message.payload) ||
+                duplicate_name ||
+                embeds + embed_count(message.payload) > MAX_EMBEDS ||
+                content + content_length(message.payload) + 1 > MAX_CONTENT_LENGTH ||
+                attachments + message.attachments.size() > MAX_ATTACHMENTS ||
+                (message_bytes != 0 && (
+                    message_bytes == UNKNOWN_SIZE ||
+                    bytes == UNKNOWN_SIZE ||
+                    bytes + message_bytes > MAX_ATTACHMENT_BYTES
+                ))
+            ){
+                break;
+            }
+        }
+
+        embeds += embed_count(message.payload);
+        content += content_length(message.payload) + 1;
+        attachments += message.attachments.size();
+        if (message_bytes != 0){
+            bytes = message_bytes == UNKNOWN_SIZE || bytes == UNKNOWN_SIZE ? UNKNOWN_SIZE : bytes + message_bytes;
+        }
+        for (const WebhookAttachment& attachment : message.attachments){
+            filenames.insert(attachment.filename);
+        }
+        batch.emplace_back(std::move(message));
+        queue.messages.pop_front();
+    }
+    return batch;
+}
+
+
+void WebhookDeliveryEngine::schedule_pump(){
+    QMetaObject::invokeMethod(m_context, [this]{ pump(); }, Qt::QueuedConnection);
+}
+void WebhookDeliveryEngine::pump(){
+    std::vector<std::pair<QString, std::vector<WebhookMessage>>> ready;
+    WallClock next = WallClock::max();
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_stopping){
+            return;
+        }
+        WallClock now = current_time();
+        for (auto iter = m_queues.begin(); iter != m_queues.end();){
+            UrlQueue& queue = iter->second;
+            if (queue.in_flight){
+                ++iter;
+                continue;
+            }
+            if (queue.messages.empty()){
+                //  Keep the entry while the bucket is exhausted so the next
+                //  message still waits for it.
+                if (queue.blocked_until <= now){
+                    iter = m_queues.erase(iter);
+                }else{
+                    ++iter;
+                }
+                continue;
+            }
+
+            WallClock start = std::max({
+                queue.messages.front().not_before,
+                queue.blocked_until,
+                m_global_blocked_until
+            });
+            if (start > now){
+                next = std::min(next, start);
+                ++iter;
+                continue;
+            }
+            if (!attachments_ready(queue.messages.front())){
+                //  Still encoding. Don't block the delivery thread on it.
+                next = std::min(next, now + std::chrono::milliseconds(10));
+                ++iter;
+                continue;
+            }
+            if (!local_limit_allows(now, next)){
+                break;
+            }
+
+            queue.in_flight = true;
+            ready.emplace_back(iter->first, take_batch(queue, now));
+            ++iter;
+        }
+    }
+
+    for (auto& item : ready){
+        post(item.first, std::move(item.second));
+    }
+
+    if (next != WallClock::max()){
+        auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(next - current_time());
+        int ms = (int)std::max<int64_t>(delay.count() + 1, 0);
+        if (!m_timer->isActive() || m_timer->remainingTime() > ms){
+            m_timer->start(ms);
+        }
+    }
+}
+
+void WebhookDeliveryEngine::post(const QString& key, std::vector<WebhookMessage> batch){
+    QNetworkRequest request(batch[0].url);
+    request.setTransferTimeout(REQUEST_TIMEOUT_MS);
+
+    //  Load any file-backed attachments. This only happens once per message
+    //  even if it's retried.
+    std::vector<const WebhookAttachment*> files;
+    for (WebhookMessage& message : batch){
+        for (WebhookAttachment& attachment : message.attachments){
+            if (attachment.data.isEmpty() && attachment.file){
+                attachment.data = attachment.file->data();
+            }
+            if (attachment.data.isEmpty() && attachment.file){
+                QFile file(QString::fromStdString(attachment.file->filepath()));
+                if (file.open(QIODevice::ReadOnly)){
+                    attachment.data = file.readAll();
+                }
+            }
+            if (attachment.data.isEmpty()){
+                m_logger.log("Unable to read attachment: " + attachment.filename, COLOR_RED);
+                drop_attachment_references(message.payload, attachment.filename);
+                continue;
+            }
+            files.emplace_back(&attachment);
+        }
+    }
+
+    QByteArray payload = QByteArray::fromStdString(merge_payloads(batch).dump());
+
+    QNetworkReply* reply;
+    if (files.empty()){
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+        reply = m_manager->post(request, payload);
+    }else{
+        QHttpMultiPart* multipart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+
+        QHttpPart json_part;
+        json_part.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"payload_json\""));
+        json_part.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/json"));
+        json_part.setBody(payload);
+        multipart->append(json_part);
+
+        for (size_t c = 0; c < files.size(); c++){
+            //  QByteArray is implicitly shared. The bytes are not copied.
+            QHttpPart file_part;
+            file_part.setHeader(
+                QNetworkRequest::ContentDispositionHeader,
+                QVariant(
+                    "form-data; name=\"files[" + QString::number(c) + "]\"; filename=\"" +
+                    QString::fromStdString(files[c]->filename) + "\""
+                )
+            );
+            file_part.setHeader(QNetworkRequest::ContentTypeHeader, QVariant(content_type(files[c]->filename)));
+            file_part.setBody(files[c]->data);
+            multipart->append(file_part);
+        }
+
+        reply = m_manager->post(request, multipart);
+        multipart->setParent(reply);
+    }
+
+    if (batch.size() > 1){
+        m_logger.log("Sending Webhook Message... (coalesced " + std::to_string(batch.size()) + " messages)", COLOR_BLUE);
+    }else{
+        m_logger.log("Sending Webhook Message...", COLOR_BLUE);
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_stats.requests++;
+    InFlight& flight = m_in_flight[reply];
+    flight.key = key;
+    flight.batch = std::move(batch);
+}
+
+void WebhookDeliveryEngine::requeue(UrlQueue& queue, std::vector<WebhookMessage>& batch, WallClock not_before){
+    for (auto iter = batch.rbegin(); iter != batch.rend(); ++iter){
+        iter->not_before = std::max(iter->not_before, not_before);
+        queue.messages.emplace_front(std::move(*iter));
+    }
+    batch.clear();
+}
+
+void WebhookDeliveryEngine::on_finished(QNetworkReply* reply){
+    reply->deleteLater();
+
+    InFlight flight;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        auto iter = m_in_flight.find(reply);
+        if (iter == m_in_flight.end()){
+            return;
+        }
+        flight = std::move(iter->second);
+        m_in_flight.erase(iter);
+        if (m_stopping){
+            m_cv.notify_all();
+            return;
+        }
+    }
+
+    const WallClock now = current_time();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QUrl url = flight.batch[0].url;
+
+    //  Bucket state. Sent with every response, including 429s.
+    WallClock bucket_reset = WallClock::min();
+    {
+        QByteArray remaining = reply->rawHeader("X-RateLimit-Remaining");
+        bool ok = false;
+        double reset_after = reply->rawHeader("X-RateLimit-Reset-After").toDouble(&ok);
+        if (!remaining.isEmpty() && remaining.toLongLong() <= 0 && ok){
+            bucket_reset = seconds_from(now, reset_after);
+        }
+    }
+
+    double retry_after = -1;
+    bool global = false;
+    if (status == 429){
+        QByteArray body = reply->readAll();
+        JsonValue json;
+        if (parse_json_direct(json, body.data(), body.size())){
+            const JsonObject* obj = json.to_object();
+            if (obj != nullptr){
+                obj->read_float(retry_after, "retry_after");
+                obj->read_boolean(global, "global");
+            }
+        }
+        if (retry_after < 0){
+            bool ok = false;
+            retry_after = reply->rawHeader("Retry-After").toDouble(&ok);
+            if (!ok){
+                retry_after = 1;
+            }
+        }
+        global |= reply->rawHeader("X-RateLimit-Global").toLower() == "true";
+    }
+
+    std::string error;
+    if (status != 429 && reply->error() != QNetworkReply::NoError){
+        error = reply->errorString().toStdString();
+        std::string raw_url = url.toString().toStdString();
+        size_t index = error.find(raw_url);
+        if (index != std::string::npos){
+            error.replace(index, raw_url.size(), redact(url));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        UrlQueue& queue = m_queues[flight.key];
+        queue.in_flight = false;
+        queue.blocked_until = std::max(queue.blocked_until, bucket_reset);
+
+        if (status == 429){
+            WallClock until = seconds_from(now, retry_after);
+            if (global){
+                m_global_blocked_until = std::max(m_global_blocked_until, until);
+            }else{
+                queue.blocked_until = std::max(queue.blocked_until, until);
+            }
+            m_stats.rate_limited++;
+            m_logger.log(
+                std::string("Discord rate limit") + (global ? " (global)" : "") +
+                ". Retrying in " + std::to_string((int64_t)(retry_after * 1000)) + " ms.",
+                COLOR_ORANGE
+            );
+            requeue(queue, flight.batch, WallClock::min());
+        }else if (error.empty()){
+            m_stats.messages_sent += flight.batch.size();
+            m_pending -= flight.batch.size();
+        }else{
+            //  Network errors and server errors are retried with backoff.
+            //  Anything else means the request itself is bad.
+            bool retryable = status == 0 || status >= 500;
+            m_logger.log("Discord Request Response: " + error, COLOR_RED);
+
+            std::vector<WebhookMessage> retry;
+            for (WebhookMessage& message : flight.batch){
+                message.attempts++;
+                if (retryable && message.attempts < MAX_ATTEMPTS){
+                    retry.emplace_back(std::move(message));
+                }else{
+                    m_stats.messages_dropped++;
+                    m_pending--;
+                }
+            }
+            if (!retry.empty()){
+                auto backoff = std::chrono::seconds((int64_t)1 << std::min<size_t>(retry[0].attempts, 6));
+                requeue(queue, retry, now + backoff);
+            }else{
+                m_logger.log("Dropping webhook message after " + std::to_string(flight.batch[0].attempts) + " attempt(s).", COLOR_RED);
+            }
+        }
+
+        if (is_idle()){
+            m_cv.notify_all();
+        }
+    }
+
+    pump();
+}
+
+
+
+
+}
+}
+}
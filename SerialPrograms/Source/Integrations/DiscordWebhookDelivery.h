@@ -0,0 +1,170 @@
+/*  Discord Webhook Delivery
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Delivery engine behind DiscordWebhookSender.
+ *
+ *  All requests go through one long-lived QNetworkAccessManager on a
+ *  dedicated thread so that HTTP connections to Discord are kept alive and
+ *  reused. Each webhook URL has its own queue and they are sent concurrently.
+ *
+ *  Rate Limits:
+ *    - "X-RateLimit-Remaining" and "X-RateLimit-Reset-After" pause the
+ *      webhook until its bucket resets.
+ *    - A 429 response puts the message back at the front of its queue and
+ *      waits "retry_after". If it's a global limit, all webhooks wait.
+ *    - "max_sends_per_second" is a local cap across all webhooks.
+ *
+ *  Coalescing:
+ *    When a webhook has several messages ready at once, they are merged into
+ *    as few requests as Discord allows. (up to 10 embeds, 10 files and 2000
+ *    characters of content per message)
+ *
+ *  Attachments are posted straight from memory. Nothing is written to disk.
+ *
+ *  The engine doesn't care where the URL points. Tests point it at a local
+ *  stand-in server. (see Tests/DiscordWebhook_Tests.h)
+ *
+ */
+
+#ifndef PokemonAutomation_DiscordWebhookDelivery_H
+#define PokemonAutomation_DiscordWebhookDelivery_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <QUrl>
+#include <QByteArray>
+#include <QThread>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonObject.h"
+
+class QObject;
+class QTimer;
+class QNetworkReply;
+class QNetworkAccessManager;
+
+namespace PokemonAutomation{
+    class Logger;
+    class PendingFileSend;
+namespace Integration{
+namespace DiscordWebhook{
+
+
+
+struct WebhookAttachment{
+    std::string filename;
+
+    //  Either the bytes themselves or a PendingFileSend to take them from.
+    //  Messages wait in the queue until the PendingFileSend is done encoding.
+    QByteArray data;
+    std::shared_ptr<PendingFileSend> file;
+};
+
+struct WebhookMessage{
+    QUrl url;
+    WallClock not_before = WallClock::min();
+
+    //  The Discord message object. ("content", "embeds", ...)
+    JsonObject payload;
+    std::vector<WebhookAttachment> attachments;
+
+    size_t attempts = 0;
+};
+
+struct WebhookDeliveryStats{
+    uint64_t messages_queued = 0;
+    uint64_t messages_sent = 0;
+    uint64_t messages_dropped = 0;
+    uint64_t requests = 0;
+    uint64_t rate_limited = 0;
+};
+
+
+
+class WebhookDeliveryEngine{
+public:
+    static constexpr size_t MAX_ATTEMPTS = 5;
+
+    static constexpr size_t MAX_EMBEDS = 10;
+    static constexpr size_t MAX_ATTACHMENTS = 10;
+    static constexpr size_t MAX_CONTENT_LENGTH = 2000;
+    static constexpr size_t MAX_ATTACHMENT_BYTES = 8 * 1024 * 1024;
+
+public:
+    WebhookDeliveryEngine(Logger& logger, size_t max_sends_per_second);
+    ~WebhookDeliveryEngine();
+
+    void set_max_sends_per_second(size_t max_sends_per_second);
+
+    //  Queue a message. Thread-safe. Returns the # of messages still pending.
+    size_t enqueue(WebhookMessage message);
+
+    size_t pending() const;
+    WebhookDeliveryStats stats() const;
+
+    //  Wait until everything has been sent or dropped. Returns false on timeout.
+    bool wait_until_idle(std::chrono::milliseconds timeout);
+
+
+private:
+    struct UrlQueue{
+        std::deque<WebhookMessage> messages;
+        bool in_flight = false;
+        WallClock blocked_until = WallClock::min();
+    };
+    struct InFlight{
+        QString key;
+        std::vector<WebhookMessage> batch;
+    };
+
+    //  These run on the delivery thread.
+    void schedule_pump();
+    void pump();
+    void post(const QString& key, std::vector<WebhookMessage> batch);
+    void on_finished(QNetworkReply* reply);
+    void requeue(UrlQueue& queue, std::vector<WebhookMessage>& batch, WallClock not_before);
+
+    //  These need "m_lock".
+    bool local_limit_allows(WallClock now, WallClock& next);
+    std::vector<WebhookMessage> take_batch(UrlQueue& queue, WallClock now);
+    bool is_idle() const;
+
+    std::string redact(const QUrl& url) const;
+
+private:
+    Logger& m_logger;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+
+    size_t m_max_sends_per_second;
+    std::deque<WallClock> m_sent;
+    WallClock m_global_blocked_until = WallClock::min();
+
+    std::map<QString, UrlQueue> m_queues;
+    size_t m_pending = 0;
+    std::map<QNetworkReply*, InFlight> m_in_flight;
+    WebhookDeliveryStats m_stats;
+
+    //  Owned by and only touched on "m_thread".
+    QObject* m_context;
+    QNetworkAccessManager* m_manager = nullptr;
+    QTimer* m_timer = nullptr;
+
+    QThread m_thread;
+};
+
+
+
+
+}
+}
+}
+#endif
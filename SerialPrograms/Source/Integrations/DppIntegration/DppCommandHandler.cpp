@@ -95,14 +95,19 @@ void Handler::send_message(cluster& bot, embed& embed, const std::string& channe
     Handler::m_queue.add_event(delay > std::chrono::milliseconds(10000) ? std::chrono::milliseconds(0) : delay,
     [&bot, this, embed = std::move(embed), channel = channel, msg = msg, file = std::move(file)]() mutable {
         message m;
-        if (file != nullptr && !file->filepath().empty() && !file->filename().empty()){
-            std::string data;
-            std::string path = file->filepath();
+        if (file != nullptr && !file->filename().empty()){
+            std::string data = file->data().toStdString();
             try{
-                data = utility::read_file(path);
-                m.add_file(file->filename(), data);
-                if (path.find(".txt") == std::string::npos){
-                    embed.set_image("attachment://" + file->filename());
+                if (data.empty() && !file->filepath().empty()){
+                    data = utility::read_file(file->filepath());
+                }
+                if (data.empty()){
+                    log_dpp("Screenshot failed to encode. Sending without it.", "send_message()", ll_warning);
+                }else{
+                    m.add_file(file->filename(), data);
+                    if (file->filename().find(".txt") == std::string::npos){
+                        embed.set_image("attachment://" + file->filename());
+                    }
                 }
             }catch (dpp::exception e){
                 log_dpp("Exception thrown while reading screenshot data: " + (std::string)e.what(), "send_message()", ll_error);
@@ -123,12 +128,18 @@ void Handler::send_message(cluster& bot, embed& embed, const std::string& channe
 
 void Handler::update_response(const dpp::command_source& src, dpp::embed& embed, const std::string& msg, std::shared_ptr<PendingFileSend> file){
     message m;
-    if (file != nullptr && !file->filepath().empty() && !file->filename().empty()){
-        std::string data;
+    if (file != nullptr && !file->filename().empty()){
+        std::string data = file->data().toStdString();
         try{
-            data = utility::read_file(file->filepath());
-            m.add_file(file->filename(), data);
-            embed.set_image("attachment://" + file->filename());
+            if (data.empty() && !file->filepath().empty()){
+                data = utility::read_file(file->filepath());
+            }
+            if (data.empty()){
+                log_dpp("Screenshot failed to encode. Sending without it.", "update_response()", ll_warning);
+            }else{
+                m.add_file(file->filename(), data);
+                embed.set_image("attachment://" + file->filename());
+            }
         }catch (dpp::exception e){
             log_dpp("Exception thrown while reading screenshot data: " + (std::string)e.what(), "send_message()", ll_error);
         }
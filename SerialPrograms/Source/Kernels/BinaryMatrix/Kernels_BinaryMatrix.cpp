@@ -5,6 +5,7 @@
  */
 
 
+#include <atomic>
 #include "Common/Cpp/CpuId/CpuId.h"
 #include "Kernels_PackedBinaryMatrixCore.tpp"
 #include "Kernels_SparseBinaryMatrixCore.tpp"
@@ -15,7 +16,18 @@ namespace Kernels{
 
 
 
+//  -1 means no override.
+std::atomic<int> BINARY_MATRIX_TYPE_OVERRIDE(-1);
+
+
 BinaryMatrixType get_BinaryMatrixType(){
+    int type = BINARY_MATRIX_TYPE_OVERRIDE.load(std::memory_order_relaxed);
+    if (type >= 0 && is_BinaryMatrixType_supported((BinaryMatrixType)type)){
+        return (BinaryMatrixType)type;
+    }
+    return get_BinaryMatrixType_default();
+}
+BinaryMatrixType get_BinaryMatrixType_default(){
 
 #ifdef PA_ARCH_x86
 //    if (CPU_CAPABILITY_CURRENT.OK_19_IceLake){
@@ -39,6 +51,58 @@ BinaryMatrixType get_BinaryMatrixType(){
 //    return BinaryMatrixType::i64x8_Default;
     return BinaryMatrixType::i64x4_Default;
 }
+bool is_BinaryMatrixType_supported(BinaryMatrixType type){
+    switch (type){
+
+#ifdef PA_ARCH_x86
+#ifdef PA_AutoDispatch_x64_19_IceLake
+    case BinaryMatrixType::i64x32_x64_AVX512:
+        return CPU_CAPABILITY_CURRENT.OK_17_Skylake;
+#endif
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    case BinaryMatrixType::i64x64_x64_AVX512:
+        return CPU_CAPABILITY_CURRENT.OK_17_Skylake;
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    case BinaryMatrixType::i64x16_x64_AVX2:
+        return CPU_CAPABILITY_CURRENT.OK_13_Haswell;
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    case BinaryMatrixType::i64x8_x64_SSE42:
+        return CPU_CAPABILITY_CURRENT.OK_08_Nehalem;
+#endif
+#elif PA_ARCH_arm64
+#ifdef PA_AutoDispatch_arm64_20_M1
+    case BinaryMatrixType::arm64x8_x64_NEON:
+        return CPU_CAPABILITY_CURRENT.OK_M1;
+#endif
+#endif
+
+    //  i64x8_Default has no filter kernels. It is only used for testing.
+    case BinaryMatrixType::i64x4_Default:
+        return true;
+    default:
+        return false;
+    }
+}
+const char* get_BinaryMatrixType_name(BinaryMatrixType type){
+    switch (type){
+    case BinaryMatrixType::i64x4_Default:       return "64x4 Default";
+    case BinaryMatrixType::i64x8_Default:       return "64x8 Default";
+    case BinaryMatrixType::i64x8_x64_SSE42:     return "64x8 x64 SSE4.2";
+    case BinaryMatrixType::i64x16_x64_AVX2:     return "64x16 x64 AVX2";
+    case BinaryMatrixType::i64x64_x64_AVX512:   return "64x64 x64 AVX512";
+    case BinaryMatrixType::i64x32_x64_AVX512:   return "64x32 x64 AVX512";
+    case BinaryMatrixType::arm64x8_x64_NEON:    return "64x8 arm64 NEON";
+    }
+    return "Unknown";
+}
+void set_BinaryMatrixType_override(BinaryMatrixType type){
+    BINARY_MATRIX_TYPE_OVERRIDE.store((int)type, std::memory_order_relaxed);
+}
+void clear_BinaryMatrixType_override(){
+    BINARY_MATRIX_TYPE_OVERRIDE.store(-1, std::memory_order_relaxed);
+}
 
 
 std::unique_ptr<PackedBinaryMatrix_IB> make_PackedBinaryMatrix_64x4_Default();
@@ -60,6 +60,7 @@
 #ifndef PokemonAutomation_Kernels_PackedBinaryMatrix_H
 #define PokemonAutomation_Kernels_PackedBinaryMatrix_H
 
+#include <stdint.h>
 #include <memory>
 #include <string>
 
@@ -88,8 +89,26 @@ enum class BinaryMatrixType{
 
 // Get the current active binary matrix type that will be used or is being used
 // by waterfill functions and others.
+// This is the override if one is set and supported, otherwise the default below.
 BinaryMatrixType get_BinaryMatrixType();
 
+// The binary matrix type picked from the processor level alone.
+BinaryMatrixType get_BinaryMatrixType_default();
+
+// Whether the type has a full set of kernels compiled in and can run at the
+// current processor level.
+bool is_BinaryMatrixType_supported(BinaryMatrixType type);
+
+// Human readable name of the type, e.g. "64x16 x64 AVX2". Also used as the
+// key when the type is saved to settings.
+const char* get_BinaryMatrixType_name(BinaryMatrixType type);
+
+// Replace the processor level default with a specific type. This is set by
+// the kernel autotuner. The override is ignored while the current processor
+// level does not support it. (e.g. the user lowered the level after tuning)
+void set_BinaryMatrixType_override(BinaryMatrixType type);
+void clear_BinaryMatrixType_override();
+
 // Abstract class for all implmentations of packed binary matrices.
 // Those binary matrices are memory-efficient: each binary element is stored as just one bit in memory.
 // The representation uses "tiles". So instead of having each row contiguous in memory, the space is
@@ -141,6 +160,15 @@ public:
     virtual void set(size_t x, size_t y, bool set) = 0;
 
     virtual std::unique_ptr<PackedBinaryMatrix_IB> submatrix(size_t x, size_t y, size_t width, size_t height) const = 0;
+
+public:
+    //  Raw memory layout. Every tile is 64 bits wide and stores its rows as
+    //  consecutive uint64_t. Tiles are stored row-major.
+    //  Don't use these directly. Use PackedBinaryMatrixView instead.
+    //  (see Kernels_PackedBinaryMatrixView.h)
+    virtual size_t rows_per_tile() const = 0;
+    virtual const uint64_t* word64_data() const = 0;
+    virtual       uint64_t* word64_data() = 0;
 };
 std::unique_ptr<PackedBinaryMatrix_IB> make_PackedBinaryMatrix(BinaryMatrixType type);
 std::unique_ptr<PackedBinaryMatrix_IB> make_PackedBinaryMatrix(BinaryMatrixType type, size_t width, size_t height);
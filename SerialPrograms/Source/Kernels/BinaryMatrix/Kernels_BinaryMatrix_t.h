@@ -93,10 +93,34 @@ public:
         return ret;
     }
 
+public:
+    virtual size_t rows_per_tile() const override{ return Tile::HEIGHT; }
+    virtual const uint64_t* word64_data() const override{ return m_matrix.word64_data(); }
+    virtual       uint64_t* word64_data()       override{ return m_matrix.word64_data(); }
+
 private:
     PackedBinaryMatrixCore<Tile> m_matrix;
 };
 
+//  Get the concrete matrix behind "matrix" so that hot loops can work on its
+//  tiles without any virtual calls. Throws if it's a different tile type.
+//  This needs the tile's instruction set so only use it in code that is
+//  compiled for it. Use PackedBinaryMatrixView anywhere else.
+template <typename Tile>
+const PackedBinaryMatrixCore<Tile>& get_core(const PackedBinaryMatrix_IB& matrix){
+    if (matrix.type() != Tile::TYPE){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching matrix types.");
+    }
+    return static_cast<const PackedBinaryMatrix_t<Tile>&>(matrix).get();
+}
+template <typename Tile>
+PackedBinaryMatrixCore<Tile>& get_core(PackedBinaryMatrix_IB& matrix){
+    if (matrix.type() != Tile::TYPE){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching matrix types.");
+    }
+    return static_cast<PackedBinaryMatrix_t<Tile>&>(matrix).get();
+}
+
 
 template <typename Tile>
 class SparseBinaryMatrix_t final : public SparseBinaryMatrix_IB{
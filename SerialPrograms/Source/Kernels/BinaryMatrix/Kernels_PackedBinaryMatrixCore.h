@@ -34,6 +34,12 @@ public:
     PA_FORCE_INLINE friend bool operator<(const TileIndex& a, const TileIndex& b){
         return a.m_index < b.m_index;
     }
+    PA_FORCE_INLINE friend bool operator==(const TileIndex& a, const TileIndex& b){
+        return a.m_index == b.m_index;
+    }
+    PA_FORCE_INLINE friend bool operator!=(const TileIndex& a, const TileIndex& b){
+        return a.m_index != b.m_index;
+    }
 
 private:
     uint64_t m_index;
@@ -116,6 +122,17 @@ public:
     // Get (x-th, y-th) word. One word is 8 bytes (aka 64 bits), one row in a tile.
     uint64_t& word64(size_t x, size_t y);
 
+    // The start of the tiles as an array of words. Each tile is TileType::HEIGHT
+    // consecutive words, one per row.
+    const uint64_t* word64_data() const{
+        static_assert(sizeof(TileType) == TILE_HEIGHT * sizeof(uint64_t));
+        return reinterpret_cast<const uint64_t*>(m_data.data());
+    }
+    uint64_t* word64_data(){
+        static_assert(sizeof(TileType) == TILE_HEIGHT * sizeof(uint64_t));
+        return reinterpret_cast<uint64_t*>(m_data.data());
+    }
+
 private:
     static constexpr size_t TILE_WIDTH = TileType::WIDTH;
     static constexpr size_t TILE_HEIGHT = TileType::HEIGHT;
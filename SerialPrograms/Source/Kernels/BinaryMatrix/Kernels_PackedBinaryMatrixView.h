@@ -0,0 +1,203 @@
+/*  Packed Binary Matrix View
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Statically typed access to the bits of a packed binary matrix without
+ *  going through a virtual call per bit.
+ *
+ *  Every tile type is 64 bits wide and stores its rows as consecutive
+ *  uint64_t. So the memory layout of a matrix only depends on the tile height.
+ *  The view is templated on that rather than on the tile type itself. This
+ *  keeps it free of SIMD intrinsics so it can be used from any file
+ *  regardless of what instruction set it is compiled for.
+ *
+ *  Usage:
+ *
+ *      visit_matrix(matrix, [&](auto view){
+ *          for_each_set_bit(view, [&](size_t x, size_t y){
+ *              ...
+ *          });
+ *      });
+ *
+ *  The lambda is instantiated once for each tile height. The dispatch happens
+ *  once per call to visit_matrix(), not per bit.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_PackedBinaryMatrixView_H
+#define PokemonAutomation_Kernels_PackedBinaryMatrixView_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_BitScan.h"
+#include "Kernels_BinaryMatrix.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+//  "WordType" is "uint64_t" for a mutable view or "const uint64_t" for a
+//  read-only view.
+template <typename WordType, size_t TILE_HEIGHT_>
+class PackedBinaryMatrixView{
+public:
+    static constexpr size_t TILE_WIDTH = 64;
+    static constexpr size_t TILE_HEIGHT = TILE_HEIGHT_;
+    static_assert((TILE_HEIGHT & (TILE_HEIGHT - 1)) == 0, "Tile height must be a power of two.");
+
+public:
+    PackedBinaryMatrixView(WordType* data, size_t width, size_t height)
+        : m_data(data)
+        , m_width(width)
+        , m_height(height)
+        , m_tile_width((width + TILE_WIDTH - 1) / TILE_WIDTH)
+    {}
+
+    //  A mutable view converts to a read-only view.
+    operator PackedBinaryMatrixView<const uint64_t, TILE_HEIGHT>() const{
+        return PackedBinaryMatrixView<const uint64_t, TILE_HEIGHT>(m_data, m_width, m_height);
+    }
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+public:
+    //  Word Access. Word (x, y) is bits [64*x, 64*x + 64) of row y.
+    //  Bit i of the word is the pixel at 64*x + i.
+    size_t word64_width() const{ return m_tile_width; }
+    size_t word64_height() const{ return m_height; }
+
+    PA_FORCE_INLINE WordType& word64(size_t x, size_t y) const{
+        size_t tile_y = y / TILE_HEIGHT;
+        size_t row = y % TILE_HEIGHT;
+        return m_data[(tile_y * m_tile_width + x) * TILE_HEIGHT + row];
+    }
+
+    //  The bits of word column "x" that are inside the matrix.
+    PA_FORCE_INLINE uint64_t word64_mask(size_t x) const{
+        size_t bits = m_width - x * TILE_WIDTH;
+        return bits >= TILE_WIDTH ? ~(uint64_t)0 : ((uint64_t)1 << bits) - 1;
+    }
+
+public:
+    //  Bit Access
+    PA_FORCE_INLINE bool get(size_t x, size_t y) const{
+        return (word64(x / TILE_WIDTH, y) >> (x % TILE_WIDTH)) & 1;
+    }
+    PA_FORCE_INLINE void set(size_t x, size_t y, bool set) const{
+        static_assert(!std::is_const<WordType>::value, "Cannot set bits through a read-only view.");
+        uint64_t& word = word64(x / TILE_WIDTH, y);
+        uint64_t bit = (uint64_t)1 << (x % TILE_WIDTH);
+        word = set ? word | bit : word & ~bit;
+    }
+
+private:
+    WordType* m_data;
+    size_t m_width;
+    size_t m_height;
+    size_t m_tile_width;
+};
+
+
+
+//  Call "visitor(view)" with the statically typed view of "matrix".
+//  Returns whatever "visitor" returns.
+template <typename Visitor>
+decltype(auto) visit_matrix(const PackedBinaryMatrix_IB& matrix, Visitor&& visitor){
+    const uint64_t* data = matrix.word64_data();
+    size_t width = matrix.width();
+    size_t height = matrix.height();
+    switch (matrix.rows_per_tile()){
+    case 4:
+        return visitor(PackedBinaryMatrixView<const uint64_t, 4>(data, width, height));
+    case 8:
+        return visitor(PackedBinaryMatrixView<const uint64_t, 8>(data, width, height));
+    case 16:
+        return visitor(PackedBinaryMatrixView<const uint64_t, 16>(data, width, height));
+    case 32:
+        return visitor(PackedBinaryMatrixView<const uint64_t, 32>(data, width, height));
+    case 64:
+        return visitor(PackedBinaryMatrixView<const uint64_t, 64>(data, width, height));
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported tile height: " + std::to_string(matrix.rows_per_tile()));
+    }
+}
+template <typename Visitor>
+decltype(auto) visit_matrix(PackedBinaryMatrix_IB& matrix, Visitor&& visitor){
+    uint64_t* data = matrix.word64_data();
+    size_t width = matrix.width();
+    size_t height = matrix.height();
+    switch (matrix.rows_per_tile()){
+    case 4:
+        return visitor(PackedBinaryMatrixView<uint64_t, 4>(data, width, height));
+    case 8:
+        return visitor(PackedBinaryMatrixView<uint64_t, 8>(data, width, height));
+    case 16:
+        return visitor(PackedBinaryMatrixView<uint64_t, 16>(data, width, height));
+    case 32:
+        return visitor(PackedBinaryMatrixView<uint64_t, 32>(data, width, height));
+    case 64:
+        return visitor(PackedBinaryMatrixView<uint64_t, 64>(data, width, height));
+    default:
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unsupported tile height: " + std::to_string(matrix.rows_per_tile()));
+    }
+}
+
+
+
+//  Bit Iteration
+
+//  Call "function(x, y)" for every set bit in row "y", in increasing x.
+template <typename WordType, size_t TILE_HEIGHT, typename Function>
+PA_FORCE_INLINE void for_each_set_bit_in_row(
+    const PackedBinaryMatrixView<WordType, TILE_HEIGHT>& matrix,
+    size_t y, Function&& function
+){
+    size_t words = matrix.word64_width();
+    for (size_t x = 0; x < words; x++){
+        uint64_t word = matrix.word64(x, y) & matrix.word64_mask(x);
+        size_t bit;
+        while (trailing_zeros(bit, word)){
+            function(x * 64 + bit, y);
+            word &= word - 1;
+        }
+    }
+}
+
+//  Call "function(x, y)" for every set bit, in row-major order.
+//  Zero words are skipped 64 bits at a time.
+template <typename WordType, size_t TILE_HEIGHT, typename Function>
+void for_each_set_bit(
+    const PackedBinaryMatrixView<WordType, TILE_HEIGHT>& matrix,
+    Function&& function
+){
+    size_t height = matrix.height();
+    for (size_t y = 0; y < height; y++){
+        for_each_set_bit_in_row(matrix, y, function);
+    }
+}
+
+//  # of set bits in the matrix.
+template <typename WordType, size_t TILE_HEIGHT>
+size_t count_set_bits(const PackedBinaryMatrixView<WordType, TILE_HEIGHT>& matrix){
+    size_t total = 0;
+    size_t words = matrix.word64_width();
+    size_t height = matrix.height();
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < words; x++){
+            total += pop_count(matrix.word64(x, y) & matrix.word64_mask(x));
+        }
+    }
+    return total;
+}
+
+
+
+}
+}
+#endif
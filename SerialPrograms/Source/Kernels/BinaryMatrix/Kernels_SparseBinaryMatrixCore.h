@@ -8,13 +8,19 @@
 #define PokemonAutomation_Kernels_SparseBinaryMatrixCore_H
 
 #include <string>
-#include <map>
+#include <vector>
+#include <algorithm>
 #include "Kernels_PackedBinaryMatrixCore.h"
 
 namespace PokemonAutomation{
 namespace Kernels{
 
 
+//  Only the tiles that have been touched are stored. They are kept in one
+//  contiguous array sorted by tile index. (row-major)
+//
+//  So memory, copying and merging all scale with the size of the object
+//  rather than the size of the full matrix.
 template <typename TileType>
 class SparseBinaryMatrixCore{
 public:
@@ -34,7 +40,9 @@ public:
     SparseBinaryMatrixCore(size_t width, size_t height);
 
     void clear();
-    void set_data(std::map<TileIndex, TileType> data);
+
+    //  Add a tile. Tiles must be appended in strictly increasing index order.
+    void append(TileIndex index, const TileType& tile);
 
     void operator^=(const SparseBinaryMatrixCore& x);
     void operator|=(const SparseBinaryMatrixCore& x);
@@ -58,6 +66,9 @@ public:
     size_t tile_width() const{ return m_tile_width; }
     size_t tile_height() const{ return m_tile_height; }
 
+    //  # of tiles that are actually stored.
+    size_t stored_tiles() const{ return m_index.size(); }
+
     const TileType& tile(TileIndex index) const;
           TileType& tile(TileIndex index);
     const TileType& tile(size_t x, size_t y) const;
@@ -75,11 +86,22 @@ private:
     static constexpr size_t TILE_WIDTH = TileType::WIDTH;
     static constexpr size_t TILE_HEIGHT = TileType::HEIGHT;
 
+    //  Position of the first stored tile that is not less than "index".
+    size_t lower_bound(TileIndex index) const;
+    TileType& insert(size_t position, TileIndex index);
+
+    template <typename Combine>
+    void merge_union(const SparseBinaryMatrixCore& x, Combine&& combine);
+
+private:
     size_t m_logical_width;
     size_t m_logical_height;
     size_t m_tile_width;
     size_t m_tile_height;
-    std::map<TileIndex, TileType> m_data;
+
+    //  Parallel arrays sorted by index.
+    std::vector<TileIndex> m_index;
+    AlignedVector<TileType> m_tiles;
 
 
     static const TileType& ZERO_TILE();
@@ -96,17 +118,25 @@ private:
 
 //  Tile Access
 
+template <typename Tile> PA_FORCE_INLINE
+size_t SparseBinaryMatrixCore<Tile>::lower_bound(TileIndex index) const{
+    return std::lower_bound(m_index.begin(), m_index.end(), index) - m_index.begin();
+}
 template <typename Tile> PA_FORCE_INLINE
 const Tile& SparseBinaryMatrixCore<Tile>::tile(TileIndex index) const{
-    auto iter = m_data.find(index);
-    if (iter == m_data.end()){
+    size_t position = lower_bound(index);
+    if (position == m_index.size() || m_index[position] != index){
         return ZERO_TILE();
     }
-    return iter->second;
+    return m_tiles[position];
 }
 template <typename Tile> PA_FORCE_INLINE
 Tile& SparseBinaryMatrixCore<Tile>::tile(TileIndex index){
-    return m_data[index];
+    size_t position = lower_bound(index);
+    if (position == m_index.size() || m_index[position] != index){
+        return insert(position, index);
+    }
+    return m_tiles[position];
 }
 template <typename Tile> PA_FORCE_INLINE
 const Tile& SparseBinaryMatrixCore<Tile>::tile(size_t x, size_t y) const{
@@ -7,6 +7,8 @@
 #ifndef PokemonAutomation_Kernels_SparseBinaryMatrixCore_TPP
 #define PokemonAutomation_Kernels_SparseBinaryMatrixCore_TPP
 
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels_SparseBinaryMatrixCore.h"
 
 #include <iostream>
@@ -28,12 +30,14 @@ SparseBinaryMatrixCore<Tile>::SparseBinaryMatrixCore(SparseBinaryMatrixCore&& x)
     , m_logical_height(x.m_logical_height)
     , m_tile_width(x.m_tile_width)
     , m_tile_height(x.m_tile_height)
-    , m_data(std::move(x.m_data))
+    , m_index(std::move(x.m_index))
+    , m_tiles(std::move(x.m_tiles))
 {
     x.m_logical_width = 0;
     x.m_logical_height = 0;
     x.m_tile_width = 0;
     x.m_tile_height = 0;
+    x.m_index.clear();
 }
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator=(SparseBinaryMatrixCore&& x){
@@ -41,11 +45,13 @@ void SparseBinaryMatrixCore<Tile>::operator=(SparseBinaryMatrixCore&& x){
     m_logical_height = x.m_logical_height;
     m_tile_width = x.m_tile_width;
     m_tile_height = x.m_tile_height;
-    m_data = std::move(x.m_data);
+    m_index = std::move(x.m_index);
+    m_tiles = std::move(x.m_tiles);
     x.m_logical_width = 0;
     x.m_logical_height = 0;
     x.m_tile_width = 0;
     x.m_tile_height = 0;
+    x.m_index.clear();
 }
 template <typename Tile>
 SparseBinaryMatrixCore<Tile>::SparseBinaryMatrixCore(const SparseBinaryMatrixCore& x)
@@ -53,7 +59,8 @@ SparseBinaryMatrixCore<Tile>::SparseBinaryMatrixCore(const SparseBinaryMatrixCor
     , m_logical_height(x.m_logical_height)
     , m_tile_width(x.m_tile_width)
     , m_tile_height(x.m_tile_height)
-    , m_data(x.m_data)
+    , m_index(x.m_index)
+    , m_tiles(x.m_tiles)
 {}
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator=(const SparseBinaryMatrixCore& x){
@@ -61,7 +68,8 @@ void SparseBinaryMatrixCore<Tile>::operator=(const SparseBinaryMatrixCore& x){
     m_logical_height = x.m_logical_height;
     m_tile_width = x.m_tile_width;
     m_tile_height = x.m_tile_height;
-    m_data = x.m_data;
+    m_index = x.m_index;
+    m_tiles = x.m_tiles;
 }
 
 
@@ -87,32 +95,92 @@ void SparseBinaryMatrixCore<Tile>::clear(){
     m_logical_height = 0;
     m_tile_width = 0;
     m_tile_height = 0;
-    m_data.clear();
+    m_index.clear();
+    m_tiles.clear();
 }
 template <typename Tile>
-void SparseBinaryMatrixCore<Tile>::set_data(std::map<TileIndex, Tile> data){
-    m_data = std::move(data);
+void SparseBinaryMatrixCore<Tile>::append(TileIndex index, const Tile& tile){
+    if (!m_index.empty() && !(m_index.back() < index)){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Tiles must be appended in increasing order.");
+    }
+    m_index.emplace_back(index);
+    m_tiles.emplace_back(tile);
+}
+template <typename Tile>
+Tile& SparseBinaryMatrixCore<Tile>::insert(size_t position, TileIndex index){
+    //  Slow. Only used by the bit/word setters.
+    m_index.insert(m_index.begin() + position, index);
+    m_tiles.emplace_back();
+    for (size_t c = m_tiles.size() - 1; c > position; c--){
+        m_tiles[c] = m_tiles[c - 1];
+    }
+    Tile& ret = m_tiles[position];
+    ret.set_zero();
+    return ret;
 }
 
+
+//  Merging
+
 template <typename Tile>
-void SparseBinaryMatrixCore<Tile>::operator^=(const SparseBinaryMatrixCore& x){
+template <typename Combine>
+void SparseBinaryMatrixCore<Tile>::merge_union(const SparseBinaryMatrixCore& x, Combine&& combine){
     m_logical_width = std::max(m_logical_width, x.m_logical_width);
     m_logical_height = std::max(m_logical_height, x.m_logical_height);
     m_tile_width = std::max(m_tile_width, x.m_tile_width);
     m_tile_height = std::max(m_tile_height, x.m_tile_height);
-    for (const auto& tile : x.m_data){
-        this->tile(tile.first) ^= tile.second;
+
+    if (x.m_index.empty()){
+        return;
+    }
+
+    //  Fast path: Every tile in "x" goes after the ones already here.
+    if (m_index.empty() || m_index.back() < x.m_index[0]){
+        for (size_t c = 0; c < x.m_index.size(); c++){
+            m_index.emplace_back(x.m_index[c]);
+            m_tiles.emplace_back();
+            combine(m_tiles.back(), x.m_tiles[c]);
+        }
+        return;
+    }
+
+    //  Otherwise do a linear merge of the two sorted lists.
+    std::vector<TileIndex> index;
+    AlignedVector<Tile> tiles;
+    index.reserve(m_index.size() + x.m_index.size());
+    size_t a = 0;
+    size_t b = 0;
+    while (a < m_index.size() || b < x.m_index.size()){
+        if (b == x.m_index.size() || (a < m_index.size() && m_index[a] < x.m_index[b])){
+            index.emplace_back(m_index[a]);
+            tiles.emplace_back(m_tiles[a]);
+            a++;
+            continue;
+        }
+        if (a == m_index.size() || x.m_index[b] < m_index[a]){
+            index.emplace_back(x.m_index[b]);
+            tiles.emplace_back();
+            combine(tiles.back(), x.m_tiles[b]);
+            b++;
+            continue;
+        }
+        index.emplace_back(m_index[a]);
+        tiles.emplace_back(m_tiles[a]);
+        combine(tiles.back(), x.m_tiles[b]);
+        a++;
+        b++;
     }
+    m_index = std::move(index);
+    m_tiles = std::move(tiles);
+}
+
+template <typename Tile>
+void SparseBinaryMatrixCore<Tile>::operator^=(const SparseBinaryMatrixCore& x){
+    merge_union(x, [](Tile& tile, const Tile& other){ tile ^= other; });
 }
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator|=(const SparseBinaryMatrixCore& x){
-    m_logical_width = std::max(m_logical_width, x.m_logical_width);
-    m_logical_height = std::max(m_logical_height, x.m_logical_height);
-    m_tile_width = std::max(m_tile_width, x.m_tile_width);
-    m_tile_height = std::max(m_tile_height, x.m_tile_height);
-    for (const auto& tile : x.m_data){
-        this->tile(tile.first) |= tile.second;
-    }
+    merge_union(x, [](Tile& tile, const Tile& other){ tile |= other; });
 }
 template <typename Tile>
 void SparseBinaryMatrixCore<Tile>::operator&=(const SparseBinaryMatrixCore& x){
@@ -120,9 +188,29 @@ void SparseBinaryMatrixCore<Tile>::operator&=(const SparseBinaryMatrixCore& x){
     m_logical_height = std::max(m_logical_height, x.m_logical_height);
     m_tile_width = std::max(m_tile_width, x.m_tile_width);
     m_tile_height = std::max(m_tile_height, x.m_tile_height);
-    for (const auto& tile : x.m_data){
-        this->tile(tile.first) &= tile.second;
+
+    //  Only tiles that are in both can be non-zero.
+    std::vector<TileIndex> index;
+    AlignedVector<Tile> tiles;
+    size_t a = 0;
+    size_t b = 0;
+    while (a < m_index.size() && b < x.m_index.size()){
+        if (m_index[a] < x.m_index[b]){
+            a++;
+            continue;
+        }
+        if (x.m_index[b] < m_index[a]){
+            b++;
+            continue;
+        }
+        index.emplace_back(m_index[a]);
+        tiles.emplace_back(m_tiles[a]);
+        tiles.back() &= x.m_tiles[b];
+        a++;
+        b++;
     }
+    m_index = std::move(index);
+    m_tiles = std::move(tiles);
 }
 
 
@@ -188,34 +276,48 @@ PackedBinaryMatrixCore<Tile> SparseBinaryMatrixCore<Tile>::submatrix(
 //    cout << "bit_shift_x = " << bit_shift_x << endl;
 //    cout << "bit_shift_y = " << bit_shift_y << endl;
 
-    for (size_t r = 0; r < tile_height; r++){
-        for (size_t c = 0; c < tile_width; c++){
-            //  For tile in the destination matrix, populate it by extracting
-            //  from the 4 tiles that it overlaps in the source.
-            size_t src_x = tile_shift_x + c;
-            size_t src_y = tile_shift_y + r;
-            Tile& tile = ret.tile(c, r);
-
-            //  Upper-left tile is always there.
-            this->tile(src_x, src_y).copy_to_shift_pp(tile, bit_shift_x, bit_shift_y);
-
-            bool shift_x = src_x + 1 < m_tile_width && bit_shift_x != 0;
-            bool shift_y = src_y + 1 < m_tile_height && bit_shift_y != 0;
-
-            //  Upper-right is there only if horizontally misaligned.
-            if (shift_x){
-                this->tile(src_x + 1, src_y).copy_to_shift_np(tile, TILE_WIDTH - bit_shift_x, bit_shift_y);
-            }
-
-            //  Lower-left is there only if vertically misaligned.
-            if (shift_y){
-                this->tile(src_x, src_y + 1).copy_to_shift_pn(tile, bit_shift_x, TILE_HEIGHT - bit_shift_y);
-            }
-
-            //  Lower-right if both horizontally and vertically misaligned.
-            if (shift_x && shift_y){
-                this->tile(src_x + 1, src_y + 1).copy_to_shift_nn(tile, TILE_WIDTH - bit_shift_x, TILE_HEIGHT - bit_shift_y);
-            }
+    //  Rather than visiting every destination tile and looking up the 4 source
+    //  tiles that it overlaps, scatter each stored source tile into the (up to)
+    //  4 destination tiles that it overlaps. Missing source tiles are zero and
+    //  contribute nothing.
+    size_t stop_y = tile_shift_y + tile_height;
+    size_t stop_x = tile_shift_x + tile_width;
+    for (size_t i = lower_bound(TileIndex(0, tile_shift_y)); i < m_index.size(); i++){
+        size_t src_x = m_index[i].x();
+        size_t src_y = m_index[i].y();
+        if (src_y > stop_y){
+            break;
+        }
+        if (src_x < tile_shift_x || src_x > stop_x){
+            continue;
+        }
+        const Tile& source = m_tiles[i];
+
+        //  Position of the source tile relative to the destination.
+        size_t c = src_x - tile_shift_x;
+        size_t r = src_y - tile_shift_y;
+
+        //  Upper-left part of the destination tile (c, r).
+        if (c < tile_width && r < tile_height){
+            source.copy_to_shift_pp(ret.tile(c, r), bit_shift_x, bit_shift_y);
+        }
+
+        bool shift_x = c > 0 && bit_shift_x != 0;
+        bool shift_y = r > 0 && bit_shift_y != 0;
+
+        //  Upper-right part of the tile to the left. (only if horizontally misaligned)
+        if (shift_x && r < tile_height){
+            source.copy_to_shift_np(ret.tile(c - 1, r), TILE_WIDTH - bit_shift_x, bit_shift_y);
+        }
+
+        //  Lower-left part of the tile above. (only if vertically misaligned)
+        if (shift_y && c < tile_width){
+            source.copy_to_shift_pn(ret.tile(c, r - 1), bit_shift_x, TILE_HEIGHT - bit_shift_y);
+        }
+
+        //  Lower-right part of the tile diagonally up-left. (if both are misaligned)
+        if (shift_x && shift_y){
+            source.copy_to_shift_nn(ret.tile(c - 1, r - 1), TILE_WIDTH - bit_shift_x, TILE_HEIGHT - bit_shift_y);
         }
     }
 
@@ -0,0 +1,67 @@
+/*  Image Block Mean
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageBlockMean.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void image_block_mean_Default(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+void image_block_mean_x64_SSE41(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+void image_block_mean_x64_AVX2(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+
+void image_block_mean(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        image_block_mean_x64_AVX2(
+            grid, grid_width, grid_height,
+            image, image_bytes_per_row,
+            width, height
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        image_block_mean_x64_SSE41(
+            grid, grid_width, grid_height,
+            image, image_bytes_per_row,
+            width, height
+        );
+        return;
+    }
+#endif
+    image_block_mean_Default(
+        grid, grid_width, grid_height,
+        image, image_bytes_per_row,
+        width, height
+    );
+}
+
+
+
+}
+}
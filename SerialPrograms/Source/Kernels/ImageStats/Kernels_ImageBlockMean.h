@@ -0,0 +1,46 @@
+/*  Image Block Mean
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Downsample an image into a small grid of block averages.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageBlockMean_H
+#define PokemonAutomation_Kernels_ImageBlockMean_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Largest supported "grid_width". The per-row accumulators live on the stack.
+const size_t IMAGE_BLOCK_MEAN_MAX_GRID_WIDTH = 256;
+
+
+//  Reduce "image" into a "grid_width x grid_height" grid of block averages.
+//
+//  Block (bx, by) covers:
+//      x in [bx * width  / grid_width , (bx + 1) * width  / grid_width )
+//      y in [by * height / grid_height, (by + 1) * height / grid_height)
+//
+//  Each output pixel is the rounded per-channel average of its block.
+//  The alpha channel of the input is ignored. Output alpha is always 255.
+//
+//  Requirements:
+//    - 1 <= grid_width  <= min(width, IMAGE_BLOCK_MEAN_MAX_GRID_WIDTH)
+//    - 1 <= grid_height <= height
+//    - "grid" is tightly packed. (grid_width * sizeof(uint32_t) bytes per row)
+//
+void image_block_mean(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+}
+}
+#endif
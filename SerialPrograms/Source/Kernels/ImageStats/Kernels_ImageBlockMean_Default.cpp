@@ -0,0 +1,28 @@
+/*  Image Block Mean (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_ImageBlockMean_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void image_block_mean_Default(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+){
+    image_block_mean(
+        grid, grid_width, grid_height,
+        image, image_bytes_per_row,
+        width, height,
+        image_block_mean_sum_span_Default
+    );
+}
+
+
+}
+}
@@ -0,0 +1,107 @@
+/*  Image Block Mean Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Arch-independent driver for the block mean kernels. Each arch only
+ *  needs to supply a routine that sums the BGR channels of a run of pixels.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageBlockMean_Routines_H
+#define PokemonAutomation_Kernels_ImageBlockMean_Routines_H
+
+#include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels_ImageBlockMean.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct BlockMeanSums{
+    uint64_t sumB = 0;
+    uint64_t sumG = 0;
+    uint64_t sumR = 0;
+};
+
+
+PA_FORCE_INLINE void image_block_mean_sum_span_Default(
+    BlockMeanSums& sums,
+    const uint32_t* image, size_t count
+){
+    uint64_t sumB = 0;
+    uint64_t sumG = 0;
+    uint64_t sumR = 0;
+    for (size_t c = 0; c < count; c++){
+        uint32_t p = image[c];
+        sumB += p & 0xff;
+        sumG += (p >> 8) & 0xff;
+        sumR += (p >> 16) & 0xff;
+    }
+    sums.sumB += sumB;
+    sums.sumG += sumG;
+    sums.sumR += sumR;
+}
+
+
+//  "SumSpan" has signature:
+//      void(BlockMeanSums& sums, const uint32_t* image, size_t count)
+template <typename SumSpan>
+PA_FORCE_INLINE void image_block_mean(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height,
+    SumSpan&& sum_span
+){
+    if (grid_width == 0 || grid_height == 0){
+        return;
+    }
+    if (grid_width > width || grid_height > height){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Grid is larger than the image.");
+    }
+    if (grid_width > IMAGE_BLOCK_MEAN_MAX_GRID_WIDTH){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Grid width limit exceeded: " + std::to_string(grid_width));
+    }
+
+    //  Column boundaries are the same for every row of blocks.
+    size_t x_bounds[IMAGE_BLOCK_MEAN_MAX_GRID_WIDTH + 1];
+    for (size_t bx = 0; bx <= grid_width; bx++){
+        x_bounds[bx] = bx * width / grid_width;
+    }
+
+    BlockMeanSums sums[IMAGE_BLOCK_MEAN_MAX_GRID_WIDTH];
+
+    for (size_t by = 0; by < grid_height; by++){
+        size_t y0 = by * height / grid_height;
+        size_t y1 = (by + 1) * height / grid_height;
+
+        for (size_t bx = 0; bx < grid_width; bx++){
+            sums[bx] = BlockMeanSums();
+        }
+
+        const uint32_t* row = (const uint32_t*)((const char*)image + y0 * image_bytes_per_row);
+        for (size_t y = y0; y < y1; y++){
+            for (size_t bx = 0; bx < grid_width; bx++){
+                sum_span(sums[bx], row + x_bounds[bx], x_bounds[bx + 1] - x_bounds[bx]);
+            }
+            row = (const uint32_t*)((const char*)row + image_bytes_per_row);
+        }
+
+        size_t rows = y1 - y0;
+        for (size_t bx = 0; bx < grid_width; bx++){
+            uint64_t count = (uint64_t)rows * (x_bounds[bx + 1] - x_bounds[bx]);
+            uint64_t half = count / 2;
+            uint32_t B = (uint32_t)((sums[bx].sumB + half) / count);
+            uint32_t G = (uint32_t)((sums[bx].sumG + half) / count);
+            uint32_t R = (uint32_t)((sums[bx].sumR + half) / count);
+            grid[bx] = 0xff000000 | (R << 16) | (G << 8) | B;
+        }
+        grid += grid_width;
+    }
+}
+
+
+
+}
+}
+#endif
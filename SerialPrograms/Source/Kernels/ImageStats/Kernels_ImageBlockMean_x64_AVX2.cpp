@@ -0,0 +1,65 @@
+/*  Image Block Mean (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels/Kernels_x64_AVX2.h"
+#include "Kernels_ImageBlockMean_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Isolate one channel per pixel and let VPSADBW add up the bytes into
+//  four 64-bit lanes. No widening or horizontal reduction inside the loop.
+PA_FORCE_INLINE void image_block_mean_sum_span_x64_AVX2(
+    BlockMeanSums& sums,
+    const uint32_t* image, size_t count
+){
+    const __m256i MASK = _mm256_set1_epi32(0x000000ff);
+    __m256i sumB = _mm256_setzero_si256();
+    __m256i sumG = _mm256_setzero_si256();
+    __m256i sumR = _mm256_setzero_si256();
+
+    const __m256i* ptr = (const __m256i*)image;
+    size_t lc = count / 8;
+    while (lc--){
+        __m256i p = _mm256_loadu_si256(ptr);
+        sumB = _mm256_add_epi64(sumB, _mm256_sad_epu8(_mm256_and_si256(p, MASK), _mm256_setzero_si256()));
+        sumG = _mm256_add_epi64(sumG, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(p, 8), MASK), _mm256_setzero_si256()));
+        sumR = _mm256_add_epi64(sumR, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(p, 16), MASK), _mm256_setzero_si256()));
+        ptr++;
+    }
+
+    sums.sumB += reduce_add64_x64_AVX2(sumB);
+    sums.sumG += reduce_add64_x64_AVX2(sumG);
+    sums.sumR += reduce_add64_x64_AVX2(sumR);
+
+    count %= 8;
+    if (count){
+        image_block_mean_sum_span_Default(sums, (const uint32_t*)ptr, count);
+    }
+}
+
+
+void image_block_mean_x64_AVX2(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+){
+    image_block_mean(
+        grid, grid_width, grid_height,
+        image, image_bytes_per_row,
+        width, height,
+        image_block_mean_sum_span_x64_AVX2
+    );
+}
+
+
+}
+}
+#endif
@@ -0,0 +1,64 @@
+/*  Image Block Mean (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels_ImageBlockMean_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Isolate one channel per pixel and let PSADBW add up the bytes into
+//  two 64-bit lanes. No widening or horizontal reduction inside the loop.
+PA_FORCE_INLINE void image_block_mean_sum_span_x64_SSE41(
+    BlockMeanSums& sums,
+    const uint32_t* image, size_t count
+){
+    const __m128i MASK = _mm_set1_epi32(0x000000ff);
+    __m128i sumB = _mm_setzero_si128();
+    __m128i sumG = _mm_setzero_si128();
+    __m128i sumR = _mm_setzero_si128();
+
+    const __m128i* ptr = (const __m128i*)image;
+    size_t lc = count / 4;
+    while (lc--){
+        __m128i p = _mm_loadu_si128(ptr);
+        sumB = _mm_add_epi64(sumB, _mm_sad_epu8(_mm_and_si128(p, MASK), _mm_setzero_si128()));
+        sumG = _mm_add_epi64(sumG, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(p, 8), MASK), _mm_setzero_si128()));
+        sumR = _mm_add_epi64(sumR, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(p, 16), MASK), _mm_setzero_si128()));
+        ptr++;
+    }
+
+    sums.sumB += _mm_cvtsi128_si64(sumB) + _mm_extract_epi64(sumB, 1);
+    sums.sumG += _mm_cvtsi128_si64(sumG) + _mm_extract_epi64(sumG, 1);
+    sums.sumR += _mm_cvtsi128_si64(sumR) + _mm_extract_epi64(sumR, 1);
+
+    count %= 4;
+    if (count){
+        image_block_mean_sum_span_Default(sums, (const uint32_t*)ptr, count);
+    }
+}
+
+
+void image_block_mean_x64_SSE41(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+){
+    image_block_mean(
+        grid, grid_width, grid_height,
+        image, image_bytes_per_row,
+        width, height,
+        image_block_mean_sum_span_x64_SSE41
+    );
+}
+
+
+}
+}
+#endif
@@ -27,6 +27,13 @@ namespace Kernels{
         unsigned long index;
         return _BitScanReverse64(&index, x) ? index + 1 : 0;
     }
+    PA_FORCE_INLINE size_t pop_count(uint64_t x){
+        //  Don't use __popcnt64(). It isn't available on all x64 CPUs.
+        x = x - ((x >> 1) & 0x5555555555555555);
+        x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+        return (size_t)((x * 0x0101010101010101) >> 56);
+    }
 }
 }
 #elif __GNUC__
@@ -39,6 +46,9 @@ namespace Kernels{
     PA_FORCE_INLINE size_t bitlength(uint64_t x){
         return x == 0 ? 0 : 64 - __builtin_clzll(x);
     }
+    PA_FORCE_INLINE size_t pop_count(uint64_t x){
+        return __builtin_popcountll(x);
+    }
 }
 }
 #else
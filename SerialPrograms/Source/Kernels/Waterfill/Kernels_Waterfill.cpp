@@ -4,6 +4,7 @@
  *
  */
 
+#include <atomic>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/CpuId/CpuId.h"
 #include "Kernels_Waterfill.h"
@@ -19,6 +20,16 @@ namespace Waterfill{
 
 
 
+std::atomic<bool> WATERFILL_AVX512GF_ENABLED(true);
+
+bool use_Waterfill_AVX512GF(){
+    return CPU_CAPABILITY_CURRENT.OK_19_IceLake && WATERFILL_AVX512GF_ENABLED.load(std::memory_order_relaxed);
+}
+void set_Waterfill_AVX512GF_enabled(bool enabled){
+    WATERFILL_AVX512GF_ENABLED.store(enabled, std::memory_order_relaxed);
+}
+
+
 std::vector<WaterfillObject> find_objects_inplace_64x4_Default      (PackedBinaryMatrix_IB& matrix, size_t min_area);
 std::vector<WaterfillObject> find_objects_inplace_64x8_Default      (PackedBinaryMatrix_IB& matrix, size_t min_area);
 
@@ -38,13 +49,13 @@ std::vector<WaterfillObject> find_objects_inplace(PackedBinaryMatrix_IB& matrix,
 #ifdef PA_ARCH_x86
 #ifdef PA_AutoDispatch_x64_17_Skylake
     case BinaryMatrixType::i64x64_x64_AVX512:
-        if (CPU_CAPABILITY_CURRENT.OK_19_IceLake){
+        if (use_Waterfill_AVX512GF()){
             return find_objects_inplace_64x64_x64_AVX512GF(matrix, min_area);
         }else{
             return find_objects_inplace_64x64_x64_AVX512(matrix, min_area);
         }
     case BinaryMatrixType::i64x32_x64_AVX512:
-        if (CPU_CAPABILITY_CURRENT.OK_19_IceLake){
+        if (use_Waterfill_AVX512GF()){
             return find_objects_inplace_64x32_x64_AVX512GF(matrix, min_area);
         }else{
             return find_objects_inplace_64x32_x64_AVX512(matrix, min_area);
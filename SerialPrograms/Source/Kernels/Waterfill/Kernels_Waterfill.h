@@ -17,6 +17,13 @@ namespace Waterfill{
 
 
 
+//  The AVX512-GF waterfill is used for AVX512 matrices when the processor
+//  level is Ice Lake. The kernel autotuner turns it off on machines where the
+//  plain AVX512 version is faster.
+bool use_Waterfill_AVX512GF();
+void set_Waterfill_AVX512GF_enabled(bool enabled);
+
+
 //  Find all the objects in the matrix. This will destroy "matrix".
 std::vector<WaterfillObject> find_objects_inplace(PackedBinaryMatrix_IB& matrix, size_t min_area);
 
@@ -9,6 +9,8 @@
 
 #include <set>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels/Kernels_BitSet.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix_t.h"
@@ -313,17 +315,16 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
     stats.body_x = tile_x * Tile::WIDTH + bit_x;
     stats.body_y = tile_y * Tile::HEIGHT + bit_y;
 
-    std::unique_ptr<std::map<TileIndex, Tile>> sparse_set;
-    if (keep_object){
-        sparse_set = std::make_unique<std::map<TileIndex, Tile>>();
-    }
+    //  If we're keeping the object, the tiles need to be copied out in order.
+    //  So they are zeroed afterwards instead of here.
+    std::vector<TileIndex> kept_tiles;
 
     while (m_object_tiles.pop(x, y)){
 //        m_dirty_tiles.emplace_back(x, y);
         Tile& recorded_tile = m_object.tile(x, y);
 
-        if (sparse_set){
-            (*sparse_set)[TileIndex{x, y}] = recorded_tile;
+        if (keep_object){
+            kept_tiles.emplace_back(x, y);
         }
 
         // Get sum of (x,y) location of the 1-bits in the tile into (sum_x, sum_y)
@@ -352,7 +353,9 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
         tile_min_y = std::min(tile_min_y, y);
         tile_max_y = std::max(tile_max_y, y);
 
-        recorded_tile.set_zero();
+        if (!keep_object){
+            recorded_tile.set_zero();
+        }
     }
 
 #if 0
@@ -365,9 +368,16 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
 
     object = stats;
 
-    if (sparse_set){
+    if (keep_object){
+        //  Only the tiles of the object are stored. Not the whole matrix.
+        std::sort(kept_tiles.begin(), kept_tiles.end());
         auto ptr = std::make_unique<SparseBinaryMatrix_t<Tile>>(m_source->width(), m_source->height());
-        ptr->get().set_data(std::move(*sparse_set));
+        SparseBinaryMatrixCore<Tile>& matrix = ptr->get();
+        for (TileIndex index : kept_tiles){
+            Tile& recorded_tile = m_object.tile(index);
+            matrix.append(index, recorded_tile);
+            recorded_tile.set_zero();
+        }
         object.object = std::move(ptr);
     }
 
@@ -122,6 +122,9 @@ public:
     uint64_t sum_x = 0;
     uint64_t sum_y = 0;
 
+    //  The bits of this object in the coordinates of the full image.
+    //  Only the tiles that the object touches are stored so the memory, copying
+    //  and merging cost is proportional to the object, not the image.
     std::unique_ptr<SparseBinaryMatrix_IB> object;
 };
 
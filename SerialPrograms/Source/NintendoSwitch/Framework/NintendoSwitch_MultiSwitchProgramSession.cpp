@@ -13,6 +13,7 @@
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
+#include "CommonFramework/Resources/ResourceWarmup.h"
 #include "NintendoSwitch_MultiSwitchProgramOption.h"
 #include "NintendoSwitch_MultiSwitchProgramSession.h"
 
@@ -154,6 +155,7 @@ void MultiSwitchProgramSession::internal_run_program(){
         current_stats_tracker(), historical_stats_tracker(),
         std::move(handles)
     );
+    ResourceWarmup warmup(env.logger(), env.inference_dispatcher(), descriptor().warmup_resources());
 
     try{
         logger().log("<b>Starting Program: " + identifier() + "</b>");
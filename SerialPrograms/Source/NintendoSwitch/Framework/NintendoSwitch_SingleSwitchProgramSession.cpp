@@ -12,6 +12,7 @@
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
+#include "CommonFramework/Resources/ResourceWarmup.h"
 #include "NintendoSwitch_SingleSwitchProgramOption.h"
 #include "NintendoSwitch_SingleSwitchProgramSession.h"
 
@@ -112,6 +113,7 @@ void SingleSwitchProgramSession::internal_run_program(){
         m_system.overlay(),
         m_system.audio()
     );
+    ResourceWarmup warmup(env.logger(), env.inference_dispatcher(), descriptor().warmup_resources());
 
     try{
         logger().log("<b>Starting Program: " + identifier() + "</b>");
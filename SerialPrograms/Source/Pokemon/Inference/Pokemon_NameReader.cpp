@@ -5,6 +5,7 @@
  */
 
 #include "CommonFramework/OCR/OCR_RawOCR.h"
+#include "CommonFramework/Resources/ResourceWarmup.h"
 #include "Pokemon_NameReader.h"
 
 namespace PokemonAutomation{
@@ -12,9 +13,14 @@ namespace Pokemon{
 
 
 const PokemonNameReader& PokemonNameReader::instance(){
+    wait_for_warmup_resource("Pokemon/PokemonNameReader");
     static PokemonNameReader reader;
     return reader;
 }
+[[maybe_unused]] const bool POKEMON_NAME_READER_WARMUP = register_warmup_resource(
+    "Pokemon/PokemonNameReader", 10,
+    []{ PokemonNameReader::instance(); }
+);
 
 
 PokemonNameReader::PokemonNameReader()
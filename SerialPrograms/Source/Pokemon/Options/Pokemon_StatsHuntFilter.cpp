@@ -231,9 +231,9 @@ StatsHuntAction StatsHuntIvJudgeFilterTable::get_action(
     const IvJudgeReader::Results& IVs
 ) const{
     StatsHuntAction action = StatsHuntAction::Discard;
-    std::vector<std::unique_ptr<StatsHuntIvJudgeFilterRow>> list = copy_snapshot();
-    for (size_t c = 0; c < list.size(); c++){
-        const StatsHuntIvJudgeFilterRow& filter = *list[c];
+    std::shared_ptr<const std::vector<std::unique_ptr<const StatsHuntIvJudgeFilterRow>>> list = shared_copy_snapshot();
+    for (size_t c = 0; c < list->size(); c++){
+        const StatsHuntIvJudgeFilterRow& filter = *(*list)[c];
 
         if (!filter.matches(shiny, gender, nature, IVs)){
             continue;
@@ -378,9 +378,9 @@ StatsHuntAction StatsHuntIvRangeFilterTable::get_action(
     const IvRanges& IVs
 ) const{
     StatsHuntAction action = StatsHuntAction::Discard;
-    std::vector<std::unique_ptr<StatsHuntIvRangeFilterRow>> list = copy_snapshot();
-    for (size_t c = 0; c < list.size(); c++){
-        const StatsHuntIvRangeFilterRow& filter = *list[c];
+    std::shared_ptr<const std::vector<std::unique_ptr<const StatsHuntIvRangeFilterRow>>> list = shared_copy_snapshot();
+    for (size_t c = 0; c < list->size(); c++){
+        const StatsHuntIvRangeFilterRow& filter = *(*list)[c];
 
         if (!filter.matches(shiny, gender, nature, IVs)){
             continue;
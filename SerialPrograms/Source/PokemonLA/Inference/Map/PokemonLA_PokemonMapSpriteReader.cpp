@@ -11,6 +11,8 @@
 
 #include "Common/Compiler.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/WorkStealingPool.h"
+#include "CommonFramework/GlobalServices.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/ImageMatch/ImageCropper.h"
 #include "CommonFramework/ImageMatch/ImageDiff.h"
@@ -20,6 +22,8 @@
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageTypes/ImageHSV32.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Resources/BinaryResourceCache.h"
+#include "CommonFramework/Resources/ResourceWarmup.h"
 #include "CommonFramework/Resources/SpriteDatabase.h"
 #include "CommonFramework/Tools/DebugDumper.h"
 #include "PokemonLA_PokemonMapSpriteReader.h"
@@ -56,6 +60,17 @@ const size_t IMAGE_COLOR_MATCH_EXTRA_SIDE_EXT = 2;
 
 const size_t EXTENDED_IMAGE_SIZE = IMAGE_TEMPLATE_SIZE + IMAGE_COLOR_MATCH_EXTRA_SIDE_EXT * 2;
 
+// The gradient matcher only reads the x and y gradients and the alpha of each pixel.
+// Split them into separate planes so that rows can be processed without unpacking
+// pixels or branching on transparency. Transparent pixels have zero gradients and mask.
+struct GradientPlanes{
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<int32_t> gx;
+    std::vector<int32_t> gy;
+    std::vector<int32_t> mask;
+};
+
 // Defined locally stored data for matching MMO sprites:
 // Store data belonging to one sprite
 struct PerSpriteMatchingData{
@@ -67,6 +82,9 @@ struct PerSpriteMatchingData{
     ImageHSV32 hsv_image;
     
     ImageRGB32 gradient_image;
+
+    // Built from gradient_image after loading. Not part of the resource cache.
+    GradientPlanes gradient_planes;
 };
 
 using MMOSpriteMatchingMap = std::map<std::string, PerSpriteMatchingData>;
@@ -75,6 +93,29 @@ inline bool is_transparent(uint32_t g){
     return (g >> 24) < 128;
 }
 
+GradientPlanes make_gradient_planes(const ImageViewRGB32& gradient){
+    GradientPlanes planes;
+    planes.width = gradient.width();
+    planes.height = gradient.height();
+    const size_t size = planes.width * planes.height;
+    planes.gx.resize(size, 0);
+    planes.gy.resize(size, 0);
+    planes.mask.resize(size, 0);
+    for (size_t y = 0; y < planes.height; y++){
+        for (size_t x = 0; x < planes.width; x++){
+            uint32_t g = gradient.pixel(x, y);
+            if (is_transparent(g)){
+                continue;
+            }
+            size_t i = y * planes.width + x;
+            planes.gx[i] = uint32_t(0xff) & (g >> 16);
+            planes.gy[i] = uint32_t(0xff) & (g >> 8);
+            planes.mask[i] = 1;
+        }
+    }
+    return planes;
+}
+
 
 FeatureType feature_distance(const FeatureVector& a, const FeatureVector& b){
     if (a.size() != b.size()){
@@ -391,6 +432,7 @@ MMOSpriteMatchingMap build_MMO_sprite_matching_data(){
 
         ImageRGB32 smoothed_sprite = smooth_image(sprite);
         per_sprite_data.gradient_image = compute_image_gradient(smoothed_sprite);
+        per_sprite_data.gradient_planes = make_gradient_planes(per_sprite_data.gradient_image);
         per_sprite_data.feature = compute_feature(smoothed_sprite);
 
         sprite_map.emplace(slug, std::move(per_sprite_data));
@@ -399,12 +441,66 @@ MMOSpriteMatchingMap build_MMO_sprite_matching_data(){
     return sprite_map;
 }
 
+// Bump this whenever build_MMO_sprite_matching_data() changes.
+const uint32_t MMO_SPRITE_MATCHING_DATA_VERSION = 1;
+
+void write_MMO_sprite_matching_data(BinaryResourceWriter& writer, const MMOSpriteMatchingMap& sprite_map){
+    writer.write<uint64_t>(sprite_map.size());
+    for (const auto& item : sprite_map){
+        const PerSpriteMatchingData& data = item.second;
+        writer.write_string(item.first);
+        writer.write_vector(data.feature);
+        writer.write(data.rgb_stats.average);
+        writer.write(data.rgb_stats.stddev);
+        writer.write(data.rgb_stats.count);
+        writer.write_image(data.hsv_image);
+        writer.write_image(data.gradient_image);
+    }
+}
+MMOSpriteMatchingMap read_MMO_sprite_matching_data(BinaryResourceReader& reader){
+    MMOSpriteMatchingMap sprite_map;
+    uint64_t count = reader.read<uint64_t>();
+    for (uint64_t c = 0; c < count; c++){
+        std::string slug = reader.read_string();
+        PerSpriteMatchingData data;
+        data.feature = reader.read_vector<FeatureType>();
+        data.rgb_stats.average = reader.read<FloatPixel>();
+        data.rgb_stats.stddev = reader.read<FloatPixel>();
+        data.rgb_stats.count = reader.read<uint64_t>();
+        data.hsv_image = reader.read_image<ImageHSV32>();
+        data.gradient_image = reader.read_image<ImageRGB32>();
+        data.gradient_planes = make_gradient_planes(data.gradient_image);
+        sprite_map.emplace(std::move(slug), std::move(data));
+    }
+    return sprite_map;
+}
+
 const MMOSpriteMatchingMap& MMO_SPRITE_MATCHING_DATA(){
-    const static auto& sprite_matching_data = build_MMO_sprite_matching_data();
+    wait_for_warmup_resource("PokemonLA/MMOSpriteMatchingData");
+    const static auto& sprite_matching_data = load_or_build_cached_resource<MMOSpriteMatchingMap>(
+        "PokemonLA/MMOSpriteMatchingData",
+        MMO_SPRITE_MATCHING_DATA_VERSION,
+        hash_resource_file(
+            RESOURCE_PATH() + "PokemonLA/MMOSprites.json",
+            hash_resource_file(RESOURCE_PATH() + "PokemonLA/MMOSprites.png")
+        ),
+        build_MMO_sprite_matching_data,
+        write_MMO_sprite_matching_data,
+        read_MMO_sprite_matching_data
+    );
 
     return sprite_matching_data;
 }
 
+[[maybe_unused]] const bool MMO_SPRITE_MATCHING_DATA_REGISTERED = register_resource_cache_builder(
+    "PokemonLA/MMOSpriteMatchingData",
+    []{ MMO_SPRITE_MATCHING_DATA(); }
+);
+[[maybe_unused]] const bool MMO_SPRITE_MATCHING_DATA_WARMUP = register_warmup_resource(
+    "PokemonLA/MMOSpriteMatchingData", 20,
+    []{ MMO_SPRITE_MATCHING_DATA(); }
+);
+
 
 std::multimap<double, std::string> match_pokemon_map_sprite_feature(const ImageViewRGB32& image, MapRegion region){
     const FeatureVector& image_feature = compute_feature(image);
@@ -734,6 +830,143 @@ double compute_MMO_sprite_gradient_distance(const ImageViewRGB32& gradient_templ
     return score;
 }
 
+
+// Same score as compute_MMO_sprite_gradient_distance() with USE_BLOCK_LEVEL_TRANSLATION.
+//
+// Instead of summing a block around every pixel for every offset, compute the
+// pixel distances for one offset over the whole image, then get all the block
+// sums at once with a sliding window. Pixel distances are integers (scaled by 255),
+// so the block sums are exact and only the final division is in floating point.
+// All the inner loops run over contiguous rows of the planes without branches so
+// the compiler can vectorize them.
+double compute_MMO_sprite_gradient_distance(const GradientPlanes& gradient_template, const GradientPlanes& gradient){
+    const int max_offset = 2;
+    const int block_radius = 5;
+
+    // Largest possible block sum: every pixel in the block at 255 * (255^2 + 255^2).
+    static_assert(
+        uint64_t(2 * block_radius + 1) * (2 * block_radius + 1) * 255 * 255 * 255 * 2 <= UINT32_MAX,
+        "Block sums must fit in 32 bits."
+    );
+
+    const int tempt_width = (int)gradient_template.width;
+    const int tempt_height = (int)gradient_template.height;
+    const int width = (int)gradient.width;
+    const int height = (int)gradient.height;
+    const size_t size = (size_t)width * height;
+
+    std::vector<uint32_t> pixel_dist(size);
+    std::vector<uint32_t> pixel_count(size);
+    std::vector<uint32_t> column_dist(size);
+    std::vector<uint32_t> column_count(size);
+    std::vector<double> min_block_score(size, FLT_MAX);
+
+    for(int oy = -max_offset; oy <= max_offset; oy++){ // offset_y
+        for(int ox = -max_offset; ox <= max_offset; ox++){ // offset_x
+
+            // Pixel distances at this offset. Zero where either side is transparent
+            // or the template is out of bounds.
+            std::fill(pixel_dist.begin(), pixel_dist.end(), 0);
+            std::fill(pixel_count.begin(), pixel_count.end(), 0);
+            const int x_start = std::max(0, -ox);
+            const int x_end = std::min(width, tempt_width - ox);
+            for(int y = 0; y < height; y++){
+                const int ty = y + oy; // template y
+                if (ty < 0 || ty >= tempt_height || x_start >= x_end){
+                    continue;
+                }
+                const size_t row = (size_t)y * width;
+                const size_t tempt_row = (size_t)ty * tempt_width;
+                const int32_t* gx = gradient.gx.data() + row;
+                const int32_t* gy = gradient.gy.data() + row;
+                const int32_t* mask = gradient.mask.data() + row;
+                const int32_t* t_gx = gradient_template.gx.data() + tempt_row;
+                const int32_t* t_gy = gradient_template.gy.data() + tempt_row;
+                const int32_t* t_mask = gradient_template.mask.data() + tempt_row;
+                uint32_t* dist = pixel_dist.data() + row;
+                uint32_t* count = pixel_count.data() + row;
+                for(int x = x_start; x < x_end; x++){
+                    const int tx = x + ox; // template x
+                    int32_t dx = gx[x] - t_gx[tx];
+                    int32_t dy = gy[x] - t_gy[tx];
+                    int32_t pixel_score = std::max(t_gx[tx], gx[x]) * dx * dx + std::max(t_gy[tx], gy[x]) * dy * dy;
+                    int32_t valid = mask[x] & t_mask[tx];
+                    dist[x] = (uint32_t)(pixel_score * valid);
+                    count[x] = (uint32_t)valid;
+                }
+            }
+
+            // Vertical sums over [y - block_radius, y + block_radius].
+            for(int y = 0; y < height; y++){
+                const int y_start = std::max(0, y - block_radius);
+                const int y_end = std::min(height, y + block_radius + 1);
+                uint32_t* dist_out = column_dist.data() + (size_t)y * width;
+                uint32_t* count_out = column_count.data() + (size_t)y * width;
+                std::fill(dist_out, dist_out + width, 0);
+                std::fill(count_out, count_out + width, 0);
+                for(int by = y_start; by < y_end; by++){
+                    const uint32_t* dist = pixel_dist.data() + (size_t)by * width;
+                    const uint32_t* count = pixel_count.data() + (size_t)by * width;
+                    for(int x = 0; x < width; x++){
+                        dist_out[x] += dist[x];
+                        count_out[x] += count[x];
+                    }
+                }
+            }
+
+            // Horizontal sliding window over the column sums gives the block sums.
+            for(int y = 0; y < height; y++){
+                const uint32_t* dist = column_dist.data() + (size_t)y * width;
+                const uint32_t* count = column_count.data() + (size_t)y * width;
+                double* min_score = min_block_score.data() + (size_t)y * width;
+                uint32_t block_dist = 0;
+                uint32_t block_size = 0;
+                for(int x = 0; x < std::min(width, block_radius); x++){
+                    block_dist += dist[x];
+                    block_size += count[x];
+                }
+                for(int x = 0; x < width; x++){
+                    if (x + block_radius < width){
+                        block_dist += dist[x + block_radius];
+                        block_size += count[x + block_radius];
+                    }
+                    if (x - block_radius - 1 >= 0){
+                        block_dist -= dist[x - block_radius - 1];
+                        block_size -= count[x - block_radius - 1];
+                    }
+                    if (block_size == 0){
+                        continue;
+                    }
+                    double block_score = (double)block_dist / 255 / block_size;
+                    min_score[x] = std::min(min_score[x], block_score);
+                }
+            }
+        }
+    } // end offset
+
+    double score = 0;
+    int num_gradients = 0;
+    for(size_t i = 0; i < size; i++){
+        if (gradient.mask[i] == 0 || min_block_score[i] == FLT_MAX){
+            continue;
+        }
+        score += min_block_score[i];
+        num_gradients++;
+    }
+    return std::sqrt(score / num_gradients);
+}
+
+// Gradient distance to every candidate. Each candidate is independent so they run in parallel.
+std::vector<double> compute_MMO_sprite_gradient_distances(
+    const std::vector<const GradientPlanes*>& gradient_templates, const GradientPlanes& gradient
+){
+    std::vector<double> scores(gradient_templates.size());
+    global_compute_pool().parallel_for(0, gradient_templates.size(), 1, [&](size_t i){
+        scores[i] = compute_MMO_sprite_gradient_distance(*gradient_templates[i], gradient);
+    });
+    return scores;
+}
+
 double compute_hsv_dist2(uint32_t template_color, uint32_t color){
     int t_h = (uint32_t(0xff) & (template_color >> 16));
     int t_s = (uint32_t(0xff) & (template_color >> 8));
@@ -924,11 +1157,18 @@ MapSpriteMatchResult match_sprite_on_map(Logger& logger, const ImageViewRGB32& s
     // std::string sprite_filename = os.str();
     // gradient_image.save(sprite_filename);
 
-    for(const auto& p : result.color_match_results){
-        const auto& slug = p.second;
-        ImageViewRGB32 template_gradient = sprite_map.find(slug)->second.gradient_image;
-        double score = compute_MMO_sprite_gradient_distance(template_gradient, gradient_image);
-        result.gradient_match_results.emplace(score, slug);
+    {
+        std::vector<const GradientPlanes*> template_gradients;
+        for(const auto& p : result.color_match_results){
+            template_gradients.emplace_back(&sprite_map.find(p.second)->second.gradient_planes);
+        }
+        std::vector<double> scores = compute_MMO_sprite_gradient_distances(
+            template_gradients, make_gradient_planes(gradient_image)
+        );
+        size_t c = 0;
+        for(const auto& p : result.color_match_results){
+            result.gradient_match_results.emplace(scores[c++], p.second);
+        }
     }
 
     result_count = 0;
@@ -1000,6 +1240,33 @@ MapSpriteMatchResult match_sprite_on_map(Logger& logger, const ImageViewRGB32& s
 }
 
 
+std::map<std::string, std::pair<double, double>> compare_MMO_sprite_gradient_distances(
+    const ImageViewRGB32& screen, const ImagePixelBox& box, MapRegion region
+){
+    const MMOSpriteMatchingMap& sprite_map = MMO_SPRITE_MATCHING_DATA();
+
+    ImageRGB32 gradient_image = compute_MMO_sprite_gradient(extract_box_reference(screen, box));
+    GradientPlanes gradient_planes = make_gradient_planes(gradient_image);
+
+    std::vector<std::string> slugs;
+    std::vector<const GradientPlanes*> template_gradients;
+    for(const auto& p : match_pokemon_map_sprite_feature(extract_box_reference(screen, box), region)){
+        slugs.emplace_back(p.second);
+        template_gradients.emplace_back(&sprite_map.find(p.second)->second.gradient_planes);
+    }
+    std::vector<double> scores = compute_MMO_sprite_gradient_distances(template_gradients, gradient_planes);
+
+    std::map<std::string, std::pair<double, double>> result;
+    for(size_t i = 0; i < slugs.size(); i++){
+        double reference = compute_MMO_sprite_gradient_distance(
+            sprite_map.find(slugs[i])->second.gradient_image, gradient_image
+        );
+        result.emplace(slugs[i], std::make_pair(reference, scores[i]));
+    }
+    return result;
+}
+
+
 
 
 
@@ -55,6 +55,15 @@ MapSpriteMatchResult match_sprite_on_map(
     bool debug_mode = false
 );
 
+// Gradient distance from the sprite in "box" to every sprite available in "region",
+// computed by both the original per-pixel loop and the vectorized matcher that
+// match_sprite_on_map() uses. Returns slug -> (original, vectorized). For testing.
+std::map<std::string, std::pair<double, double>> compare_MMO_sprite_gradient_distances(
+    const ImageViewRGB32& screen,
+    const ImagePixelBox& box,
+    MapRegion region
+);
+
 
 }
 }
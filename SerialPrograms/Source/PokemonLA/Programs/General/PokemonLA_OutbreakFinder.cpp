@@ -173,6 +173,12 @@ public:
 std::unique_ptr<StatsTracker> OutbreakFinder_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<std::string> OutbreakFinder_Descriptor::warmup_resources() const{
+    return {
+        "PokemonLA/MMOSpriteMatchingData",
+        "Pokemon/PokemonNameReader",
+    };
+}
 
 
 
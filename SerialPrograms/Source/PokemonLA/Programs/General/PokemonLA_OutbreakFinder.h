@@ -26,6 +26,7 @@ public:
 
     class Stats;
     virtual std::unique_ptr<StatsTracker> make_stats() const override;
+    virtual std::vector<std::string> warmup_resources() const override;
 };
 
 
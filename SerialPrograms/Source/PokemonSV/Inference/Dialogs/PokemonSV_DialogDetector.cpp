@@ -33,6 +33,13 @@ void DialogBoxDetector::make_overlays(VideoOverlaySet& items) const{
     items.add(m_color, m_border_top);
     items.add(m_color, m_border_bot);
 }
+bool DialogBoxDetector::regions_of_interest(std::vector<ImageFloatBox>& boxes) const{
+    boxes.emplace_back(m_box_top);
+    boxes.emplace_back(m_box_bot);
+    boxes.emplace_back(m_border_top);
+    boxes.emplace_back(m_border_bot);
+    return true;
+}
 bool DialogBoxDetector::detect(const ImageViewRGB32& screen) const{
     ImageStats stats_box_top = image_stats(extract_box_reference(screen, m_box_top));
 //    cout << stats_box_top.average << stats_box_top.stddev << endl;
@@ -91,6 +98,11 @@ void AdvanceDialogDetector::make_overlays(VideoOverlaySet& items) const{
     m_box.make_overlays(items);
     items.add(m_box.color(), m_arrow);
 }
+bool AdvanceDialogDetector::regions_of_interest(std::vector<ImageFloatBox>& boxes) const{
+    m_box.regions_of_interest(boxes);
+    boxes.emplace_back(m_arrow);
+    return true;
+}
 bool AdvanceDialogDetector::detect(const ImageViewRGB32& screen) const{
     if (!m_box.detect(screen)){
         return false;
@@ -114,6 +126,11 @@ void PromptDialogDetector::make_overlays(VideoOverlaySet& items) const{
     m_box.make_overlays(items);
     items.add(m_box.color(), m_gradient);
 }
+bool PromptDialogDetector::regions_of_interest(std::vector<ImageFloatBox>& boxes) const{
+    m_box.regions_of_interest(boxes);
+    boxes.emplace_back(m_gradient);
+    return true;
+}
 bool PromptDialogDetector::detect(const ImageViewRGB32& screen) const{
     if (!m_box.detect(screen)){
         return false;
@@ -32,6 +32,7 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) const override;
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const override;
 
 private:
     Color m_color;
@@ -65,6 +66,7 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) const override;
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const override;
 
 private:
     DialogBoxDetector m_box;
@@ -90,6 +92,7 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) const override;
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const override;
 
 private:
     DialogBoxDetector m_box;
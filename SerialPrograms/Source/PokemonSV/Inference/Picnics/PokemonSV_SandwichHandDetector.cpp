@@ -12,6 +12,8 @@
 #include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
 #include "PokemonSV_SandwichHandDetector.h"
 
+#include <cmath>
+#include <algorithm>
 #include <iostream>
 using std::cout;
 using std::endl;
@@ -123,25 +125,139 @@ std::pair<double, double> SandwichHandLocator::locate_sandwich_hand(const ImageV
 }
 
 
+SandwichHandTracker::SandwichHandTracker()
+    : m_has_location(false)
+    , m_has_velocity(false)
+    , m_location(-1.0, -1.0)
+    , m_velocity(0.0, 0.0)
+    , m_timestamp(WallClock::min())
+{}
+
+void SandwichHandTracker::reset(){
+    m_has_location = false;
+    m_has_velocity = false;
+    m_location = std::make_pair(-1.0, -1.0);
+    m_velocity = std::make_pair(0.0, 0.0);
+    m_timestamp = WallClock::min();
+}
+
+void SandwichHandTracker::update(const std::pair<double, double>& location, WallClock timestamp, bool continuous){
+    if (!continuous || !m_has_location || timestamp == WallClock::min() || m_timestamp == WallClock::min()){
+        m_has_velocity = false;
+        m_velocity = std::make_pair(0.0, 0.0);
+    }else{
+        double time_s = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - m_timestamp).count() / 1000000.0;
+        if (time_s <= 0){
+            // Same frame again. Nothing new to learn.
+            return;
+        }
+        if (time_s > 0.5){
+            // Too old to say anything about the current motion.
+            m_has_velocity = false;
+            m_velocity = std::make_pair(0.0, 0.0);
+        }else{
+            std::pair<double, double> velocity(
+                (location.first - m_location.first) / time_s,
+                (location.second - m_location.second) / time_s
+            );
+            // Smooth out the jitter from the detection.
+            if (m_has_velocity){
+                velocity.first = (velocity.first + m_velocity.first) / 2;
+                velocity.second = (velocity.second + m_velocity.second) / 2;
+            }
+            m_velocity = velocity;
+            m_has_velocity = true;
+        }
+    }
+    m_has_location = true;
+    m_location = location;
+    m_timestamp = timestamp;
+}
+
+bool SandwichHandTracker::predict(WallClock timestamp, ImageFloatBox& window) const{
+    if (!m_has_location){
+        return false;
+    }
+
+    std::pair<double, double> predicted = m_location;
+    double margin_x = 0;
+    double margin_y = 0;
+    if (m_has_velocity && timestamp != WallClock::min() && timestamp > m_timestamp){
+        double time_s = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - m_timestamp).count() / 1000000.0;
+        double move_x = m_velocity.first * time_s;
+        double move_y = m_velocity.second * time_s;
+        predicted.first += move_x;
+        predicted.second += move_y;
+        // The hand accelerates and decelerates with the joystick. Allow for that
+        // in proportion to how far it's predicted to move.
+        margin_x = std::fabs(move_x) / 2;
+        margin_y = std::fabs(move_y) / 2;
+    }
+
+    // Leave half a hand of slack on each side for the prediction error.
+    const double width = HAND_WIDTH * 2 + margin_x * 2;
+    const double height = HAND_HEIGHT * 2 + margin_y * 2;
+    const double min_x = std::max(0.0, predicted.first - width / 2);
+    const double min_y = std::max(0.0, predicted.second - height / 2);
+    const double max_x = std::min(1.0, predicted.first + width / 2);
+    const double max_y = std::min(1.0, predicted.second + height / 2);
+    if (max_x <= min_x || max_y <= min_y){
+        return false;
+    }
+    window = ImageFloatBox(min_x, min_y, max_x - min_x, max_y - min_y);
+    return true;
+}
+
+
 SandwichHandWatcher::SandwichHandWatcher(
     HandType hand_type,
     const ImageFloatBox& box,
     Color color
-): VisualInferenceCallback("SandwichHandWatcher"), m_locator(hand_type, box, color), m_location(-1.0, -1.0) {}
+): VisualInferenceCallback("SandwichHandWatcher"), m_locator(hand_type, box, color), m_location(-1.0, -1.0), m_tracking(false) {
+    //  The hand is being steered by the program as it moves.
+    set_time_critical();
+}
 
 void SandwichHandWatcher::make_overlays(VideoOverlaySet& items) const{
     m_locator.make_overlays(items);
 }
 
+void SandwichHandWatcher::set_tracking(bool enabled){
+    m_tracking = enabled;
+    m_tracker.reset();
+}
+
 bool SandwichHandWatcher::process_frame(const VideoSnapshot& frame){
     m_last_snapshot = frame;
+
+    if (m_tracking){
+        ImageFloatBox window;
+        if (m_tracker.predict(frame.timestamp, window)){
+            std::pair<double, double> location = m_locator.locate_sandwich_hand(frame, window);
+            if (location.first >= 0.0){
+                m_location = location;
+                m_tracker.update(m_location, frame.timestamp, true);
+                return true;
+            }
+        }
+    }
+
     m_location = m_locator.detect(frame);
+    if (m_tracking){
+        if (m_location.first >= 0.0){
+            m_tracker.update(m_location, frame.timestamp, false);
+        }else{
+            m_tracker.reset();
+        }
+    }
     return m_location.first >= 0.0;
 }
 
 bool SandwichHandWatcher::recover_sandwich_hand_position(const ImageViewRGB32& frame){
     ImageFloatBox entire_screen(0.0, 0.0, 1.0, 1.0);
     m_location = m_locator.locate_sandwich_hand(frame, entire_screen);
+    // The hand was moved without being watched. Start over from here.
+    m_tracker.reset();
     return m_location.first >= 0.0;
 }
 
@@ -53,6 +53,38 @@ private:
     Color m_color;
 };
 
+// Track the hand across frames to predict where it will be in the next frame.
+// The locator can then search a small window around the prediction instead of
+// the whole box.
+class SandwichHandTracker{
+public:
+    // Approximate size of the hand on screen.
+    static constexpr double HAND_WIDTH = 0.071;
+    static constexpr double HAND_HEIGHT = 0.106;
+
+    SandwichHandTracker();
+
+    // Forget all history. Used when the hand is lost.
+    void reset();
+
+    // Record a detection. If "continuous" is false, the hand was found by a full
+    // search after the window missed. Its motion since the last detection is not
+    // meaningful, so only the location is kept.
+    void update(const std::pair<double, double>& location, WallClock timestamp, bool continuous);
+
+    // Return the window to search for a frame taken at "timestamp".
+    // Return false if there isn't enough history to predict.
+    bool predict(WallClock timestamp, ImageFloatBox& window) const;
+
+private:
+    bool m_has_location;
+    bool m_has_velocity;
+    std::pair<double, double> m_location;
+    // Screen-relative units per second.
+    std::pair<double, double> m_velocity;
+    WallClock m_timestamp;
+};
+
 class SandwichHandWatcher : public VisualInferenceCallback{
 public:
     using HandType = SandwichHandType;
@@ -68,6 +100,10 @@ public:
 
     void change_box(const ImageFloatBox& new_box) { m_locator.change_box(new_box); }
 
+    // If enabled, first search a small window around where the hand is predicted
+    // to be, then fall back to the box and then the entire screen.
+    void set_tracking(bool enabled);
+
     // - searches the whole screen for the sandwich hand,
     // - then updates its location
     // - return true if hand successfully found
@@ -78,6 +114,8 @@ private:
     SandwichHandLocator m_locator;
     std::pair<double, double> m_location;
     VideoSnapshot m_last_snapshot;
+    bool m_tracking;
+    SandwichHandTracker m_tracker;
 };
 
 
@@ -831,8 +831,8 @@ void ItemPrinterRNG::run_item_printer_rng(
     for (uint32_t c = 0; c < NUM_ITEM_PRINTER_ROUNDS; c++){
         send_program_status_notification(env, NOTIFICATION_STATUS_UPDATE);
 
-        std::vector<ItemPrinterRngRowSnapshot> table = DATE_SEED_TABLE.snapshot<ItemPrinterRngRowSnapshot>();
-        for (const ItemPrinterRngRowSnapshot& row : table){
+        std::shared_ptr<const std::vector<ItemPrinterRngRowSnapshot>> table = DATE_SEED_TABLE.shared_snapshot<ItemPrinterRngRowSnapshot>();
+        for (const ItemPrinterRngRowSnapshot& row : *table){
             //  Cannot run material farmer between chained prints.
             if (row.chain){
                 print_again(env, context, row.jobs);
@@ -255,7 +255,7 @@ ImageFloatBox expand_box(const ImageFloatBox& box){
 }
 
 ImageFloatBox hand_location_to_box(const std::pair<double, double>& loc){
-    const double hand_width = 0.071, hand_height = 0.106;
+    const double hand_width = SandwichHandTracker::HAND_WIDTH, hand_height = SandwichHandTracker::HAND_HEIGHT;
     return {loc.first - hand_width/2, loc.second - hand_height/2, hand_width, hand_height};
 }
 
@@ -357,6 +357,9 @@ ImageFloatBox move_sandwich_hand(
     uint8_t joystick_y = 128;
 
     SandwichHandWatcher hand_watcher(hand_type, start_box);
+    // Search around where the hand is heading first. This keeps the per-frame cost
+    // low so the controller below gets location updates more often.
+    hand_watcher.set_tracking(true);
 
     // A session that creates a new thread to send button commands to controller
     AsyncCommandSession move_session(context, console.logger(), dispatcher, console.botbase());
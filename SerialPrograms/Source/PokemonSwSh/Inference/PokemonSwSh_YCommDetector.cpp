@@ -36,6 +36,11 @@ void YCommMenuDetector::make_overlays(VideoOverlaySet& items) const{
     items.add(COLOR_RED, m_top);
     items.add(COLOR_RED, m_bottom);
 }
+bool YCommMenuDetector::regions_of_interest(std::vector<ImageFloatBox>& boxes) const{
+    boxes.emplace_back(m_top);
+    boxes.emplace_back(m_bottom);
+    return true;
+}
 
 bool YCommMenuDetector::detect(const ImageViewRGB32& screen){
     ImageStats bottom = image_stats(extract_box_reference(screen, m_bottom));
@@ -97,6 +102,10 @@ YCommIconDetector::YCommIconDetector(bool is_on)
 void YCommIconDetector::make_overlays(VideoOverlaySet& items) const{
     items.add(COLOR_RED, YCOMM_ICON_BOX);
 }
+bool YCommIconDetector::regions_of_interest(std::vector<ImageFloatBox>& boxes) const{
+    boxes.emplace_back(YCOMM_ICON_BOX);
+    return true;
+}
 
 bool YCommIconDetector::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
 
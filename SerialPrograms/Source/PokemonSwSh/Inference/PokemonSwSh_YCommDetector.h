@@ -25,6 +25,7 @@ public:
     bool detect(const ImageViewRGB32& screen);
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override final;
 
 private:
@@ -42,6 +43,7 @@ public:
     YCommIconDetector(bool is_on);
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
+    virtual bool regions_of_interest(std::vector<ImageFloatBox>& boxes) const override;
 
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override final;
 
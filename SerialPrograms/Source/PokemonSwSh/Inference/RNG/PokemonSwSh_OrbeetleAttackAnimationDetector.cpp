@@ -20,13 +20,53 @@ namespace PokemonAutomation{
 namespace NintendoSwitch{
 namespace PokemonSwSh{
 
+
+const ImageFloatBox OrbeetleAttackAnimationDetector::BOX(0.86, 0.2, 0.1, 0.15);
+
+
 OrbeetleAttackAnimationDetector::OrbeetleAttackAnimationDetector(ConsoleHandle& console, BotBaseContext& context)
     : m_console(console)
     , m_context(context)
-    , m_box(console, {0.86, 0.2, 0.1, 0.15})
+    , m_box(console, BOX)
 {}
 
 
+OrbeetleAttackAnimationDetector::Detection OrbeetleAttackAnimationDetector::classify(
+    const ImageViewRGB32& baseline, const ImageViewRGB32& animation,
+    Logger* logger
+){
+    FloatPixel baseline_values = image_average(extract_box_reference(baseline, BOX));
+    FloatPixel baseline_ratios = baseline_values / baseline_values.sum();
+    FloatPixel animation_values = image_average(extract_box_reference(animation, BOX));
+    FloatPixel animation_ratios = animation_values / animation_values.sum();
+
+    if (logger){
+        logger->log("Orbeetle baseline value red: " + std::to_string(baseline_values.r));
+        logger->log("Orbeetle attack value red: " + std::to_string(animation_values.r));
+        logger->log("Orbeetle baseline value green: " + std::to_string(baseline_values.g));
+        logger->log("Orbeetle attack value green: " + std::to_string(animation_values.g));
+        logger->log("Orbeetle baseline value blue: " + std::to_string(baseline_values.b));
+        logger->log("Orbeetle attack value blue: " + std::to_string(animation_values.b));
+
+        logger->log("Orbeetle baseline ratio red: " + std::to_string(baseline_ratios.r));
+        logger->log("Orbeetle attack ratio red: " + std::to_string(animation_ratios.r));
+        logger->log("Orbeetle baseline ratio green: " + std::to_string(baseline_ratios.g));
+        logger->log("Orbeetle attack ratio green: " + std::to_string(animation_ratios.g));
+        logger->log("Orbeetle baseline ratio blue: " + std::to_string(baseline_ratios.b));
+        logger->log("Orbeetle attack ratio blue: " + std::to_string(animation_ratios.b));
+    }
+
+    if ((animation_ratios.r >= 1.4 * baseline_ratios.r)
+//        && (animation_ratios.g <= 0.85 * baseline_ratios.g)
+//        && (animation_ratios.b <= 0.85 * baseline_ratios.b)
+        )
+    {
+        return Detection::SPECIAL;
+    }
+    return Detection::PHYSICAL;
+}
+
+
 OrbeetleAttackAnimationDetector::Detection OrbeetleAttackAnimationDetector::run(bool save_screenshot, bool log_values)
 {
     //  Grab baseline image.
@@ -41,9 +81,6 @@ OrbeetleAttackAnimationDetector::Detection OrbeetleAttackAnimationDetector::run(
         dump_debug_image(m_console.logger(), "rng", "orbeetle-baseline", baseline_image);
     }
 
-    FloatPixel baseline_values = image_average(extract_box_reference(baseline_image, m_box));
-    FloatPixel baseline_ratios = baseline_values / baseline_values.sum();
-
 
     //  Play the attack animation.
     pbf_press_button(m_context, BUTTON_RCLICK, 10, 155);
@@ -57,30 +94,11 @@ OrbeetleAttackAnimationDetector::Detection OrbeetleAttackAnimationDetector::run(
         return Detection::NO_DETECTION;
     }
 
-    FloatPixel animation_values = image_average(extract_box_reference(animation_image, m_box));
-    FloatPixel animation_ratios = animation_values / animation_values.sum();
-
-    if (log_values){
-        m_console.log("Orbeetle baseline value red: " + std::to_string(baseline_values.r));
-        m_console.log("Orbeetle attack value red: " + std::to_string(animation_values.r));
-        m_console.log("Orbeetle baseline value green: " + std::to_string(baseline_values.g));
-        m_console.log("Orbeetle attack value green: " + std::to_string(animation_values.g));
-        m_console.log("Orbeetle baseline value blue: " + std::to_string(baseline_values.b));
-        m_console.log("Orbeetle attack value blue: " + std::to_string(animation_values.b));
-
-        m_console.log("Orbeetle baseline ratio red: " + std::to_string(baseline_ratios.r));
-        m_console.log("Orbeetle attack ratio red: " + std::to_string(animation_ratios.r));
-        m_console.log("Orbeetle baseline ratio green: " + std::to_string(baseline_ratios.g));
-        m_console.log("Orbeetle attack ratio green: " + std::to_string(animation_ratios.g));
-        m_console.log("Orbeetle baseline ratio blue: " + std::to_string(baseline_ratios.b));
-        m_console.log("Orbeetle attack ratio blue: " + std::to_string(animation_ratios.b));
-    }
-
-    if ((animation_ratios.r >= 1.4 * baseline_ratios.r)
-//        && (animation_ratios.g <= 0.85 * baseline_ratios.g)
-//        && (animation_ratios.b <= 0.85 * baseline_ratios.b)
-        )
-    {
+    Detection detection = classify(
+        baseline_image, animation_image,
+        log_values ? &m_console.logger() : nullptr
+    );
+    if (detection == Detection::SPECIAL){
         if (save_screenshot){
             //animation_image->save("orbeetle-attack-special-" + now_to_filestring() + ".png");
             dump_debug_image(m_console.logger(), "rng", "orbeetle-special", animation_image);
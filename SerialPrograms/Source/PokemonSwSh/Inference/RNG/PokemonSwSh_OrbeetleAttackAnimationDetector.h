@@ -14,6 +14,8 @@
 #include "CommonFramework/Tools/ConsoleHandle.h"
 
 namespace PokemonAutomation{
+class Logger;
+class ImageViewRGB32;
 class BotBaseContext;
 class ProgramEnvironment;
 namespace NintendoSwitch{
@@ -33,6 +35,16 @@ public:
 
     Detection run(bool save_screenshot, bool log_values);
 
+    //  Compare the frame before the attack against the frame during it.
+    //  The 1.4x threshold was tuned on single snapshots, so both must be
+    //  single frames. Logs the colors if "logger" isn't null.
+    static Detection classify(
+        const ImageViewRGB32& baseline, const ImageViewRGB32& animation,
+        Logger* logger = nullptr
+    );
+
+    static const ImageFloatBox BOX;
+
 
 private:
     ConsoleHandle& m_console;
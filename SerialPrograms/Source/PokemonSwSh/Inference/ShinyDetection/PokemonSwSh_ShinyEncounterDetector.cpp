@@ -38,7 +38,13 @@ ShinyEncounterTracker::ShinyEncounterTracker(
     , m_battle_menu(battle_settings.den)
     , m_dialog_tracker(logger, m_dialog_detector)
     , m_sparkle_tracker(logger, overlay, m_sparkles, battle_settings.detection_box)
-{}
+{
+    //  Frames come in back-to-back, so only the parts that are changing
+    //  need to be searched for sparkles.
+    if (GameSettings::instance().SPARKLE_HEAT_MAP){
+        m_sparkles.set_heat_map(&m_heat_map);
+    }
+}
 void ShinyEncounterTracker::make_overlays(VideoOverlaySet& items) const{
     m_battle_menu.make_overlays(items);
     m_dialog_tracker.make_overlays(items);
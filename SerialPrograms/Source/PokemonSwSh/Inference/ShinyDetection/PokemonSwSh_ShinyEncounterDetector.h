@@ -62,6 +62,7 @@ private:
     BattleDialogDetector m_dialog_detector;
     EncounterDialogTracker m_dialog_tracker;
 
+    SparkleHeatMap m_heat_map;
     ShinySparkleSetSwSh m_sparkles;
     ShinySparkleTracker m_sparkle_tracker;
 
@@ -85,57 +85,80 @@ void ShinySparkleSetSwSh::update_alphas(){
 
 
 
-ShinySparkleSetSwSh find_sparkles(WaterfillSession& session){
-    ShinySparkleSetSwSh sparkles;
+//  Add the sparkles found by "session" to "sparkles". The session's source is
+//  at (offset_x, offset_y) in the image.
+void find_sparkles(ShinySparkleSetSwSh& sparkles, WaterfillSession& session, size_t offset_x, size_t offset_y){
     auto finder = session.make_iterator(20);
     WaterfillObject object;
     while (finder->find_next(object, true)){
+        ImagePixelBox box(
+            object.min_x + offset_x, object.min_y + offset_y,
+            object.max_x + offset_x, object.max_y + offset_y
+        );
         RadialSparkleDetector radial_sparkle(object);
         if (radial_sparkle.is_ball()){
-            sparkles.balls.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
+            sparkles.balls.emplace_back(box);
             continue;
         }
         if (radial_sparkle.is_star()){
-            sparkles.stars.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
+            sparkles.stars.emplace_back(box);
             continue;
         }
         if (is_line_sparkle(object)){
-            sparkles.lines.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
+            sparkles.lines.emplace_back(box);
             continue;
         }
         if (is_square_sparkle(object)){
-            sparkles.squares.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
+            sparkles.squares.emplace_back(box);
             continue;
         }
     }
-    return sparkles;
 }
 void ShinySparkleSetSwSh::read_from_image(const ImageViewRGB32& image){
     clear();
     if (!image){
         return;
     }
-
-    std::vector<PackedBinaryMatrix> matrices = compress_rgb32_to_binary_range(
-        image,
-        {
-            {0xffa0a000, 0xffffffff},
-            {0xffb0b000, 0xffffffff},
-            {0xffc0c000, 0xffffffff},
-            {0xffd0d000, 0xffffffff},
-        }
-    );
+    if (m_heat_map == nullptr){
+        read_from_regions(image, {ImagePixelBox(0, 0, image.width(), image.height())});
+    }else{
+        read_from_regions(image, m_heat_map->push_frame(image));
+    }
+}
+void ShinySparkleSetSwSh::read_from_regions(const ImageViewRGB32& image, const std::vector<ImagePixelBox>& regions){
+    //  One set per filter. Each is the union over all the regions.
+    const size_t FILTERS = 4;
+    ShinySparkleSetSwSh sparkles[FILTERS];
     auto session = make_WaterfillSession();
+    for (const ImagePixelBox& region : regions){
+        std::vector<PackedBinaryMatrix> matrices = compress_rgb32_to_binary_range(
+            extract_box_reference(image, region),
+            {
+                {0xffa0a000, 0xffffffff},
+                {0xffb0b000, 0xffffffff},
+                {0xffc0c000, 0xffffffff},
+                {0xffd0d000, 0xffffffff},
+            }
+        );
+        for (size_t c = 0; c < FILTERS; c++){
+            session->set_source(matrices[c]);
+            find_sparkles(sparkles[c], *session, region.min_x, region.min_y);
+        }
+    }
 
     double best_alpha = 0;
-    for (PackedBinaryMatrix& matrix : matrices){
-        session->set_source(matrix);
-        ShinySparkleSetSwSh sparkles = find_sparkles(*session);
-        sparkles.update_alphas();
-        double alpha = sparkles.alpha_overall();
+    for (ShinySparkleSetSwSh& item : sparkles){
+        item.update_alphas();
+        double alpha = item.alpha_overall();
         if (best_alpha < alpha){
             best_alpha = alpha;
-            *this = std::move(sparkles);
+            balls = std::move(item.balls);
+            stars = std::move(item.stars);
+            squares = std::move(item.squares);
+            lines = std::move(item.lines);
+            m_alpha_overall = item.m_alpha_overall;
+            m_alpha_star = item.m_alpha_star;
+            m_alpha_square = item.m_alpha_square;
         }
     }
 }
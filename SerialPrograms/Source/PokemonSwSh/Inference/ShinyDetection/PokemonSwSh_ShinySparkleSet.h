@@ -9,6 +9,7 @@
 
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "Pokemon/Pokemon_ShinySparkleSet.h"
+#include "PokemonSwSh_SparkleHeatMap.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -33,6 +34,11 @@ public:
     virtual std::string to_str() const override;
     virtual void read_from_image(const ImageViewRGB32& image) override;
 
+    //  If set, read_from_image() assumes it's being called on consecutive
+    //  frames of the same box. It only analyzes the regions that "heat_map"
+    //  marks as hot. Pass nullptr to go back to analyzing the whole image.
+    void set_heat_map(SparkleHeatMap* heat_map){ m_heat_map = heat_map; }
+
     virtual void draw_boxes(
         VideoOverlaySet& overlays,
         const ImageViewRGB32& frame,
@@ -41,6 +47,9 @@ public:
 
 private:
     void update_alphas();
+    void read_from_regions(const ImageViewRGB32& image, const std::vector<ImagePixelBox>& regions);
+
+    SparkleHeatMap* m_heat_map = nullptr;
 
     double m_alpha_overall = 0;
     double m_alpha_star = 0;
@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <set>
+#include "Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixView.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "CommonFramework/ImageTools/WaterfillUtilities.h"
@@ -100,22 +101,21 @@ bool RadialSparkleDetector::is_ball() const{
     }
 
     //  Verify that all live pixels are near the diagonals.
-    for (size_t r = 0; r < height; r++){
-        for (size_t c = 0; c < width; c++){
-            if (!m_matrix.get(c, r)){
-                continue;
-            }
-            double distance = std::sqrt(center_x*center_x + center_y*center_y);
-            ptrdiff_t dist_x = std::abs((ptrdiff_t)c - center_x);
-            ptrdiff_t dist_y = std::abs((ptrdiff_t)r - center_y);
-            ptrdiff_t dist = std::abs(dist_y - dist_x);
-            if (dist > 2 + distance / 5.){
-                return false;
-            }
+    return Kernels::visit_matrix((const Kernels::PackedBinaryMatrix_IB&)m_matrix, [&](auto view){
+        bool ok = true;
+        for (size_t r = 0; r < height && ok; r++){
+            Kernels::for_each_set_bit_in_row(view, r, [&](size_t c, size_t){
+                double distance = std::sqrt(center_x*center_x + center_y*center_y);
+                ptrdiff_t dist_x = std::abs((ptrdiff_t)c - center_x);
+                ptrdiff_t dist_y = std::abs((ptrdiff_t)r - center_y);
+                ptrdiff_t dist = std::abs(dist_y - dist_x);
+                if (dist > 2 + distance / 5.){
+                    ok = false;
+                }
+            });
         }
-    }
-
-    return true;
+        return ok;
+    });
 }
 bool RadialSparkleDetector::is_star() const{
     //  Fewer than 5 regions, cannot be a star.
@@ -0,0 +1,164 @@
+/*  Sparkle Heat Map
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "PokemonSwSh_SparkleHeatMap.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+
+
+namespace{
+
+//  Same as the loosest filter in ShinySparkleSetSwSh::read_from_image().
+//  {0xffa0a000, 0xffffffff}
+PA_FORCE_INLINE uint8_t passes_sparkle_filter(uint32_t pixel){
+    //  No short-circuiting so that the row loop vectorizes.
+    return ((pixel >> 24) == 0xff) & (((pixel >> 16) & 0xff) >= 0xa0) & (((pixel >> 8) & 0xff) >= 0xa0);
+}
+
+PA_FORCE_INLINE const uint32_t* row_pointer(const ImageViewRGB32& image, size_t row){
+    return (const uint32_t*)((const char*)image.data() + row * image.bytes_per_row());
+}
+
+//  Update one row of pixels. Returns non-zero if any pixel is hot.
+uint8_t update_row(uint8_t* state, const uint32_t* pixels, size_t width){
+    uint8_t any = 0;
+    for (size_t c = 0; c < width; c++){
+        uint8_t s = state[c];
+        uint8_t current = passes_sparkle_filter(pixels[c]);
+        uint8_t heat = s >> 1;
+        heat = heat > SparkleHeatMap::DECAY ? heat - SparkleHeatMap::DECAY : 0;
+        heat = (s & 1) != current ? SparkleHeatMap::HEAT_MAX : heat;
+        state[c] = (uint8_t)(heat << 1) | current;
+        any |= heat;
+    }
+    return any;
+}
+
+}
+
+
+
+void SparkleHeatMap::clear(){
+    m_width = 0;
+    m_height = 0;
+    m_blocks_x = 0;
+    m_blocks_y = 0;
+    m_state.clear();
+    m_hot.clear();
+}
+
+std::vector<ImagePixelBox> SparkleHeatMap::push_frame(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    if (width == 0 || height == 0){
+        clear();
+        return {};
+    }
+    if (width != m_width || height != m_height){
+        m_width = width;
+        m_height = height;
+        m_blocks_x = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        m_blocks_y = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        m_state.assign(width * height, 0);
+        m_hot.assign(m_blocks_x * m_blocks_y, 0);
+        for (size_t r = 0; r < height; r++){
+            update_row(m_state.data() + r * width, row_pointer(image, r), width);
+        }
+        return {ImagePixelBox(0, 0, width, height)};
+    }
+
+    //  Update the heat of every pixel and mark the hot blocks.
+    std::fill(m_hot.begin(), m_hot.end(), 0);
+    for (size_t r = 0; r < height; r++){
+        uint8_t* state = m_state.data() + r * width;
+        const uint32_t* pixels = row_pointer(image, r);
+        uint8_t* hot = m_hot.data() + (r / BLOCK_SIZE) * m_blocks_x;
+        for (size_t bx = 0; bx < m_blocks_x; bx++){
+            size_t start = bx * BLOCK_SIZE;
+            size_t length = std::min(BLOCK_SIZE, width - start);
+            hot[bx] |= update_row(state + start, pixels + start, length);
+        }
+    }
+
+    //  Group hot blocks into regions. Pad each by one block so that sparkles
+    //  that are only partly hot are still seen whole.
+    std::vector<ImagePixelBox> regions;
+    std::vector<uint8_t> visited(m_hot.size(), 0);
+    std::vector<size_t> stack;
+    for (size_t start = 0; start < m_hot.size(); start++){
+        if (!m_hot[start] || visited[start]){
+            continue;
+        }
+        size_t min_bx = m_blocks_x, min_by = m_blocks_y, max_bx = 0, max_by = 0;
+        visited[start] = 1;
+        stack.emplace_back(start);
+        while (!stack.empty()){
+            size_t index = stack.back();
+            stack.pop_back();
+            size_t bx = index % m_blocks_x;
+            size_t by = index / m_blocks_x;
+            min_bx = std::min(min_bx, bx);
+            min_by = std::min(min_by, by);
+            max_bx = std::max(max_bx, bx);
+            max_by = std::max(max_by, by);
+
+            //  Hot blocks within 2 of each other would have overlapping
+            //  padding, so treat them as connected.
+            size_t y0 = by < 2 ? 0 : by - 2;
+            size_t x0 = bx < 2 ? 0 : bx - 2;
+            size_t y1 = std::min(by + 3, m_blocks_y);
+            size_t x1 = std::min(bx + 3, m_blocks_x);
+            for (size_t y = y0; y < y1; y++){
+                for (size_t x = x0; x < x1; x++){
+                    size_t neighbor = y * m_blocks_x + x;
+                    if (m_hot[neighbor] && !visited[neighbor]){
+                        visited[neighbor] = 1;
+                        stack.emplace_back(neighbor);
+                    }
+                }
+            }
+        }
+        min_bx = min_bx == 0 ? 0 : min_bx - 1;
+        min_by = min_by == 0 ? 0 : min_by - 1;
+        max_bx = std::min(max_bx + 2, m_blocks_x);
+        max_by = std::min(max_by + 2, m_blocks_y);
+        regions.emplace_back(
+            min_bx * BLOCK_SIZE, min_by * BLOCK_SIZE,
+            std::min(max_bx * BLOCK_SIZE, width), std::min(max_by * BLOCK_SIZE, height)
+        );
+    }
+
+    //  Bounding boxes of separate groups can still overlap. Merge them so that
+    //  nothing gets counted twice.
+    bool merged = true;
+    while (merged){
+        merged = false;
+        for (size_t i = 0; i < regions.size() && !merged; i++){
+            for (size_t j = i + 1; j < regions.size(); j++){
+                if (!regions[i].overlaps_with(regions[j])){
+                    continue;
+                }
+                regions[i].merge_with(regions[j]);
+                regions.erase(regions.begin() + j);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    return regions;
+}
+
+
+
+}
+}
+}
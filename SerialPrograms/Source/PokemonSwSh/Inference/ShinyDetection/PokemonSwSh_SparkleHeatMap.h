@@ -0,0 +1,67 @@
+/*  Sparkle Heat Map
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Per-pixel activity of the sparkle color filter over consecutive frames.
+ *
+ *  A pixel becomes hot whenever it enters or leaves the loosest sparkle filter.
+ *  After that it cools down a bit every frame. Sparkles flicker and move, so
+ *  their area stays hot while they're on screen. Most of the battle scene is
+ *  static and goes cold within a few frames.
+ *
+ *  The shape analysis then only needs to run on the hot regions instead of
+ *  the whole box.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSwSh_SparkleHeatMap_H
+#define PokemonAutomation_PokemonSwSh_SparkleHeatMap_H
+
+#include <stdint.h>
+#include <vector>
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+    class ImageViewRGB32;
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+
+
+class SparkleHeatMap{
+public:
+    //  Hot regions are made of blocks of this many pixels on each side.
+    static constexpr size_t BLOCK_SIZE = 32;
+    static constexpr uint8_t HEAT_MAX = 127;
+    //  Heat lost per frame. A pixel stays hot for 8 frames after its last change.
+    static constexpr uint8_t DECAY = 16;
+
+public:
+    void clear();
+
+    //  Update the heat map with the next frame and return the regions that
+    //  need to be analyzed. The regions don't overlap.
+    //  If the frame size changes, the history is dropped and the whole frame
+    //  is hot.
+    std::vector<ImagePixelBox> push_frame(const ImageViewRGB32& image);
+
+
+private:
+    size_t m_width = 0;
+    size_t m_height = 0;
+    size_t m_blocks_x = 0;
+    size_t m_blocks_y = 0;
+
+    //  Per pixel. Bit 0 is whether it passed the filter last frame. The
+    //  rest is the heat.
+    std::vector<uint8_t> m_state;
+
+    //  Per block. Whether any pixel in it is hot.
+    std::vector<uint8_t> m_hot;
+};
+
+
+
+}
+}
+}
+#endif
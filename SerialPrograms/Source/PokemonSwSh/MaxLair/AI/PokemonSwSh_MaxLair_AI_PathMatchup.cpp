@@ -5,6 +5,7 @@
  */
 
 #include <map>
+#include <set>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
@@ -13,6 +14,7 @@
 #include "PokemonSwSh/Resources/PokemonSwSh_MaxLairDatabase.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
 #include "PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh_MaxLair_AI_Rollout.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -247,7 +249,8 @@ double evaluate_path(const Boss& boss, const std::vector<PathNode>& path){
 std::vector<PathNode> select_path(
     Logger* logger,
     const std::string& boss,
-    const PathMap& pathmap, uint8_t wins, int8_t path_side
+    const PathMap& pathmap, uint8_t wins, int8_t path_side,
+    std::vector<std::vector<PathNode>>* ties
 ){
 //    if (boss.empty() && state.path.boss == PokemonType::NONE){
 //        logger.log("No information known about boss.", COLOR_ORANGE);
@@ -283,6 +286,25 @@ std::vector<PathNode> select_path(
         logger->log(str);
     }
 
+    if (ties != nullptr){
+        //  Rollouts only see the types on the path. So keep one path per type
+        //  sequence, the one the heuristic ranks first.
+        ties->clear();
+        std::set<std::vector<PokemonType>> signatures;
+        for (const auto& path : rank){
+            if (!is_rollout_tie(path.first, rank.begin()->first)){
+                break;
+            }
+            std::vector<PokemonType> signature;
+            for (const PathNode& node : path.second){
+                signature.emplace_back(node.type);
+            }
+            if (signatures.insert(std::move(signature)).second){
+                ties->emplace_back(path.second);
+            }
+        }
+    }
+
     return std::move(rank.begin()->second);
 }
 
@@ -31,10 +31,13 @@ std::vector<std::vector<PathNode>> generate_paths(
 );
 
 
+//  If "ties" is set, it receives the paths that score within is_rollout_tie()
+//  of the best, one per distinct type sequence, best first.
 std::vector<PathNode> select_path(
     Logger* logger,
     const std::string& boss,
-    const PathMap& pathmap, uint8_t wins, int8_t path_side
+    const PathMap& pathmap, uint8_t wins, int8_t path_side,
+    std::vector<std::vector<PathNode>>* ties = nullptr
 );
 
 
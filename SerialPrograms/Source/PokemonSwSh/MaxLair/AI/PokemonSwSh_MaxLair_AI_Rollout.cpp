@@ -0,0 +1,513 @@
+/*  Max Lair AI Rollout
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <map>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/WorkStealingPool.h"
+#include "CommonFramework/GlobalServices.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Battle.h"
+#include "PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh_MaxLair_AI_Tools.h"
+#include "PokemonSwSh_MaxLair_AI_Rollout.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace MaxLairInternal{
+
+using papkmnlib::Pokemon;
+using papkmnlib::Field;
+
+
+
+namespace{
+
+//  Tuning constants. These are rough estimates, not measured values.
+constexpr size_t TURN_LIMIT = 10;
+constexpr size_t DMAX_TURNS = 3;
+constexpr double MAX_MOVE_PROBABILITY = 0.3;
+constexpr double RENTAL_HP_MULTIPLIER = 2.0;
+constexpr double BOSS_HP_MULTIPLIER = 6.0;
+constexpr double RIVAL_SWAP_PROBABILITY = 0.5;
+
+
+uint64_t splitmix64(uint64_t& state){
+    uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+class RolloutRng{
+public:
+    RolloutRng(uint64_t seed, uint64_t index)
+        : m_state(seed)
+    {
+        m_state = splitmix64(m_state) ^ index;
+    }
+    uint64_t next(){
+        return splitmix64(m_state);
+    }
+    double uniform(){
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+    size_t range(size_t n){
+        return (size_t)(uniform() * n);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+
+
+struct Attack{
+    uint16_t low = 0;
+    uint16_t high = 0;
+    double accuracy = 0;
+
+    double expected() const{
+        return (low + high) * accuracy / 2;
+    }
+    double roll(RolloutRng& rng) const{
+        if (rng.uniform() >= accuracy){
+            return 0;
+        }
+        return low + (double)rng.range(high - low + 1);
+    }
+};
+
+//  All the attacks of one Pokemon against another. [move][dmax][multiple targets]
+struct Matchup{
+    size_t moves = 0;
+    Attack attacks[5][2][2];
+    bool has_max_move[5] = {false, false, false, false, false};
+    bool is_spread[5] = {false, false, false, false, false};
+};
+
+//  Damage ranges are only computed once per attacker/defender pair for all
+//  the rollouts of a run. The field is always the opponent's default field.
+class MatchupCache{
+public:
+    const Matchup& get(const Pokemon& attacker, const Pokemon& defender, const Pokemon& opponent){
+        std::pair<const Pokemon*, const Pokemon*> key{&attacker, &defender};
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            auto iter = m_cache.find(key);
+            if (iter != m_cache.end()){
+                return *iter->second;
+            }
+        }
+
+        //  Compute outside the lock. If another thread gets there first, use theirs.
+        std::unique_ptr<Matchup> matchup = compute(attacker, defender, opponent);
+        std::lock_guard<std::mutex> lg(m_lock);
+        return *m_cache.emplace(key, std::move(matchup)).first->second;
+    }
+
+private:
+    static std::unique_ptr<Matchup> compute(const Pokemon& attacker, const Pokemon& defender, const Pokemon& opponent){
+        std::unique_ptr<Matchup> entry(new Matchup());
+
+        Field field;
+        field.set_default_field(opponent.name());
+
+        Pokemon copy = attacker;
+        entry->moves = std::min<size_t>(copy.num_moves(), 5);
+        for (size_t dmax = 0; dmax < 2; dmax++){
+            copy.set_is_dynamax(dmax != 0);
+            for (size_t move = 0; move < entry->moves; move++){
+                if ((dmax ? copy.max_move_id(move) : copy.move_id(move)) == 0){
+                    continue;
+                }
+                if (dmax){
+                    entry->has_max_move[move] = true;
+                }else{
+                    entry->is_spread[move] = copy.move(move).is_spread();
+                }
+                for (size_t multi = 0; multi < 2; multi++){
+                    Attack& attack = entry->attacks[move][dmax][multi];
+                    papkmnlib::damage_range(
+                        copy, defender, move, field, multi != 0,
+                        attack.low, attack.high, attack.accuracy
+                    );
+                }
+            }
+        }
+        return entry;
+    }
+
+private:
+    std::mutex m_lock;
+    std::map<std::pair<const Pokemon*, const Pokemon*>, std::unique_ptr<Matchup>> m_cache;
+};
+
+//  Unlocked view of the shared cache for a single thread.
+class LocalMatchupCache{
+public:
+    LocalMatchupCache(MatchupCache& shared)
+        : m_shared(shared)
+    {}
+    const Matchup& get(const Pokemon& attacker, const Pokemon& defender, const Pokemon& opponent){
+        const Matchup*& entry = m_cache[{&attacker, &defender}];
+        if (entry == nullptr){
+            entry = &m_shared.get(attacker, defender, opponent);
+        }
+        return *entry;
+    }
+
+private:
+    MatchupCache& m_shared;
+    std::map<std::pair<const Pokemon*, const Pokemon*>, const Matchup*> m_cache;
+};
+
+
+
+class Rollout{
+public:
+    Rollout(const RolloutState& state, LocalMatchupCache& cache, RolloutRng& rng)
+        : m_state(state)
+        , m_cache(cache)
+        , m_rng(rng)
+        , m_lives(state.lives)
+        , m_dmax_player(state.dmax_player)
+        , m_dmax_turns_left(state.dmax_turns_left)
+    {
+        for (size_t c = 0; c < 4; c++){
+            m_team[c] = state.team[c];
+            m_hp[c] = m_team[c] == nullptr ? 0 : m_team[c]->max_hp() * std::max(state.hp[c], 0.01);
+        }
+    }
+
+    bool run(uint64_t& battles_won){
+        const auto& battles = m_state.battles;
+        for (size_t b = 0; b < battles.size(); b++){
+            const std::vector<const Pokemon*>& candidates = battles[b];
+            if (candidates.empty()){
+                continue;
+            }
+            const Pokemon& opponent = *candidates[m_rng.range(candidates.size())];
+
+            if (b > 0){
+                //  Next player in line gets dmax.
+                m_dmax_player = m_dmax_player == RolloutState::NO_DMAX
+                    ? RolloutState::NO_DMAX
+                    : (m_dmax_player + 1) % 4;
+                m_dmax_turns_left = -1;
+            }
+
+            bool boss = b + 1 == battles.size();
+            if (!battle(opponent, b == 0 ? m_state.opponent_hp : 1.0, b == 0, boss)){
+                return false;
+            }
+            battles_won++;
+
+            if (b + 1 < battles.size()){
+                catch_opponent(opponent, b);
+            }
+        }
+        return true;
+    }
+
+private:
+    bool is_dmaxed(size_t player) const{
+        return player == m_dmax_player && m_dmax_turns_left > 0;
+    }
+
+    size_t pick_move(size_t player, const Matchup& matchup, bool dmaxed, bool first_turn){
+        if (player != m_state.self){
+            return m_rng.range(std::min<size_t>(matchup.moves, 4));
+        }
+        if (first_turn && m_state.first_move >= 0){
+            return m_state.first_move;
+        }
+        size_t best = 0;
+        double best_damage = -1;
+        for (size_t move = 0; move < std::min<size_t>(matchup.moves, 4); move++){
+            double damage = matchup.attacks[move][dmaxed][0].expected();
+            if (damage > best_damage){
+                best = move;
+                best_damage = damage;
+            }
+        }
+        return best;
+    }
+
+    bool battle(const Pokemon& opponent, double opponent_hp_ratio, bool first_battle, bool boss){
+        double opponent_hp = opponent.max_hp()
+            * (boss ? BOSS_HP_MULTIPLIER : RENTAL_HP_MULTIPLIER)
+            * opponent_hp_ratio;
+
+        bool fainted[4] = {false, false, false, false};
+
+        for (size_t turn = 0; turn < TURN_LIMIT; turn++){
+            bool first_turn = first_battle && turn == 0;
+
+            //  Dmax starts on the first chance unless "self" is told not to.
+            if (m_dmax_player < 4 && m_dmax_turns_left < 0 && !fainted[m_dmax_player] && m_team[m_dmax_player] != nullptr){
+                bool use = !(first_turn && m_dmax_player == m_state.self && m_state.first_move >= 0 && !m_state.first_move_dmax);
+                if (use){
+                    m_dmax_turns_left = DMAX_TURNS;
+                }
+            }
+
+            //  Players attack.
+            for (size_t p = 0; p < 4; p++){
+                if (m_team[p] == nullptr){
+                    continue;
+                }
+                if (fainted[p]){
+                    fainted[p] = false;
+                    continue;
+                }
+                const Matchup& matchup = m_cache.get(*m_team[p], opponent, opponent);
+                if (matchup.moves == 0){
+                    continue;
+                }
+                bool dmaxed = is_dmaxed(p);
+                size_t move = pick_move(p, matchup, dmaxed, first_turn);
+                if (dmaxed && !matchup.has_max_move[move]){
+                    dmaxed = false;
+                }
+                opponent_hp -= matchup.attacks[move][dmaxed][0].roll(m_rng);
+                if (opponent_hp <= 0){
+                    return true;
+                }
+            }
+
+            //  Opponent attacks.
+            size_t opponent_moves = std::min<size_t>(opponent.num_moves(), 5);
+            if (opponent_moves == 0){
+                continue;
+            }
+            size_t move = m_rng.range(opponent_moves);
+            size_t target = m_rng.range(4);
+            bool max_move = m_rng.uniform() < MAX_MOVE_PROBABILITY;
+            for (size_t p = 0; p < 4; p++){
+                if (m_team[p] == nullptr){
+                    continue;
+                }
+                const Matchup& matchup = m_cache.get(opponent, *m_team[p], opponent);
+                bool use_max = max_move && matchup.has_max_move[move];
+                bool spread = !use_max && matchup.is_spread[move];
+                if (!spread && p != target){
+                    continue;
+                }
+                double damage = matchup.attacks[move][use_max][spread].roll(m_rng);
+                if (is_dmaxed(p)){
+                    damage /= 2;
+                }
+                m_hp[p] -= damage;
+                if (m_hp[p] > 0){
+                    continue;
+                }
+
+                //  Fainted.
+                if (--m_lives == 0){
+                    return false;
+                }
+                m_hp[p] = m_team[p]->max_hp();
+                fainted[p] = true;
+                if (p == m_dmax_player && m_dmax_turns_left > 0){
+                    m_dmax_turns_left = 0;
+                }
+            }
+
+            if (m_dmax_turns_left > 0){
+                m_dmax_turns_left--;
+            }
+        }
+
+        //  Out of turns.
+        return false;
+    }
+
+    //  How well "pokemon" does against the possible bosses.
+    double boss_score(const Pokemon& pokemon){
+        const std::vector<const Pokemon*>& bosses = m_state.battles.back();
+        double score = 0;
+        for (const Pokemon* boss : bosses){
+            const Matchup& matchup = m_cache.get(pokemon, *boss, *boss);
+            double best = 0;
+            for (size_t move = 0; move < std::min<size_t>(matchup.moves, 4); move++){
+                best = std::max(best, matchup.attacks[move][0][0].expected());
+            }
+            score += best;
+        }
+        return score;
+    }
+
+    void catch_opponent(const Pokemon& opponent, size_t battle_index){
+        for (size_t c = 0; c < 4; c++){
+            size_t p = (battle_index + c) % 4;
+            if (m_team[p] == nullptr){
+                continue;
+            }
+            bool swap = p == m_state.self
+                ? boss_score(opponent) > boss_score(*m_team[p])
+                : m_rng.uniform() < RIVAL_SWAP_PROBABILITY;
+            if (swap){
+                m_team[p] = &opponent;
+                m_hp[p] = opponent.max_hp();
+                return;
+            }
+        }
+    }
+
+private:
+    const RolloutState& m_state;
+    LocalMatchupCache& m_cache;
+    RolloutRng& m_rng;
+
+    const Pokemon* m_team[4];
+    double m_hp[4];
+    uint8_t m_lives;
+
+    size_t m_dmax_player;
+    int8_t m_dmax_turns_left;
+};
+
+
+RolloutResult run_rollouts(
+    const RolloutState& state, LocalMatchupCache& cache,
+    uint64_t seed, size_t start, size_t end
+){
+    RolloutResult result;
+    for (size_t c = start; c < end; c++){
+        RolloutRng rng(seed, c);
+        Rollout rollout(state, cache, rng);
+        result.rollouts++;
+        if (rollout.run(result.battles_won)){
+            result.wins++;
+        }
+    }
+    return result;
+}
+
+}
+
+
+
+RolloutEngine::RolloutEngine(size_t threads)
+    : m_threads(threads != 0 ? threads : global_compute_pool().threads())
+{}
+
+RolloutResult RolloutEngine::run_blocks(
+    const RolloutState& state,
+    size_t rollouts, uint64_t seed,
+    const WallClock* deadline
+){
+    if (state.battles.empty() || state.lives == 0){
+        return RolloutResult();
+    }
+
+    //  Each worker pulls blocks until they run out or time is up. Since
+    //  every rollout has its own seed, it doesn't matter who runs which.
+    MatchupCache cache;
+    size_t blocks = (rollouts + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::atomic<size_t> next_block(0);
+
+    size_t workers = std::min(m_threads, blocks);
+    std::vector<RolloutResult> results(workers);
+    global_compute_pool().parallel_for(0, workers, 1, [&](size_t w){
+        LocalMatchupCache local_cache(cache);
+        while (deadline == nullptr || current_time() < *deadline){
+            size_t b = next_block.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blocks){
+                return;
+            }
+            size_t start = b * BLOCK_SIZE;
+            size_t end = std::min(start + BLOCK_SIZE, rollouts);
+            results[w] += run_rollouts(state, local_cache, seed, start, end);
+        }
+    });
+
+    RolloutResult total;
+    for (const RolloutResult& result : results){
+        total += result;
+    }
+    return total;
+}
+RolloutResult RolloutEngine::run(const RolloutState& state, size_t rollouts, uint64_t seed){
+    return run_blocks(state, rollouts, seed, nullptr);
+}
+RolloutResult RolloutEngine::run_until(
+    const RolloutState& state,
+    WallClock deadline, size_t max_rollouts,
+    uint64_t seed
+){
+    return run_blocks(state, max_rollouts, seed, &deadline);
+}
+
+RolloutEngine& global_rollout_engine(){
+    static RolloutEngine engine;
+    return engine;
+}
+
+
+
+void set_rollout_team(RolloutState& rollout, const GlobalState& state, size_t player_index){
+    rollout.self = player_index;
+    rollout.lives = state.lives_left > 0 ? state.lives_left : 4;
+    rollout.dmax_player = RolloutState::NO_DMAX;
+    rollout.dmax_turns_left = -1;
+    for (size_t c = 0; c < 4; c++){
+        const PlayerState& player = state.players[c];
+        rollout.team[c] = player.pokemon.empty() ? nullptr : &papkmnlib::get_pokemon(player.pokemon);
+        double hp = player.health.value.hp;
+        rollout.hp[c] = hp <= 0 || player.health.value.dead == 1 ? 1.0 : hp;
+        if (player.dmax_turns_left > 0){
+            rollout.dmax_player = c;
+            rollout.dmax_turns_left = player.dmax_turns_left;
+        }else if (player.can_dmax && rollout.dmax_player == RolloutState::NO_DMAX){
+            rollout.dmax_player = c;
+        }
+    }
+    if (rollout.dmax_player == RolloutState::NO_DMAX){
+        rollout.dmax_player = state.wins % 4;
+    }
+}
+
+std::vector<std::vector<const papkmnlib::Pokemon*>> rollout_battles_on_path(
+    const GlobalState& state,
+    const std::vector<PathNode>& path
+){
+    std::vector<std::vector<const Pokemon*>> battles;
+    for (const PathNode& node : path){
+        std::vector<const Pokemon*> candidates;
+        for (const std::string& slug : rentals_by_type(node.type)){
+            if (state.seen.find(slug) == state.seen.end()){
+                candidates.emplace_back(&papkmnlib::get_pokemon(slug));
+            }
+        }
+        if (candidates.empty()){
+            for (const auto& item : papkmnlib::all_rental_pokemon()){
+                if (state.seen.find(item.first) == state.seen.end()){
+                    candidates.emplace_back(&item.second);
+                }
+            }
+        }
+        battles.emplace_back(std::move(candidates));
+    }
+    battles.emplace_back(get_boss_candidates(state));
+    return battles;
+}
+
+uint64_t rollout_seed(){
+    uint64_t seed = current_time().time_since_epoch().count();
+    return splitmix64(seed);
+}
+
+
+
+}
+}
+}
+}
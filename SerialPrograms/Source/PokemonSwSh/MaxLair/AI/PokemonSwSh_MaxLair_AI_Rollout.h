@@ -0,0 +1,161 @@
+/*  Max Lair AI Rollout
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Monte Carlo simulation of the rest of an adventure.
+ *
+ *  Each rollout plays out the remaining battles against random opponents
+ *  from the path. The other 3 players pick random moves. Damage and accuracy
+ *  are rolled from damage_range(). After each win, the players take turns
+ *  deciding whether to swap with the caught Pokemon. The fraction of rollouts
+ *  that beat the boss estimates the win rate from the starting point.
+ *
+ *  The battle model is intentionally simple:
+ *    - Players attack first, then the opponent attacks once.
+ *    - The opponent uses a max move 30% of the time. Otherwise it uses a
+ *      random move. Spread moves hit everyone.
+ *    - A fainted Pokemon costs a life, comes back at full HP and sits out
+ *      its next turn.
+ *    - Running out of lives or turns ends the adventure.
+ *    - Dynamax rotates between the players, one per battle. It lasts 3 turns
+ *      and halves the damage taken.
+ *
+ *  The model isn't calibrated against real adventures. So the AI only uses
+ *  it to break near-ties in its own heuristic rankings of paths and moves.
+ *  See is_rollout_tie().
+ *
+ *  Rollouts are independent and run in parallel. Rollout "i" is seeded from
+ *  (seed, i). So a fixed # of rollouts with a fixed seed gives the same result
+ *  regardless of the # of threads.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSwSh_MaxLair_AI_Rollout_H
+#define PokemonAutomation_PokemonSwSh_MaxLair_AI_Rollout_H
+
+#include <stdint.h>
+#include <cmath>
+#include <vector>
+#include "Common/Cpp/Time.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace MaxLairInternal{
+
+
+struct RolloutState{
+    static constexpr size_t NO_DMAX = 4;
+
+    //  The 4 players. Null if unknown. Unknown players neither attack nor
+    //  get attacked.
+    const papkmnlib::Pokemon* team[4] = {nullptr, nullptr, nullptr, nullptr};
+    double hp[4] = {1, 1, 1, 1};
+
+    //  The player the decision is for. Picks its best move instead of a
+    //  random one and only swaps for a better Pokemon.
+    size_t self = 0;
+
+    uint8_t lives = 4;
+
+    //  The remaining battles in order. Each is the list of Pokemon that can
+    //  show up in that battle. The last one is the boss.
+    std::vector<std::vector<const papkmnlib::Pokemon*>> battles;
+
+    //  HP of the opponent in the first battle if it's already in progress.
+    double opponent_hp = 1;
+
+    //  The player that can dmax in the first battle. Rotates every battle.
+    size_t dmax_player = NO_DMAX;
+    //  -1 = not used yet, 0 = used up, > 0 = turns left.
+    int8_t dmax_turns_left = -1;
+
+    //  Force the first move of "self". -1 to let it choose.
+    int8_t first_move = -1;
+    bool first_move_dmax = false;
+};
+
+struct RolloutResult{
+    uint64_t rollouts = 0;
+    uint64_t wins = 0;
+    uint64_t battles_won = 0;
+
+    double win_rate() const{
+        return rollouts == 0 ? 0 : (double)wins / rollouts;
+    }
+    void operator+=(const RolloutResult& x){
+        rollouts += x.rollouts;
+        wins += x.wins;
+        battles_won += x.battles_won;
+    }
+};
+
+
+
+class RolloutEngine{
+public:
+    //  Rollouts are dispatched in blocks of this size.
+    static constexpr size_t BLOCK_SIZE = 64;
+
+public:
+    //  Runs on the global compute pool with up to "threads" workers at once.
+    //  "threads = 0" means all of the pool.
+    RolloutEngine(size_t threads = 0);
+
+    size_t threads() const{ return m_threads; }
+
+    //  Run exactly "rollouts" rollouts. Deterministic for a given seed.
+    RolloutResult run(const RolloutState& state, size_t rollouts, uint64_t seed);
+
+    //  Run blocks of rollouts until "deadline" or "max_rollouts".
+    //  A block that starts before the deadline runs to completion.
+    RolloutResult run_until(
+        const RolloutState& state,
+        WallClock deadline, size_t max_rollouts,
+        uint64_t seed
+    );
+
+private:
+    RolloutResult run_blocks(
+        const RolloutState& state,
+        size_t rollouts, uint64_t seed,
+        const WallClock* deadline
+    );
+
+private:
+    size_t m_threads;
+};
+
+RolloutEngine& global_rollout_engine();
+
+
+
+//  Fill in the team, lives and dmax rotation of "rollout" from "state".
+void set_rollout_team(RolloutState& rollout, const GlobalState& state, size_t player_index);
+
+//  Opponent candidates for the battles on "path" followed by the boss.
+std::vector<std::vector<const papkmnlib::Pokemon*>> rollout_battles_on_path(
+    const GlobalState& state,
+    const std::vector<PathNode>& path
+);
+
+//  A seed for AI decisions that aren't meant to be reproducible.
+uint64_t rollout_seed();
+
+//  Whether a heuristic "score" is close enough to the "best" to let the
+//  rollouts decide between them. The heuristics are too coarse to trust
+//  differences smaller than this.
+const double ROLLOUT_TIE_TOLERANCE = 0.05;
+inline bool is_rollout_tie(double score, double best){
+    return best - score <= ROLLOUT_TIE_TOLERANCE * std::abs(best);
+}
+
+
+
+}
+}
+}
+}
+#endif
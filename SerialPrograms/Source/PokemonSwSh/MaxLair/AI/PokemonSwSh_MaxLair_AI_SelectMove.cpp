@@ -9,6 +9,7 @@
 #include "PokemonSwSh/Resources/PokemonSwSh_MaxLairDatabase.h"
 #include "PokemonSwSh_MaxLair_AI.h"
 #include "PokemonSwSh_MaxLair_AI_Tools.h"
+#include "PokemonSwSh_MaxLair_AI_Rollout.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -16,6 +17,91 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+//  Time spent simulating the tied moves. Split evenly between them.
+const std::chrono::milliseconds MOVE_ROLLOUT_TIME(1000);
+const size_t MOVE_ROLLOUT_MAX = 10000;
+
+
+//  Pick between the moves that score within is_rollout_tie() of the best by
+//  simulated win rate. The heuristic order wins if the rollouts tie too.
+std::pair<uint8_t, bool> break_move_tie_by_rollouts(
+    Logger& logger,
+    const GlobalState& state,
+    size_t player_index,
+    const std::multimap<double, std::pair<uint8_t, bool>, std::greater<double>>& rank
+){
+    using namespace papkmnlib;
+
+    const double best_score = rank.begin()->first;
+    std::vector<std::pair<uint8_t, bool>> ties;
+    for (const auto& move : rank){
+        if (!is_rollout_tie(move.first, best_score)){
+            break;
+        }
+        ties.emplace_back(move.second);
+    }
+    if (ties.size() < 2){
+        return rank.begin()->second;
+    }
+
+    RolloutState rollout;
+    set_rollout_team(rollout, state, player_index);
+    if (rollout.team[player_index] == nullptr){
+        return rank.begin()->second;
+    }
+
+    //  Current battle, then the rest of the path, then the boss.
+    std::vector<const Pokemon*> opponents;
+    for (const std::string& slug : state.opponent){
+        opponents.emplace_back(&get_pokemon(slug));
+    }
+    rollout.battles.emplace_back(std::move(opponents));
+    if (state.wins < 3){
+        std::vector<const Pokemon*> rentals = get_rental_candidates_on_path_pkmnlib(state);
+        if (rentals.empty()){
+            for (const auto& item : all_rental_pokemon()){
+                rentals.emplace_back(&item.second);
+            }
+        }
+        for (size_t c = state.wins + 1; c < 3; c++){
+            rollout.battles.emplace_back(rentals);
+        }
+        rollout.battles.emplace_back(get_boss_candidates(state));
+    }
+    double opponent_hp = state.opponent_hp;
+    rollout.opponent_hp = opponent_hp > 0 ? opponent_hp : 1.0;
+
+    uint64_t seed = rollout_seed();
+    std::chrono::milliseconds time_per_move = MOVE_ROLLOUT_TIME / ties.size();
+    RolloutEngine& engine = global_rollout_engine();
+
+    std::pair<uint8_t, bool> best = ties[0];
+    double best_win_rate = -1;
+    std::string str = "Move Rollouts (tie-break):\n";
+    for (const std::pair<uint8_t, bool>& move : ties){
+        RolloutState option = rollout;
+        option.first_move = move.first;
+        option.first_move_dmax = move.second;
+        if (move.second){
+            option.dmax_player = player_index;
+            if (option.dmax_turns_left <= 0){
+                option.dmax_turns_left = -1;
+            }
+        }
+        RolloutResult result = engine.run_until(option, current_time() + time_per_move, MOVE_ROLLOUT_MAX, seed);
+        str += std::to_string(result.win_rate()) + " (" + std::to_string(result.rollouts) + ") : ";
+        str += std::to_string(move.first) + (move.second ? " (dmax)" : "") + "\n";
+        if (result.win_rate() > best_win_rate){
+            best_win_rate = result.win_rate();
+            best = move;
+        }
+    }
+    logger.log(str);
+
+    return best;
+}
+
+
 
 std::pair<uint8_t, bool> select_move_ai(
     Logger& logger,
@@ -114,7 +200,7 @@ std::pair<uint8_t, bool> select_move_ai(
         return {(uint8_t)random(0, 3), false};
     }
 
-    return rank.begin()->second;
+    return break_move_tie_by_rollouts(logger, state, player_index, rank);
 }
 
 
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.h"
 #include "PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh_MaxLair_AI_Rollout.h"
 
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
 
@@ -16,6 +17,59 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+//  Time spent simulating the tied paths. Split evenly between them.
+const std::chrono::milliseconds PATH_ROLLOUT_TIME(2000);
+const size_t PATH_ROLLOUT_MAX = 20000;
+
+
+//  Break a near-tie between paths by simulated win rate. The heuristic pick
+//  wins if the rollouts tie too.
+std::vector<PathNode> break_path_tie_by_rollouts(
+    Logger& logger,
+    const GlobalState& state,
+    size_t player_index,
+    const std::vector<std::vector<PathNode>>& paths,
+    std::vector<PathNode> heuristic_path
+){
+    RolloutState rollout;
+    set_rollout_team(rollout, state, player_index);
+    if (rollout.team[player_index] == nullptr){
+        return heuristic_path;
+    }
+
+    //  Same seed for all paths so they see the same random numbers.
+    uint64_t seed = rollout_seed();
+    std::chrono::milliseconds time_per_path = PATH_ROLLOUT_TIME / paths.size();
+
+    RolloutEngine& engine = global_rollout_engine();
+    auto evaluate = [&](const std::vector<PathNode>& path){
+        rollout.battles = rollout_battles_on_path(state, path);
+        return engine.run_until(rollout, current_time() + time_per_path, PATH_ROLLOUT_MAX, seed);
+    };
+
+    RolloutResult best_result = evaluate(heuristic_path);
+    std::string str = "Path Rollouts (tie-break):\n";
+    str += std::to_string(best_result.win_rate()) + " (" + std::to_string(best_result.rollouts) + ") : " + dump_path(heuristic_path) + "\n";
+
+    std::vector<PathNode> best = heuristic_path;
+    for (const std::vector<PathNode>& path : paths){
+        if (dump_path(path) == dump_path(heuristic_path)){
+            continue;
+        }
+        RolloutResult result = evaluate(path);
+        str += std::to_string(result.win_rate()) + " (" + std::to_string(result.rollouts) + ") : " + dump_path(path) + "\n";
+        if (result.win_rate() > best_result.win_rate()){
+            best_result = result;
+            best = path;
+        }
+    }
+    logger.log(str);
+
+    return best;
+}
+
+
+
 
 
 
@@ -63,14 +117,19 @@ std::vector<PathNode> select_path(
     return paths[random(0, (int)paths.size() - 1)][0].path_slot;
 #endif
 
+    std::vector<std::vector<PathNode>> ties;
     std::vector<PathNode> path = select_path(
         &logger,
         state.boss,
-        state.path, state.wins, state.path_side
+        state.path, state.wins, state.path_side,
+        &ties
     );
     if (path.empty()){
         return {};
     }
+    if (ties.size() > 1){
+        path = break_path_tie_by_rollouts(logger, state, player_index, ties, std::move(path));
+    }
     return path;
 }
 
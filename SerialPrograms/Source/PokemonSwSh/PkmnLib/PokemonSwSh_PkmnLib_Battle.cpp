@@ -319,9 +319,10 @@ double terrain_damage_multiplier(const Pokemon& attacker, const Pokemon& defende
     return modifier;
 }
 
-double damage_score(
+void damage_range(
     const Pokemon& attacker, const Pokemon& defender,
-    size_t moveIdx, const Field& field, bool multipleTargets
+    size_t moveIdx, const Field& field, bool multipleTargets,
+    uint16_t& damageLow, uint16_t& damageHigh, double& accuracy
 ){
 
     // get the right attacker move
@@ -418,21 +419,31 @@ double damage_score(
     }
 
     // then calculate the damage
-    uint16_t damageLow, damageHigh;
     // NOTE: the calcDamageRanges function will give the max damage and the min damage
     // no need to include the 0.925 modifier above!
     calc_damage_range(
         move.base_power(), attacker.level(), attackUse, defenseUse, avgMultiplier,
         damageLow, damageHigh
     );
-
-    // so get the average between the two multiplied by accuracy
-    double damageScore = (damageLow + damageHigh) * move.accuracy() / 2;
+    accuracy = move.accuracy();
 
 //    // return the move type back to its original value
 //    move.reset_move_type();
+}
+
+double damage_score(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field, bool multipleTargets
+){
+    uint16_t damageLow, damageHigh;
+    double accuracy;
+    damage_range(
+        attacker, defender, moveIdx, field, multipleTargets,
+        damageLow, damageHigh, accuracy
+    );
 
-    return damageScore;
+    // so get the average between the two multiplied by accuracy
+    return (damageLow + damageHigh) * accuracy / 2;
 }
 
 
@@ -23,6 +23,14 @@ void calc_damage_range(
 );
 
 
+//  The damage range of a single hit and the chance that it lands.
+void damage_range(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field, bool multipleTargets,
+    uint16_t& damageLow, uint16_t& damageHigh, double& accuracy
+);
+
+//  Expected damage of a single attack. (average of the range times accuracy)
 double damage_score(
     const Pokemon& attacker, const Pokemon& defender,
     size_t moveIdx, const Field& field, bool multipleTargets = false
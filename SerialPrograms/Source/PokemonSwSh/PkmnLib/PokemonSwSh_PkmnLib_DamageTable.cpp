@@ -0,0 +1,166 @@
+/*  PkmnLib Damage Table
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/WorkStealingPool.h"
+#include "CommonFramework/GlobalServices.h"
+#include "PokemonSwSh_PkmnLib_Battle.h"
+#include "PokemonSwSh_PkmnLib_DamageTable.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace papkmnlib{
+
+
+
+namespace{
+
+constexpr size_t MAX_MOVES = 5;
+constexpr size_t WEATHERS = 5;
+constexpr size_t TERRAINS = 5;
+
+
+//  All the damage scores for a single field.
+//  Indexed by: [attacker][defender][move][dmax][multiple targets]
+class DamageTableSlice{
+public:
+    DamageTableSlice(const std::vector<const Pokemon*>& pokemon, const Field& field)
+        : m_size(pokemon.size())
+        , m_table(m_size * m_size * MAX_MOVES * 4, std::numeric_limits<double>::quiet_NaN())
+    {
+        global_compute_pool().parallel_for(0, m_size, 1, [&](size_t a){
+            build_row(pokemon, field, a);
+        });
+    }
+
+    //  Returns NaN if the move doesn't exist.
+    double get(size_t attacker, size_t defender, size_t moveIdx, bool dmax, bool multipleTargets) const{
+        return m_table[index(attacker, defender, moveIdx, dmax, multipleTargets)];
+    }
+
+private:
+    size_t index(size_t attacker, size_t defender, size_t moveIdx, bool dmax, bool multipleTargets) const{
+        return ((attacker * m_size + defender) * MAX_MOVES + moveIdx) * 4 + (dmax ? 2 : 0) + (multipleTargets ? 1 : 0);
+    }
+
+    void build_row(const std::vector<const Pokemon*>& pokemon, const Field& field, size_t a){
+        //  Copy so we can toggle dmax.
+        Pokemon attacker = *pokemon[a];
+        size_t moves = std::min(attacker.num_moves(), MAX_MOVES);
+        for (size_t dmax = 0; dmax < 2; dmax++){
+            attacker.set_is_dynamax(dmax != 0);
+            for (size_t move = 0; move < moves; move++){
+                //  Missing moves stay NaN and go through the live calculation.
+                if ((dmax ? attacker.max_move_id(move) : attacker.move_id(move)) == 0){
+                    continue;
+                }
+                for (size_t d = 0; d < m_size; d++){
+                    const Pokemon& defender = *pokemon[d];
+                    m_table[index(a, d, move, dmax != 0, false)] = damage_score(attacker, defender, move, field, false);
+                    m_table[index(a, d, move, dmax != 0, true)] = damage_score(attacker, defender, move, field, true);
+                }
+            }
+        }
+    }
+
+private:
+    size_t m_size;
+    std::vector<double> m_table;
+};
+
+
+class DamageTable{
+public:
+    static DamageTable& instance(){
+        static DamageTable table;
+        return table;
+    }
+
+    const DamageTableSlice& slice(const Field& field){
+        size_t key = (size_t)field.weather() * TERRAINS + (size_t)field.terrain();
+        const DamageTableSlice* slice = m_slices[key].load(std::memory_order_acquire);
+        if (slice != nullptr){
+            return *slice;
+        }
+
+        std::lock_guard<std::mutex> lg(m_lock);
+        slice = m_slices[key].load(std::memory_order_relaxed);
+        if (slice != nullptr){
+            return *slice;
+        }
+        m_owners[key].reset(new DamageTableSlice(m_pokemon, Field(field.weather(), field.terrain())));
+        m_slices[key].store(m_owners[key].get(), std::memory_order_release);
+        return *m_owners[key];
+    }
+
+private:
+    DamageTable(){
+        const std::map<std::string, Pokemon>& rentals = all_rental_pokemon();
+        const std::map<std::string, Pokemon>& bosses = all_boss_pokemon();
+        m_pokemon.resize(rentals.size() + bosses.size(), nullptr);
+        for (const auto& item : rentals){
+            m_pokemon[item.second.table_index()] = &item.second;
+        }
+        for (const auto& item : bosses){
+            m_pokemon[item.second.table_index()] = &item.second;
+        }
+        for (const Pokemon* pokemon : m_pokemon){
+            if (pokemon == nullptr){
+                throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Damage table indices are not contiguous.");
+            }
+        }
+        for (std::atomic<const DamageTableSlice*>& slice : m_slices){
+            slice.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::vector<const Pokemon*> m_pokemon;
+
+    std::mutex m_lock;
+    std::atomic<const DamageTableSlice*> m_slices[WEATHERS * TERRAINS];
+    std::unique_ptr<DamageTableSlice> m_owners[WEATHERS * TERRAINS];
+};
+
+}
+
+
+
+double damage_score_lookup(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field, bool multipleTargets
+){
+    size_t a = attacker.table_index();
+    size_t d = defender.table_index();
+    if (a == Pokemon::NO_TABLE_INDEX || d == Pokemon::NO_TABLE_INDEX ||
+        moveIdx >= attacker.num_moves() || moveIdx >= MAX_MOVES ||
+        attacker.non_volatile_status_effect() == NonVolatileStatusEffects::BURN
+    ){
+        return damage_score(attacker, defender, moveIdx, field, multipleTargets);
+    }
+
+    double score = DamageTable::instance().slice(field).get(
+        a, d, moveIdx, attacker.is_dynamax(), multipleTargets
+    );
+    if (std::isnan(score)){
+        return damage_score(attacker, defender, moveIdx, field, multipleTargets);
+    }
+    return score;
+}
+
+
+
+}
+}
+}
+}
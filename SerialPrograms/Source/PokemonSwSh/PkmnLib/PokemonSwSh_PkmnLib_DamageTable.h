@@ -0,0 +1,47 @@
+/*  PkmnLib Damage Table
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Precomputed damage_score() between every rental and boss Pokemon.
+ *
+ *  The damage only depends on the species data of both sides (stats, types,
+ *  ability, moves), the field, and the attacker's dynamax and burn status.
+ *  So for the unmodified Pokemon in all_rental_pokemon() and
+ *  all_boss_pokemon() it can be computed once and looked up afterwards.
+ *
+ *  The table is built the first time a field is used. Each field is built
+ *  separately and in parallel. Only a handful of fields ever show up in Max
+ *  Lair. (see Field::set_default_field())
+ *
+ *  Anything that isn't in the table falls back to damage_score():
+ *    - Pokemon that didn't come from the databases or were modified after.
+ *      (see Pokemon::table_index())
+ *    - Burned attackers.
+ *
+ */
+
+#ifndef _PokemonAutomation_PokemonSwSh_PkmnLib_DamageTable_H
+#define _PokemonAutomation_PokemonSwSh_PkmnLib_DamageTable_H
+
+#include "PokemonSwSh_PkmnLib_Field.h"
+#include "PokemonSwSh_PkmnLib_Pokemon.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+namespace papkmnlib{
+
+
+//  Same as damage_score(), but from the table when possible.
+double damage_score_lookup(
+    const Pokemon& attacker, const Pokemon& defender,
+    size_t moveIdx, const Field& field, bool multipleTargets = false
+);
+
+
+
+}
+}
+}
+}
+#endif
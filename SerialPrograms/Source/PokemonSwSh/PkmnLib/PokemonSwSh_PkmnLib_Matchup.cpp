@@ -5,6 +5,7 @@
  */
 
 #include <cmath>
+#include "PokemonSwSh_PkmnLib_DamageTable.h"
 #include "PokemonSwSh_PkmnLib_Matchup.h"
 
 #include <iostream>
@@ -42,13 +43,13 @@ double calc_average_damage(
 #if 0
             //  Assume the other players pick random moves.
             for (size_t ii = 0; ii < numMoves; ii++){
-                subTotalDamage += damage_score(*attacker, *defender, ii, field, multipleTargets);
+                subTotalDamage += damage_score_lookup(*attacker, *defender, ii, field, multipleTargets);
             }
             subTotalDamage /= numMoves;
 #else
             //  Assume the other players pick the most damaging move.
             for (size_t ii = 0; ii < numMoves; ii++){
-                subTotalDamage = std::max(subTotalDamage, damage_score(*attacker, *defender, ii, field, multipleTargets));
+                subTotalDamage = std::max(subTotalDamage, damage_score_lookup(*attacker, *defender, ii, field, multipleTargets));
             }
 #endif
 
@@ -74,7 +75,7 @@ double calc_move_score(
     // first start by calculating damage based on the attacker
     // no on multiple targets since we're only hitting the boss
     // TODO: set defender to dynamax?
-    double damageScore = damage_score(attacker, defender, moveIdx, field, false) / 2.0;
+    double damageScore = damage_score_lookup(attacker, defender, moveIdx, field, false) / 2.0;
 
     // TODO: make sure the defender and attacker aren't in the teammates list
 
@@ -113,11 +114,11 @@ double calc_move_score(
         // NOTE: original function in python also checked to make sure we aren't dynamax, we already did that
         if (defenderMove.is_spread()){
             if (attackerMove != "wide-guard" || attacker.is_dynamax()){
-                receivedRegularDamage += damage_score(defender, attacker, ii, field, true) / defenderNumMoves;
+                receivedRegularDamage += damage_score_lookup(defender, attacker, ii, field, true) / defenderNumMoves;
                 receivedRegularDamage += 3 * calc_average_damage(tempDefenderList, teammates, field, true) / defenderNumMoves;
             }
         }else{
-            receivedRegularDamage += 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
+            receivedRegularDamage += 0.25 * damage_score_lookup(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
             receivedRegularDamage += 0.75 * calc_average_damage(tempDefenderList, teammates, field, false) / defenderNumMoves;
         }
     }
@@ -127,7 +128,7 @@ double calc_move_score(
     defender.set_is_dynamax(true);
     tempDefenderList[0] = &defender;
     for (size_t ii = 0; ii < defenderNumMoves; ii++){
-        receivedMaxMoveDamage += 0.25 * damage_score(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
+        receivedMaxMoveDamage += 0.25 * damage_score_lookup(defender, attacker, ii, field, false) / dmax_hp_ratio / defenderNumMoves;
         receivedMaxMoveDamage += 0.75 * calc_average_damage(tempDefenderList, teammates, field, false) / defenderNumMoves;
     }
 //    cout << "receivedMaxMoveDamage = " << receivedMaxMoveDamage << endl;
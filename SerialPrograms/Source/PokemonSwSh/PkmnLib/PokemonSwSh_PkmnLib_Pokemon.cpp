@@ -195,6 +195,7 @@ void Pokemon::update_stats(bool is_iv, uint8_t HP, uint8_t Atk, uint8_t Def, uin
 
     // then recalculate stats
     calculate_stats();
+    m_table_index = NO_TABLE_INDEX;
 }
 void Pokemon::update_stats(
     uint8_t iv_hp, uint8_t iv_atk, uint8_t iv_def, uint8_t iv_spatk, uint8_t iv_spdef, uint8_t iv_speed,
@@ -220,6 +221,7 @@ void Pokemon::update_stats(
 
     // then recalculate stats
     calculate_stats();
+    m_table_index = NO_TABLE_INDEX;
 }
 
 
@@ -268,10 +270,12 @@ const Move& Pokemon::max_move(size_t index) const{
 void Pokemon::set_move(const Move& move, size_t index){
     assert_move_index(index);
     m_move[index] = &move;
+    m_table_index = NO_TABLE_INDEX;
 }
 void Pokemon::set_max_move(const Move& move, size_t index){
     assert_move_index(index);
     m_max_move[index] = &move;
+    m_table_index = NO_TABLE_INDEX;
 }
 
 uint32_t Pokemon::move_id(size_t index) const{
@@ -426,12 +430,29 @@ std::map<std::string, Pokemon> load_pokemon(const std::string& filepath, bool is
 }
 
 
+//  Rentals come first in the damage table, then bosses.
+std::map<std::string, Pokemon> set_table_indices(std::map<std::string, Pokemon> map, size_t offset){
+    if (offset + map.size() >= Pokemon::NO_TABLE_INDEX){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Too many Pokemon for the damage table.");
+    }
+    for (auto& item : map){
+        item.second.set_table_index((uint16_t)offset++);
+    }
+    return map;
+}
+
 const std::map<std::string, Pokemon>& all_rental_pokemon(){
-    static std::map<std::string, Pokemon> pokemon = load_pokemon("PokemonSwSh/MaxLair/rental_pokemon.json", false);
+    static std::map<std::string, Pokemon> pokemon = set_table_indices(
+        load_pokemon("PokemonSwSh/MaxLair/rental_pokemon.json", false),
+        0
+    );
     return pokemon;
 }
 const std::map<std::string, Pokemon>& all_boss_pokemon(){
-    static std::map<std::string, Pokemon> pokemon = load_pokemon("PokemonSwSh/MaxLair/boss_pokemon.json", true);
+    static std::map<std::string, Pokemon> pokemon = set_table_indices(
+        load_pokemon("PokemonSwSh/MaxLair/boss_pokemon.json", true),
+        all_rental_pokemon().size()
+    );
     return pokemon;
 }
 
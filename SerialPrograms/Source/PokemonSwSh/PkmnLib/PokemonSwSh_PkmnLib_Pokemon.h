@@ -158,6 +158,12 @@ public:
 
     void transform_from_ditto(const Pokemon& opponent);
 
+    //  Position in the precomputed damage table. (see PokemonSwSh_PkmnLib_DamageTable.h)
+    //  Only set for the Pokemon in the databases. Changing stats or moves clears it.
+    static constexpr uint16_t NO_TABLE_INDEX = (uint16_t)-1;
+    uint16_t table_index() const{ return m_table_index; }
+    void set_table_index(uint16_t index){ m_table_index = index; }
+
     std::string dump() const;
 
 private:
@@ -188,6 +194,8 @@ private:
 
     bool m_is_legendary = false;
 
+    uint16_t m_table_index = NO_TABLE_INDEX;
+
     // move information
     size_t m_num_moves;
     uint32_t m_move_id[5] = {0, 0, 0, 0, 0};
@@ -252,6 +252,12 @@ GameSettings::GameSettings()
         LockMode::LOCK_WHILE_RUNNING,
         1.2, 0
     )
+    , SPARKLE_HEAT_MAP(
+        "<b>Sparkle Heat Map:</b><br>Only search the parts of the battle that are changing for sparkles. "
+        "This is faster but hasn't been validated against the full search yet.",
+        LockMode::LOCK_WHILE_RUNNING,
+        false
+    )
 //    , m_experimental("<font size=4><b>Experimental/Beta Features:</b></font>")
 {
     PA_ADD_STATIC(m_egg_options);
@@ -309,6 +315,7 @@ GameSettings::GameSettings()
     PA_ADD_OPTION(SQUARE_SPARKLE_ALPHA);
     PA_ADD_OPTION(LINE_SPARKLE_ALPHA);
     PA_ADD_OPTION(SHINY_DIALOG_ALPHA);
+    PA_ADD_OPTION(SPARKLE_HEAT_MAP);
 
 //    PA_ADD_STATIC(m_experimental);
 }
@@ -80,6 +80,8 @@ public:
     FloatingPointOption LINE_SPARKLE_ALPHA;
 
     FloatingPointOption SHINY_DIALOG_ALPHA;
+
+    BooleanCheckBoxOption SPARKLE_HEAT_MAP;
 };
 
 
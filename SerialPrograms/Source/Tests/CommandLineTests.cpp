@@ -7,8 +7,13 @@
 
 #include "CommandLineTests.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "PokemonLA_Tests.h"
+#include "TestAllocationCounter.h"
 #include "TestMap.h"
 #include <QDir>
 #include <QDirIterator>
@@ -19,6 +24,10 @@
 #include <thread>
 #include <map>
 #include <list>
+#include <deque>
+#include <algorithm>
+#include <mutex>
+#include <streambuf>
 #include <functional>
 using std::cout;
 using std::cerr;
@@ -46,25 +55,305 @@ void print_equals(){
         } \
     } while (0)
 
-#define RETURN_IF_TEST_FAILED(test_func, file_path, num_passed) \
+#define RETURN_IF_TEST_FAILED(runner, test_key, test_func, file_path) \
     do { \
-        int _ret = 0; \
-        try{ \
-            _ret = test_func(file_path); \
-        } catch (const std::exception& e) { \
-            cout << "Test: " << (file_path) << " threw exception: " << e.what() << endl; \
-        } catch (const Exception& e) {\
-           cout << "Test: " << (file_path) << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl; \
-        } \
+        int _ret = (runner).run_test_file((test_key), (test_func), (file_path)); \
         if (_ret > 0) {\
-            print_equals(); \
-            cout << "Test: " << (file_path) << " failed." << endl; \
             return _ret; \
-        }else if (_ret == 0){ \
-            num_passed++; \
         } \
     } while (0)
 
+
+//  Redirect everything written to cout/cerr by a thread that is running a test
+//  into that test's own buffer. Threads that are not running a test write to
+//  the original stream as before.
+class TestOutputRouter : public std::streambuf{
+public:
+    TestOutputRouter(std::ostream& stream)
+        : m_stream(stream)
+        , m_original(stream.rdbuf(this))
+    {}
+    ~TestOutputRouter(){
+        m_stream.rdbuf(m_original);
+    }
+
+    static thread_local std::string* t_capture;
+
+protected:
+    virtual int overflow(int c) override{
+        if (c == traits_type::eof()){
+            return traits_type::not_eof(c);
+        }
+        char ch = (char)c;
+        xsputn(&ch, 1);
+        return c;
+    }
+    virtual std::streamsize xsputn(const char* str, std::streamsize count) override{
+        std::string* capture = t_capture;
+        if (capture != nullptr){
+            capture->append(str, (size_t)count);
+            return count;
+        }
+        std::lock_guard<std::mutex> lg(m_lock);
+        return m_original->sputn(str, count);
+    }
+    virtual int sync() override{
+        if (t_capture != nullptr){
+            return 0;
+        }
+        std::lock_guard<std::mutex> lg(m_lock);
+        return m_original->pubsync();
+    }
+
+private:
+    std::ostream& m_stream;
+    std::streambuf* m_original;
+    std::mutex m_lock;
+};
+thread_local std::string* TestOutputRouter::t_capture = nullptr;
+
+
+//  Benchmarks must not share the machine with other tests. Their timings would
+//  be meaningless and some of them change process-wide state while they run.
+//  (e.g. Kernels_Benchmark switches CPU_CAPABILITY_CURRENT between levels.)
+bool test_runs_alone(const std::string& test_key){
+    const std::string suffix = "_Benchmark";
+    return test_key.size() >= suffix.size() &&
+        test_key.compare(test_key.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+
+struct TestRecord{
+    std::string test_key;
+    std::string file_path;
+    TestFunction test_func;
+
+    //  Return value of the test function.
+    //  0: passed, > 0: failed, < 0: skipped.
+    int result = 0;
+    std::string exception;
+    std::string output;
+    double wall_ms = 0;
+    TestAllocationStats allocations;
+};
+
+void run_test_record(TestRecord& record){
+    TestAllocationCounter counter;
+    WallClock start = current_time();
+    try{
+        record.result = record.test_func(record.file_path);
+    }catch (const std::exception& e){
+        record.exception = std::string("exception: ") + e.what();
+    }catch (const Exception& e){
+        record.exception = std::string(e.name()) + ": <<<" + e.message() + ">>>";
+    }
+    WallClock end = current_time();
+    record.wall_ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.;
+    record.allocations = counter.stats();
+}
+
+
+//  Runs the test files found by the directory traversal below.
+//
+//  With one thread, each test file runs as soon as it is found and the run
+//  stops at the first failure.
+//  With more threads, test files are queued up and run on a thread pool in
+//  finish(). Each test's console output is captured separately and printed
+//  in traversal order once everything is done. Tests that must run alone
+//  (see test_runs_alone()) are held back until the thread pool has drained
+//  and then run one at a time.
+class CommandLineTestRunner{
+public:
+    CommandLineTestRunner(size_t threads)
+        : m_threads(threads)
+    {}
+
+    bool parallel() const{ return m_threads > 1; }
+
+    int run_test_file(const std::string& test_key, const TestFunction& test_func, const std::string& file_path){
+        m_records.emplace_back();
+        TestRecord& record = m_records.back();
+        record.test_key = test_key;
+        record.file_path = file_path;
+        record.test_func = test_func;
+        if (parallel()){
+            return 0;
+        }
+
+        run_test_record(record);
+        if (!record.exception.empty()){
+            cout << "Test: " << file_path << " threw " << record.exception << endl;
+        }
+        if (record.result > 0){
+            print_equals();
+            cout << "Test: " << file_path << " failed." << endl;
+        }
+        return record.result;
+    }
+
+    //  Run everything that was queued. Return the first failure code in
+    //  traversal order or 0 if all tests passed.
+    int finish(){
+        if (parallel()){
+            run_queued_tests();
+        }
+
+        int ret = 0;
+        size_t num_passed = 0;
+        for (const TestRecord& record : m_records){
+            if (record.result == 0){
+                num_passed++;
+            }else if (record.result > 0 && ret == 0){
+                ret = record.result;
+            }
+        }
+
+        const std::string& report_path = GlobalSettings::instance().COMMAND_LINE_TEST_REPORT;
+        if (!report_path.empty()){
+            write_report(report_path);
+            cout << "Wrote test report to " << report_path << endl;
+        }
+
+        print_equals();
+        cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed" << std::endl;
+        return ret;
+    }
+
+private:
+    void run_queued_tests(){
+        cout << "Running " << m_records.size() << " test files on " << m_threads << " threads..." << endl;
+        {
+            TestOutputRouter cout_router(std::cout);
+            TestOutputRouter cerr_router(std::cerr);
+            ParallelTaskRunner task_runner(
+                [](){ GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread(); },
+                0, m_threads
+            );
+            for (TestRecord& record : m_records){
+                if (test_runs_alone(record.test_key)){
+                    continue;
+                }
+                task_runner.dispatch([&record]{
+                    TestOutputRouter::t_capture = &record.output;
+                    run_test_record(record);
+                    TestOutputRouter::t_capture = nullptr;
+                });
+            }
+            task_runner.wait_for_everything();
+
+            for (TestRecord& record : m_records){
+                if (!test_runs_alone(record.test_key)){
+                    continue;
+                }
+                TestOutputRouter::t_capture = &record.output;
+                run_test_record(record);
+                TestOutputRouter::t_capture = nullptr;
+            }
+        }
+
+        //  Only print the output of tests that need attention.
+        size_t num_failed = 0;
+        for (const TestRecord& record : m_records){
+            if (record.result <= 0 && record.exception.empty()){
+                continue;
+            }
+            print_equals();
+            cout << record.file_path << endl;
+            cout << record.output;
+            if (!record.exception.empty()){
+                cout << "Test: " << record.file_path << " threw " << record.exception << endl;
+            }
+            if (record.result > 0){
+                cout << "Test: " << record.file_path << " failed." << endl;
+                num_failed++;
+            }
+        }
+        if (num_failed > 0){
+            print_equals();
+            cout << num_failed << " test" << (num_failed > 1 ? "s" : "") << " failed" << endl;
+        }
+    }
+
+    void write_report(const std::string& report_path) const{
+        struct Summary{
+            size_t files = 0;
+            size_t passed = 0;
+            size_t failed = 0;
+            double total_ms = 0;
+            double max_ms = 0;
+            TestAllocationStats allocations;
+        };
+        std::map<std::string, Summary> summaries;
+
+        JsonArray tests;
+        double total_ms = 0;
+        for (const TestRecord& record : m_records){
+            JsonObject test;
+            test["test"] = record.test_key;
+            test["file"] = record.file_path;
+            test["result"] = record.result == 0 ? "passed" : record.result > 0 ? "failed" : "skipped";
+            test["wall_ms"] = record.wall_ms;
+            if (TestAllocationCounter::ENABLED){
+                test["allocations"] = record.allocations.allocations;
+                test["allocated_bytes"] = record.allocations.bytes;
+            }
+            if (!record.exception.empty()){
+                test["exception"] = record.exception;
+            }
+            if (!record.output.empty()){
+                test["output"] = record.output;
+            }
+            tests.push_back(std::move(test));
+
+            total_ms += record.wall_ms;
+            if (record.result < 0){
+                continue;
+            }
+            Summary& summary = summaries[record.test_key];
+            summary.files++;
+            if (record.result == 0){
+                summary.passed++;
+            }else{
+                summary.failed++;
+            }
+            summary.total_ms += record.wall_ms;
+            summary.max_ms = std::max(summary.max_ms, record.wall_ms);
+            summary.allocations.allocations += record.allocations.allocations;
+            summary.allocations.bytes += record.allocations.bytes;
+        }
+
+        JsonObject functions;
+        for (const auto& item : summaries){
+            const Summary& summary = item.second;
+            JsonObject obj;
+            obj["files"] = summary.files;
+            obj["passed"] = summary.passed;
+            obj["failed"] = summary.failed;
+            obj["total_ms"] = summary.total_ms;
+            obj["mean_ms"] = summary.total_ms / summary.files;
+            obj["max_ms"] = summary.max_ms;
+            if (TestAllocationCounter::ENABLED){
+                obj["allocations"] = summary.allocations.allocations;
+                obj["allocated_bytes"] = summary.allocations.bytes;
+            }
+            functions[item.first] = std::move(obj);
+        }
+
+        JsonObject report;
+        report["threads"] = m_threads;
+        report["test_files"] = m_records.size();
+        report["total_test_ms"] = total_ms;
+        report["test_functions"] = std::move(functions);
+        report["tests"] = std::move(tests);
+        JsonValue(std::move(report)).dump(report_path);
+    }
+
+private:
+    const size_t m_threads;
+    std::deque<TestRecord> m_records;
+};
+
+
 bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ignore_list){
     for(const auto& path_prefix : ignore_list){
         if (file_path.startsWith(path_prefix)){
@@ -75,12 +364,14 @@ bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ign
     return false;
 }
 
-int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size_t& num_passed, const std::vector<QString>& ignore_list){
+int run_test_obj_dir(
+    const std::string& test_key, TestFunction test_func, const QString& directory_path,
+    CommandLineTestRunner& runner, const std::vector<QString>& ignore_list){
     QDirIterator file_iter(directory_path, QDir::Filter::Files, QDirIterator::IteratorFlag::Subdirectories);
 
     bool first_test_file = true;
     while (file_iter.hasNext()){
-        if (first_test_file == false){
+        if (first_test_file == false && !runner.parallel()){
             cout << "-------------------------------------------" << endl;
         }
         first_test_file = false;
@@ -100,8 +391,10 @@ int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size
         }
 
         // Call the function to do the actual test:
-        cout << file_path << endl;
-        RETURN_IF_TEST_FAILED(test_func, file_path, num_passed);
+        if (!runner.parallel()){
+            cout << file_path << endl;
+        }
+        RETURN_IF_TEST_FAILED(runner, test_key, test_func, file_path);
     }
 
     return 0;
@@ -109,7 +402,7 @@ int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size
 
 // Run the tests inside a folder representing a "test object".
 // It is usually defined as one detector, e.g. CommandLineTests/PokemonLA/BattleMenuDetector/
-int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, CommandLineTestRunner& runner, const std::vector<QString>& ignore_list){
     const std::string test_name = obj_info.fileName().toStdString();
     if (test_name == "." || test_name == ".."){
         return 0;
@@ -130,12 +423,12 @@ int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_
 
     // Recursively get test filenames, like:
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/IngoBattleMenuDayTime_True.png
-    return run_test_obj_dir(test_func, obj_info.filePath(), num_passed, ignore_list);
+    return run_test_obj_dir(test_space + "_" + test_name, test_func, obj_info.filePath(), runner, ignore_list);
 }
 
 // Run the tests inside a folder representing a "test space".
 // It is usually defined as one pokemon game, e.g. CommandLineTests/PokemonLA/
-int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+int run_test_space(const QFileInfo& space_info, CommandLineTestRunner& runner, const std::vector<QString>& ignore_list){
     QDir sub_dir(space_info.filePath());
     if (!sub_dir.exists()){
         cerr << "Error: cannot access " << space_info.filePath().toStdString() << endl;
@@ -157,7 +450,7 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/
     const QFileInfoList obj_list = sub_dir.entryInfoList();
     for(const QFileInfo& obj_info : obj_list){
-        RETURN_IF_NOT_ZERO(run_test_obj(test_space, obj_info, num_passed, ignore_list));
+        RETURN_IF_NOT_ZERO(run_test_obj(test_space, obj_info, runner, ignore_list));
     }
 
     return 0;
@@ -166,11 +459,8 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
 
 
 
-} // end of anonymous namespace
-
-
-
-int run_command_line_tests(){
+// Find the test files and hand them to the runner.
+int run_test_root(CommandLineTestRunner& runner){
     const auto& root_folder_name = GlobalSettings::instance().COMMAND_LINE_TEST_FOLDER;
 
     QDir test_root_dir(root_folder_name.c_str());
@@ -181,8 +471,6 @@ int run_command_line_tests(){
 
     QFileInfo test_root_info(root_folder_name.c_str());
 
-    size_t num_passed = 0;
-
     const auto& selected_test_list = GlobalSettings::instance().COMMAND_LINE_TEST_LIST;
 
     // The ignore list will be used to skip path.
@@ -206,7 +494,7 @@ int run_command_line_tests(){
         test_root_dir.setFilter(QDir::Filter::Dirs);
         const QFileInfoList sub_dir_list = test_root_dir.entryInfoList();
         for(const QFileInfo& sub_dir_info : sub_dir_list){
-            RETURN_IF_NOT_ZERO(run_test_space(sub_dir_info, num_passed, ignore_list));
+            RETURN_IF_NOT_ZERO(run_test_space(sub_dir_info, runner, ignore_list));
         }
     }else{
         // Only run on selected tests
@@ -259,7 +547,7 @@ int run_command_line_tests(){
             QFileInfo test_space_info(cur_dir.filePath(*it));
             cur_dir = QDir(test_space_info.filePath());
             if (path_components.size() == 1){
-                RETURN_IF_NOT_ZERO(run_test_space(test_space_info, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(run_test_space(test_space_info, runner, ignore_list));
                 continue;
             }
 
@@ -267,7 +555,7 @@ int run_command_line_tests(){
             std::string test_name = it->toStdString();
             QFileInfo test_obj_info(cur_dir.filePath(*it));
             if (path_components.size() == 2){
-                RETURN_IF_NOT_ZERO(run_test_obj(test_space, test_obj_info, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(run_test_obj(test_space, test_obj_info, runner, ignore_list));
                 continue;
             }
 
@@ -279,18 +567,33 @@ int run_command_line_tests(){
             print_equals();
             if (selected_path_info.isFile()){
                 // Call the function to do the actual test:
-                RETURN_IF_TEST_FAILED(test_func, full_path_cleaned.toStdString(), num_passed);
+                RETURN_IF_TEST_FAILED(runner, test_space + "_" + test_name, test_func, full_path_cleaned.toStdString());
             }else{
                 // selected_path_info is a directory, go through each file recursively in the directory
-                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_func, full_path_cleaned, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_space + "_" + test_name, test_func, full_path_cleaned, runner, ignore_list));
             }
         } // end selected_test_list
     }
 
-    print_equals();
-    cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed" << std::endl;
     return 0;
 }
 
 
-}
\ No newline at end of file
+
+
+} // end of anonymous namespace
+
+
+
+int run_command_line_tests(){
+    CommandLineTestRunner runner(GlobalSettings::instance().COMMAND_LINE_TEST_THREADS);
+
+    // In serial mode this stops at the first failure. Still print the summary
+    // and write the report for what has run so far.
+    const int ret = run_test_root(runner);
+    const int finish_ret = runner.finish();
+    return ret != 0 ? ret : finish_ret;
+}
+
+
+}
\ No newline at end of file
@@ -47,6 +47,15 @@
  *  
  * Those "hidden" files are useful for storing some metadata in the folder, or serving as an extra file in case some tests need more than one test files.
  * 
+ *  To run the tests faster, set "20-GlobalSettings": "COMMAND_LINE_TESTS": "THREADS" to the number of threads to use.
+ *  With the default of 1, test files run one by one and the run stops at the first failed test. With more threads, all test files
+ *  run on a thread pool. The console output of each test is captured separately and only printed for tests that failed or threw,
+ *  in the same order as a serial run would print them.
+ * 
+ *  To track the performance of the inference code, set "20-GlobalSettings": "COMMAND_LINE_TESTS": "REPORT" to a file path.
+ *  A JSON report is written there at the end of the run. It has the result, wall time and heap allocations of every test file,
+ *  and the totals per test function in TEST_MAP (e.g. "PokemonLA_BattleMenuDetector").
+ * 
  *  How to add new test code:
  * 
  *  The test framework calls TestMap.h: find_test_function(test_space, test_obj_name) to find the test function related to a test path.
@@ -9,7 +9,10 @@
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageMatch/ImageDiff.h"
 #include "CommonFramework/Inference/BlackBorderDetector.h"
+#include "CommonFramework/Inference/FrozenImageDetector.h"
+#include "CommonFramework/InferenceInfra/VisualChangeTracker.h"
 #include "CommonFramework_Tests.h"
 #include "TestUtils.h"
 
@@ -31,5 +34,172 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
     return 0;
 }
 
+int test_CommonFramework_VisualChangeTracker(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_CommonFramework_VisualChangeTracker(), image size " << width << " x " << height << endl;
+    if (width < 4 * VisualChangeTracker::BLOCK_SIZE || height < 4 * VisualChangeTracker::BLOCK_SIZE){
+        cout << "Image is too small. Skipping." << endl;
+        return 0;
+    }
+
+    //  Same image with the top-left block flipped to the opposite brightness.
+    ImageRGB32 changed = image.copy();
+    for (size_t r = 0; r < VisualChangeTracker::BLOCK_SIZE; r++){
+        for (size_t c = 0; c < VisualChangeTracker::BLOCK_SIZE; c++){
+            uint32_t& pixel = changed.pixel(c, r);
+            uint32_t sum = ((pixel >> 16) & 0xff) + ((pixel >> 8) & 0xff) + (pixel & 0xff);
+            pixel = sum > 384 ? 0xff000000 : 0xffffffff;
+        }
+    }
+
+    const ImageFloatBox near_box(0, 0, 16. / width, 16. / height);
+    const ImageFloatBox far_box(0.75, 0.75, 0.25, 0.25);
+
+    {
+        VisualChangeTracker tracker;
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)0);
+
+        //  The first frame marks everything as changed.
+        tracker.push_frame(image, 1);
+        TEST_RESULT_EQUAL(tracker.blocks_changed(), tracker.blocks_total());
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)1);
+
+        //  Identical frame.
+        tracker.push_frame(image, 2);
+        TEST_RESULT_EQUAL(tracker.blocks_changed(), (size_t)0);
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)1);
+        TEST_RESULT_EQUAL(tracker.last_change(far_box), (uint64_t)1);
+
+        //  Only the top-left block changes.
+        tracker.push_frame(changed, 3);
+        TEST_RESULT_EQUAL(tracker.blocks_changed(), (size_t)1);
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)3);
+        TEST_RESULT_EQUAL(tracker.last_change(far_box), (uint64_t)1);
+        TEST_RESULT_EQUAL(tracker.last_change(ImageFloatBox(0, 0, 1, 1)), (uint64_t)3);
+
+        tracker.push_frame(changed, 4);
+        TEST_RESULT_EQUAL(tracker.blocks_changed(), (size_t)0);
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)3);
+
+        //  Changing back is a change too.
+        tracker.push_frame(image, 5);
+        TEST_RESULT_EQUAL(tracker.blocks_changed(), (size_t)1);
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)5);
+
+        //  A resolution change marks everything.
+        tracker.push_frame(image.sub_image(0, 0, width - 1, height), 6);
+        TEST_RESULT_EQUAL(tracker.blocks_changed(), tracker.blocks_total());
+        TEST_RESULT_EQUAL(tracker.last_change(far_box), (uint64_t)6);
+
+        //  No frame at all always reads as changed.
+        tracker.push_frame(ImageViewRGB32(), 7);
+        TEST_RESULT_EQUAL(tracker.last_change(far_box), (uint64_t)7);
+    }
+
+    //  A frame that is never pushed is invisible to the tracker. If the
+    //  change and the revert both happen between two pushes, the tracker
+    //  reports nothing. This is why VisualInferencePivot must push every
+    //  frame it hands to a callback that skips unchanged frames.
+    {
+        //  Frames 2 and 3 had the changed block but were never pushed.
+        VisualChangeTracker tracker;
+        tracker.push_frame(image, 1);
+        tracker.push_frame(image, 4);
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)1);
+
+        tracker.push_frame(changed, 5);
+        tracker.push_frame(image, 6);
+        TEST_RESULT_EQUAL(tracker.last_change(near_box), (uint64_t)6);
+    }
+
+    return 0;
+}
+
+
+int test_CommonFramework_FrozenImageDetector(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_CommonFramework_FrozenImageDetector(), image size " << width << " x " << height << endl;
+
+    //  Same as the production watchdogs.
+    const std::chrono::seconds TIMEOUT(5);
+    const double THRESHOLD = 10;
+
+    //  Top-left quarter flipped to the opposite brightness.
+    ImageRGB32 changed = image.copy();
+    for (size_t r = 0; r < height / 2; r++){
+        for (size_t c = 0; c < width / 2; c++){
+            uint32_t& pixel = changed.pixel(c, r);
+            uint32_t sum = ((pixel >> 16) & 0xff) + ((pixel >> 8) & 0xff) + (pixel & 0xff);
+            pixel = sum > 384 ? 0xff000000 : 0xffffffff;
+        }
+    }
+    if (ImageMatch::pixel_RMSD(image, changed) < 4 * THRESHOLD){
+        cout << "Image doesn't change enough when flipped. Skipping." << endl;
+        return 0;
+    }
+
+    //  Compression-like noise: every channel off by 2.
+    ImageRGB32 noisy = image.copy();
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            uint32_t& pixel = noisy.pixel(c, r);
+            uint32_t out = pixel & 0xff000000;
+            for (int shift = 0; shift < 24; shift += 8){
+                uint32_t channel = (pixel >> shift) & 0xff;
+                channel = (r + c) % 2 ? std::min<uint32_t>(channel + 2, 255) : (channel < 2 ? 0 : channel - 2);
+                out |= channel << shift;
+            }
+            pixel = out;
+        }
+    }
+
+    //  Both modes must give the same answers.
+    const FrozenImageDetector::Mode MODES[] = {
+        FrozenImageDetector::Mode::FULL_FRAME,
+        FrozenImageDetector::Mode::SIGNATURE,
+    };
+    const WallClock t0 = current_time();
+    for (FrozenImageDetector::Mode mode : MODES){
+        cout << "Mode: " << (mode == FrozenImageDetector::Mode::FULL_FRAME ? "FULL_FRAME" : "SIGNATURE") << endl;
+
+        //  Frozen with noise on top.
+        {
+            FrozenImageDetector detector(TIMEOUT, THRESHOLD, mode);
+            TEST_RESULT_EQUAL(detector.process_frame(image, t0), false);
+            TEST_RESULT_EQUAL(detector.process_frame(noisy, t0 + std::chrono::seconds(3)), false);
+            TEST_RESULT_EQUAL(detector.process_frame(image, t0 + std::chrono::seconds(6)), true);
+        }
+
+        //  Keeps changing.
+        {
+            FrozenImageDetector detector(TIMEOUT, THRESHOLD, mode);
+            for (int c = 0; c < 6; c++){
+                const ImageViewRGB32& frame = c % 2 ? (const ImageViewRGB32&)changed : image;
+                TEST_RESULT_EQUAL(detector.process_frame(frame, t0 + std::chrono::seconds(3 * c)), false);
+            }
+        }
+
+        //  A change restarts the timeout.
+        {
+            FrozenImageDetector detector(TIMEOUT, THRESHOLD, mode);
+            TEST_RESULT_EQUAL(detector.process_frame(image, t0), false);
+            TEST_RESULT_EQUAL(detector.process_frame(changed, t0 + std::chrono::seconds(3)), false);
+            TEST_RESULT_EQUAL(detector.process_frame(changed, t0 + std::chrono::seconds(6)), false);
+            TEST_RESULT_EQUAL(detector.process_frame(changed, t0 + std::chrono::seconds(9)), true);
+        }
+
+        //  A resolution change restarts it too.
+        {
+            FrozenImageDetector detector(TIMEOUT, THRESHOLD, mode);
+            TEST_RESULT_EQUAL(detector.process_frame(image, t0), false);
+            TEST_RESULT_EQUAL(detector.process_frame(image.sub_image(0, 0, width - 1, height), t0 + std::chrono::seconds(6)), false);
+        }
+    }
+
+    return 0;
+}
+
 
 }
@@ -15,6 +15,10 @@ class ImageViewRGB32;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+int test_CommonFramework_VisualChangeTracker(const ImageViewRGB32& image);
+
+int test_CommonFramework_FrozenImageDetector(const ImageViewRGB32& image);
+
 }
 
 #endif
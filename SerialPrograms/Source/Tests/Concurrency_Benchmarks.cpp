@@ -0,0 +1,204 @@
+/*  Concurrency Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <functional>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <QFileInfo>
+#include <QDir>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
+#include "Common/Cpp/Concurrency/WorkStealingPool.h"
+#include "Concurrency_Benchmarks.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+struct Workload{
+    std::string name;
+    size_t tasks;
+    size_t work;    //  Iterations of busy work per task.
+};
+
+//  A few ns per iteration. Returns something so it can't be optimized out.
+uint64_t busy_work(uint64_t seed, size_t iterations){
+    uint64_t x = seed | 1;
+    for (size_t c = 0; c < iterations; c++){
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+struct BenchmarkResult{
+    size_t iterations = 0;
+    double us_per_pass = 0;
+    double ns_per_task = 0;
+};
+
+BenchmarkResult time_pass(
+    const std::function<void()>& pass,
+    size_t tasks,
+    std::chrono::milliseconds min_time
+){
+    pass();     //  Warm up.
+
+    BenchmarkResult result;
+    WallClock start = current_time();
+    std::chrono::nanoseconds elapsed(0);
+    while (elapsed < min_time){
+        pass();
+        result.iterations++;
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time() - start);
+    }
+
+    double ns = (double)elapsed.count() / result.iterations;
+    result.us_per_pass = ns / 1000;
+    result.ns_per_task = ns / tasks;
+    return result;
+}
+
+
+}
+
+
+
+int test_concurrency_Benchmark(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t min_time_ms = 200;
+    int64_t max_threads = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(min_time_ms, "MIN_TIME_MS", 1, 60000);
+            obj->read_integer(max_threads, "MAX_THREADS", 1, 1024);
+        }
+    }
+    const std::chrono::milliseconds min_time(min_time_ms);
+
+    const std::vector<Workload> workloads{
+        {"coarse", 256, 50000},
+        {"fine", 16384, 1000},
+        {"tiny", 65536, 100},
+    };
+
+    //  run_in_parallel() starts a thread for every task. Past this it's
+    //  measuring thread creation.
+    const size_t MAX_DISPATCHER_TASKS = 256;
+
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < (size_t)max_threads; threads *= 2){
+        thread_counts.emplace_back(threads);
+    }
+    thread_counts.emplace_back(max_threads);
+
+    JsonObject results;
+    for (const Workload& workload : workloads){
+        cout << workload.name << ": " << workload.tasks << " tasks x " << workload.work << " iterations" << endl;
+        std::vector<uint64_t> out(workload.tasks);
+
+        JsonObject workload_results;
+        for (size_t threads : thread_counts){
+            ParallelTaskRunner runner([]{}, threads, threads);
+            AsyncDispatcher dispatcher([]{}, threads);
+            WorkStealingPool pool([]{}, threads);
+
+            struct Path{
+                std::string name;
+                std::function<void()> pass;
+            };
+            std::vector<Path> paths{
+                {"ParallelTaskRunner", [&]{
+                    std::vector<std::shared_ptr<AsyncTask>> tasks;
+                    tasks.reserve(workload.tasks);
+                    for (size_t c = 0; c < workload.tasks; c++){
+                        tasks.emplace_back(runner.dispatch([&, c]{
+                            out[c] = busy_work(c, workload.work);
+                        }));
+                    }
+                    for (std::shared_ptr<AsyncTask>& task : tasks){
+                        task->wait_and_rethrow_exceptions();
+                    }
+                }},
+                {"WorkStealingPool grain=1", [&]{
+                    pool.parallel_for(0, workload.tasks, 1, [&](size_t c){
+                        out[c] = busy_work(c, workload.work);
+                    });
+                }},
+                {"WorkStealingPool grain=auto", [&]{
+                    size_t grain = std::max<size_t>(workload.tasks / (threads * 16), 1);
+                    pool.parallel_for(0, workload.tasks, grain, [&](size_t c){
+                        out[c] = busy_work(c, workload.work);
+                    });
+                }},
+            };
+            if (workload.tasks <= MAX_DISPATCHER_TASKS){
+                paths.push_back({"AsyncDispatcher", [&]{
+                    dispatcher.run_in_parallel(0, workload.tasks, [&](size_t c){
+                        out[c] = busy_work(c, workload.work);
+                    });
+                }});
+            }
+
+            JsonObject thread_results;
+            for (const Path& path : paths){
+                BenchmarkResult result = time_pass(path.pass, workload.tasks, min_time);
+                cout << "    threads = " << std::setw(3) << threads << "  "
+                     << std::left << std::setw(28) << path.name << std::right
+                     << std::setw(12) << std::fixed << std::setprecision(1) << result.us_per_pass << " us/pass, "
+                     << std::setw(10) << std::setprecision(1) << result.ns_per_task << " ns/task" << endl;
+                cout.unsetf(std::ios::floatfield);
+
+                JsonObject obj;
+                obj["iterations"] = result.iterations;
+                obj["us_per_pass"] = result.us_per_pass;
+                obj["ns_per_task"] = result.ns_per_task;
+                thread_results[path.name] = std::move(obj);
+            }
+            workload_results[std::to_string(threads)] = std::move(thread_results);
+        }
+
+        JsonObject obj;
+        obj["tasks"] = workload.tasks;
+        obj["work"] = workload.work;
+        obj["threads"] = std::move(workload_results);
+        results[workload.name] = std::move(obj);
+    }
+
+    JsonObject report;
+    report["min_time_ms"] = min_time_ms;
+    report["max_threads"] = max_threads;
+    report["results"] = std::move(results);
+
+    const std::string output_path = file_info.dir().filePath(
+        "_" + file_info.completeBaseName() + "-Results.json"
+    ).toStdString();
+    JsonValue(std::move(report)).dump(output_path);
+    cout << "Wrote benchmark results to " << output_path << endl;
+
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,30 @@
+/*  Concurrency Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_Concurrency_Benchmarks_H
+#define PokemonAutomation_Tests_Concurrency_Benchmarks_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Time many small compute tasks through each way of running them in
+//  parallel: ParallelTaskRunner, AsyncDispatcher::run_in_parallel() and
+//  WorkStealingPool::parallel_for(). Each is run with 1, 2, 4, ... threads
+//  to show how it scales.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "MIN_TIME_MS": Minimum time to spend on each case. (default: 200)
+//    - "MAX_THREADS": Most threads to try. (default: # of CPU threads)
+//
+//  The results are printed and written next to the config as
+//  "_<config name>-Results.json".
+int test_concurrency_Benchmark(const std::string& config_path);
+
+
+}
+#endif
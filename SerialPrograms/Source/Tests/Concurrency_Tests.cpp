@@ -0,0 +1,400 @@
+/*  Concurrency Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <QFileInfo>
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Concurrency/WorkStealingPool.h"
+#include "CommonFramework/InferenceInfra/InferenceExecutor.h"
+#include "Concurrency_Tests.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+struct IndexError : public std::runtime_error{
+    IndexError(size_t p_index)
+        : std::runtime_error("index " + std::to_string(p_index))
+        , index(p_index)
+    {}
+    size_t index;
+};
+
+
+//  Run [start, end) once and check that each index was hit exactly once and
+//  nothing outside the range was touched.
+bool run_once_and_check(
+    WorkStealingPool& pool,
+    size_t start, size_t end, size_t grain,
+    const std::string& label
+){
+    std::unique_ptr<std::atomic<uint32_t>[]> counts(new std::atomic<uint32_t>[end + 1]);
+    for (size_t c = 0; c <= end; c++){
+        counts[c].store(0, std::memory_order_relaxed);
+    }
+    pool.parallel_for(start, end, grain, [&](size_t index){
+        counts[index].fetch_add(1, std::memory_order_relaxed);
+    });
+    for (size_t c = 0; c <= end; c++){
+        uint32_t expected = start <= c && c < end ? 1 : 0;
+        uint32_t actual = counts[c].load(std::memory_order_relaxed);
+        if (actual != expected){
+            cerr << "Error: " << label << ": [" << start << ", " << end << ") grain = " << grain
+                 << ": index " << c << " ran " << actual << " times. Expected " << expected << "." << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_exactly_once(WorkStealingPool& pool){
+    const size_t SIZES[] = {0, 1, 2, 3, 7, 64, 1000, 100003};
+    const size_t GRAINS[] = {0, 1, 3, 64, 1000000};
+    for (size_t size : SIZES){
+        for (size_t grain : GRAINS){
+            if (!run_once_and_check(pool, 0, size, grain, "exactly once")){
+                return false;
+            }
+        }
+    }
+    //  Non-zero start.
+    return run_once_and_check(pool, 17, 5000, 1, "exactly once");
+}
+
+bool test_nested(WorkStealingPool& pool){
+    const size_t OUTER = 64;
+    const size_t MIDDLE = 17;
+    const size_t INNER = 33;
+    std::vector<std::atomic<uint32_t>> counts(OUTER * MIDDLE * INNER);
+    for (std::atomic<uint32_t>& count : counts){
+        count.store(0, std::memory_order_relaxed);
+    }
+    pool.parallel_for(0, OUTER, 1, [&](size_t a){
+        pool.parallel_for(0, MIDDLE, 1, [&](size_t b){
+            pool.parallel_for(0, INNER, 1, [&](size_t c){
+                counts[(a * MIDDLE + b) * INNER + c].fetch_add(1, std::memory_order_relaxed);
+            });
+        });
+    });
+    for (size_t c = 0; c < counts.size(); c++){
+        uint32_t actual = counts[c].load(std::memory_order_relaxed);
+        if (actual != 1){
+            cerr << "Error: nested: index " << c << " ran " << actual << " times." << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_outside_callers(WorkStealingPool& pool){
+    const size_t CALLERS = 8;
+    const size_t CALLS = 50;
+    std::atomic<size_t> failures(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < CALLERS; t++){
+        threads.emplace_back([&, t]{
+            for (size_t c = 0; c < CALLS; c++){
+                size_t size = 1 + (t * 131 + c * 977) % 5000;
+                size_t grain = 1 + c % 4;
+                if (!run_once_and_check(pool, 0, size, grain, "caller " + std::to_string(t))){
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+    return failures.load() == 0;
+}
+
+bool test_exceptions(WorkStealingPool& pool){
+    const size_t SIZE = 10000;
+    const size_t THROW_AT[] = {0, 37, SIZE / 2, SIZE - 1};
+
+    for (size_t throw_at : THROW_AT){
+        try{
+            pool.parallel_for(0, SIZE, 1, [&](size_t index){
+                if (index == throw_at){
+                    throw IndexError(index);
+                }
+            });
+            cerr << "Error: exceptions: nothing was thrown for index " << throw_at << "." << endl;
+            return false;
+        }catch (IndexError& e){
+            if (e.index != throw_at){
+                cerr << "Error: exceptions: caught " << e.what() << ". Expected index " << throw_at << "." << endl;
+                return false;
+            }
+        }
+    }
+
+    //  From a nested call, through the outer one.
+    try{
+        pool.parallel_for(0, 32, 1, [&](size_t a){
+            pool.parallel_for(0, 32, 1, [&](size_t b){
+                if (a == 5 && b == 7){
+                    throw IndexError(a * 32 + b);
+                }
+            });
+        });
+        cerr << "Error: exceptions: nothing was thrown from the nested call." << endl;
+        return false;
+    }catch (IndexError& e){
+        if (e.index != 5 * 32 + 7){
+            cerr << "Error: exceptions: caught " << e.what() << " from the nested call." << endl;
+            return false;
+        }
+    }
+
+    //  Every index throws. Exactly one of them must come out.
+    try{
+        pool.parallel_for(0, SIZE, 1, [&](size_t index){
+            throw IndexError(index);
+        });
+        cerr << "Error: exceptions: nothing was thrown when every index throws." << endl;
+        return false;
+    }catch (IndexError&){}
+
+    //  The pool must still work afterwards.
+    return run_once_and_check(pool, 0, SIZE, 1, "after exceptions");
+}
+
+
+}
+
+
+
+int test_concurrency_WorkStealingPool(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t threads = 4;
+    int64_t rounds = 20;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(threads, "THREADS", 1, 1024);
+            obj->read_integer(rounds, "ROUNDS", 1, 100000);
+        }
+    }
+
+    WorkStealingPool pool([]{}, (size_t)threads);
+    cout << "WorkStealingPool: " << pool.threads() << " threads, " << rounds << " rounds" << endl;
+
+    for (int64_t round = 0; round < rounds; round++){
+        if (!test_exactly_once(pool)){
+            return 1;
+        }
+        if (!test_nested(pool)){
+            return 1;
+        }
+        if (!test_outside_callers(pool)){
+            return 1;
+        }
+        if (!test_exceptions(pool)){
+            return 1;
+        }
+    }
+
+    cout << "WorkStealingPool: passed" << endl;
+    return 0;
+}
+
+
+
+namespace{
+
+
+using Priority = InferenceExecutor::Priority;
+
+
+//  The order in which leases were granted.
+class GrantLog{
+public:
+    void add(std::string name){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_names.emplace_back(std::move(name));
+    }
+    std::vector<std::string> names(){
+        std::lock_guard<std::mutex> lg(m_lock);
+        return m_names;
+    }
+
+private:
+    std::mutex m_lock;
+    std::vector<std::string> m_names;
+};
+
+//  Take a lease on a new thread and log "name" as soon as it is granted.
+std::thread start_lease(
+    InferenceExecutor::Client& client, Priority priority,
+    GrantLog& log, std::string name
+){
+    return std::thread([&client, priority, &log, name = std::move(name)]{
+        InferenceExecutor::Lease lease(client, priority);
+        log.add(name);
+    });
+}
+
+//  Wait until "count" leases are queued.
+void wait_for_waiting(const InferenceExecutor& executor, size_t count){
+    while (executor.waiting() < count){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+bool check_order(const char* test, GrantLog& log, const std::vector<std::string>& expected){
+    std::vector<std::string> names = log.names();
+    if (names == expected){
+        return true;
+    }
+    cerr << "Error: InferenceExecutor " << test << ": granted in order";
+    for (const std::string& name : names){
+        cerr << " " << name;
+    }
+    cerr << ", expected";
+    for (const std::string& name : expected){
+        cerr << " " << name;
+    }
+    cerr << "." << endl;
+    return false;
+}
+
+
+//  2 workers. Both are held while a normal lease and two time-critical
+//  leases queue up. Then one worker goes around all of them.
+bool test_critical_first(){
+    InferenceExecutor executor(2);
+    InferenceExecutor::Client a(executor);
+    InferenceExecutor::Client b(executor);
+    InferenceExecutor::Client c(executor);
+
+    auto held0 = std::make_unique<InferenceExecutor::Lease>(a, Priority::NORMAL);
+    auto held1 = std::make_unique<InferenceExecutor::Lease>(b, Priority::NORMAL);
+    if (executor.waiting() != 0){
+        cerr << "Error: InferenceExecutor critical: a free worker wasn't granted." << endl;
+        return false;
+    }
+
+    GrantLog log;
+    std::vector<std::thread> threads;
+    threads.emplace_back(start_lease(c, Priority::NORMAL, log, "normal"));
+    wait_for_waiting(executor, 1);
+    threads.emplace_back(start_lease(a, Priority::TIME_CRITICAL, log, "critical0"));
+    wait_for_waiting(executor, 2);
+    threads.emplace_back(start_lease(b, Priority::TIME_CRITICAL, log, "critical1"));
+    wait_for_waiting(executor, 3);
+
+    held0.reset();
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+    held1.reset();
+
+    return check_order("critical", log, {"critical0", "critical1", "normal"});
+}
+
+//  1 worker. Client "a" has used some worker time and "b" hasn't. "a" asks
+//  first, but "b" must go first. Then a new client must start at the share
+//  time "a" had when it was picked.
+bool test_lowest_share_first(){
+    InferenceExecutor executor(1);
+    InferenceExecutor::Client a(executor);
+    InferenceExecutor::Client b(executor);
+    InferenceExecutor::Client c(executor);
+
+    {
+        InferenceExecutor::Lease lease(a, Priority::NORMAL);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    const WallClock::duration a_share = a.share_time();
+    if (a_share < std::chrono::milliseconds(20) || b.share_time() != WallClock::duration(0)){
+        cerr << "Error: InferenceExecutor share time: lease time wasn't added to the client." << endl;
+        return false;
+    }
+
+    auto held = std::make_unique<InferenceExecutor::Lease>(c, Priority::NORMAL);
+
+    GrantLog log;
+    std::vector<std::thread> threads;
+    threads.emplace_back(start_lease(a, Priority::NORMAL, log, "a"));
+    wait_for_waiting(executor, 1);
+    threads.emplace_back(start_lease(b, Priority::NORMAL, log, "b"));
+    wait_for_waiting(executor, 2);
+
+    held.reset();
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+    if (!check_order("share time", log, {"b", "a"})){
+        return false;
+    }
+
+    //  "a" was the last client picked.
+    InferenceExecutor::Client d(executor);
+    if (d.share_time() != a_share){
+        cerr << "Error: InferenceExecutor new client: share time is "
+             << std::chrono::duration_cast<std::chrono::microseconds>(d.share_time()).count()
+             << "us, expected "
+             << std::chrono::duration_cast<std::chrono::microseconds>(a_share).count()
+             << "us." << endl;
+        return false;
+    }
+    return true;
+}
+
+
+}
+
+
+int test_concurrency_InferenceExecutor(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t rounds = 5;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(rounds, "ROUNDS", 1, 100000);
+        }
+    }
+
+    for (int64_t round = 0; round < rounds; round++){
+        if (!test_critical_first()){
+            return 1;
+        }
+        if (!test_lowest_share_first()){
+            return 1;
+        }
+    }
+
+    cout << "InferenceExecutor: passed" << endl;
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,40 @@
+/*  Concurrency Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_Concurrency_Tests_H
+#define PokemonAutomation_Tests_Concurrency_Tests_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Check that WorkStealingPool::parallel_for():
+//    - Runs every index exactly once for a range of sizes and grains.
+//    - Handles parallel_for() calls nested inside each other.
+//    - Handles many threads outside the pool calling it at the same time.
+//    - Rethrows an exception from any index in the caller, including from a
+//      nested call, and keeps working afterwards.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "THREADS": Pool size. (default: 4, so the test still has real
+//      concurrency on machines with fewer cores)
+//    - "ROUNDS": How many times to repeat everything. (default: 20)
+int test_concurrency_WorkStealingPool(const std::string& config_path);
+
+
+//  Check the order in which InferenceExecutor hands out workers:
+//    - Time-critical leases go first, in the order they asked.
+//    - Otherwise, the client with the lowest share time goes first.
+//    - A new client starts at the share time of the last client picked.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "ROUNDS": How many times to repeat everything. (default: 5)
+int test_concurrency_InferenceExecutor(const std::string& config_path);
+
+
+}
+#endif
@@ -0,0 +1,317 @@
+/*  Discord Webhook Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <vector>
+#include <iostream>
+#include <QFileInfo>
+#include <QThread>
+#include <QCoreApplication>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "Integrations/DiscordWebhookDelivery.h"
+#include "DiscordWebhook_Tests.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace Integration::DiscordWebhook;
+
+
+namespace{
+
+
+//  Minimal HTTP/1.1 server that answers like a Discord webhook.
+class StandInWebhookServer{
+public:
+    struct Request{
+        WallClock time;
+        size_t connection;
+        QByteArray headers;
+        QByteArray body;
+    };
+
+    //  Index of the request that gets a 429.
+    size_t rate_limit_request = 1;
+    double retry_after = 0.25;
+
+    //  Bucket size. "X-RateLimit-Remaining" counts down to 0 and resets after
+    //  "reset_after" seconds.
+    size_t bucket_size = 5;
+    double reset_after = 0.1;
+
+    std::vector<Request> requests;
+    size_t connections = 0;
+    bool malformed = false;
+
+public:
+    StandInWebhookServer(){
+        m_server.listen(QHostAddress::LocalHost, 0);
+        QObject::connect(&m_server, &QTcpServer::newConnection, [this]{
+            while (QTcpSocket* socket = m_server.nextPendingConnection()){
+                size_t id = connections++;
+                QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket, id]{
+                    on_read(socket, id);
+                });
+                QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+    bool listening() const{
+        return m_server.isListening();
+    }
+    QUrl url(const std::string& token) const{
+        return QUrl(
+            "http://127.0.0.1:" + QString::number(m_server.serverPort()) +
+            "/api/webhooks/" + QString::fromStdString(token)
+        );
+    }
+
+private:
+    void on_read(QTcpSocket* socket, size_t id){
+        QByteArray& buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        while (true){
+            int header_end = buffer.indexOf("\r\n\r\n");
+            if (header_end < 0){
+                return;
+            }
+            QByteArray headers = buffer.left(header_end);
+            if (headers.toLower().contains("transfer-encoding: chunked")){
+                malformed = true;
+                socket->abort();
+                return;
+            }
+            int length = 0;
+            for (const QByteArray& line : headers.split('\n')){
+                QByteArray trimmed = line.trimmed();
+                if (trimmed.toLower().startsWith("content-length:")){
+                    length = trimmed.mid(15).trimmed().toInt();
+                }
+            }
+            if (buffer.size() < header_end + 4 + length){
+                return;
+            }
+            Request request{current_time(), id, headers, buffer.mid(header_end + 4, length)};
+            buffer.remove(0, header_end + 4 + length);
+            respond(socket);
+            requests.emplace_back(std::move(request));
+        }
+    }
+    void respond(QTcpSocket* socket){
+        if (requests.size() == rate_limit_request){
+            QByteArray body =
+                "{\"message\": \"You are being rate limited.\", \"retry_after\": " +
+                QByteArray::number(retry_after) + ", \"global\": false}";
+            socket->write(
+                "HTTP/1.1 429 Too Many Requests\r\n"
+                "Content-Type: application/json\r\n"
+                "X-RateLimit-Limit: " + QByteArray::number((qulonglong)bucket_size) + "\r\n"
+                "X-RateLimit-Remaining: 0\r\n"
+                "X-RateLimit-Reset-After: " + QByteArray::number(retry_after) + "\r\n"
+                "Retry-After: 1\r\n"
+                "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                "\r\n" + body
+            );
+            m_remaining = bucket_size;
+            return;
+        }
+        if (m_remaining == 0){
+            m_remaining = bucket_size;
+        }
+        m_remaining--;
+        socket->write(
+            "HTTP/1.1 204 No Content\r\n"
+            "X-RateLimit-Limit: " + QByteArray::number((qulonglong)bucket_size) + "\r\n"
+            "X-RateLimit-Remaining: " + QByteArray::number((qulonglong)m_remaining) + "\r\n"
+            "X-RateLimit-Reset-After: " + QByteArray::number(reset_after) + "\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"
+        );
+    }
+
+private:
+    QTcpServer m_server;
+    std::map<QTcpSocket*, QByteArray> m_buffers;
+    size_t m_remaining = 5;
+};
+
+
+//  The engine runs on its own thread. The stand-in runs on this one.
+bool wait_for_engine(WebhookDeliveryEngine& engine, std::chrono::milliseconds timeout){
+    WallClock deadline = current_time() + timeout;
+    while (current_time() < deadline){
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        if (engine.wait_until_idle(std::chrono::milliseconds(0))){
+            return true;
+        }
+        QThread::msleep(1);
+    }
+    return false;
+}
+
+//  Pull "payload_json" out of a multipart body.
+QByteArray extract_payload(const QByteArray& headers, const QByteArray& body){
+    if (!headers.toLower().contains("multipart/form-data")){
+        return body;
+    }
+    int name = body.indexOf("name=\"payload_json\"");
+    if (name < 0){
+        return QByteArray();
+    }
+    int start = body.indexOf("\r\n\r\n", name);
+    int end = body.indexOf("\r\n--", start);
+    if (start < 0 || end < 0){
+        return QByteArray();
+    }
+    return body.mid(start + 4, end - start - 4);
+}
+
+
+}
+
+
+
+int test_DiscordWebhook_Delivery(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    size_t message_count = 30;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(message_count, "MESSAGES", 1, 1000);
+        }
+    }
+
+    StandInWebhookServer server;
+    if (!server.listening()){
+        cerr << "Unable to start the stand-in server." << endl;
+        return 1;
+    }
+
+    WebhookDeliveryEngine engine(global_logger_tagged(), 100);
+    const QUrl url = server.url("1234/test-token");
+
+    //  A burst of single-embed messages. One of them carries an attachment.
+    //  The last one carries a screenshot that failed to encode.
+    const QByteArray attachment(100 * 1024, 'x');
+    for (size_t c = 0; c < message_count; c++){
+        WebhookMessage message;
+        message.url = url;
+
+        JsonArray embeds;
+        JsonObject embed;
+        embed["title"] = std::to_string(c);
+        if (c == message_count - 1){
+            JsonObject image;
+            image["url"] = "attachment://failed.jpg";
+            embed["image"] = std::move(image);
+        }
+        embeds.push_back(std::move(embed));
+        message.payload["embeds"] = std::move(embeds);
+
+        if (c == message_count / 2){
+            message.attachments.emplace_back(WebhookAttachment{"screenshot.png", attachment, nullptr});
+        }
+        if (c == message_count - 1){
+            message.attachments.emplace_back(WebhookAttachment{"failed.jpg", QByteArray(), nullptr});
+        }
+        engine.enqueue(std::move(message));
+    }
+
+    if (!wait_for_engine(engine, std::chrono::seconds(30))){
+        cerr << "Timed out waiting for delivery. Pending: " << engine.pending() << endl;
+        return 1;
+    }
+
+    WebhookDeliveryStats stats = engine.stats();
+    cout << "Messages: " << stats.messages_sent << " sent, " << stats.messages_dropped << " dropped" << endl;
+    cout << "Requests: " << stats.requests << " (" << stats.rate_limited << " rate limited)" << endl;
+    cout << "Connections: " << server.connections << endl;
+
+    bool ok = true;
+    if (server.malformed){
+        cerr << "Stand-in server received a request it doesn't understand." << endl;
+        ok = false;
+    }
+
+    //  Every embed must arrive exactly once and in order. The 429'ed request
+    //  is sent again so it's skipped here.
+    std::vector<std::string> titles;
+    bool attachment_found = false;
+    for (size_t c = 0; c < server.requests.size(); c++){
+        const StandInWebhookServer::Request& request = server.requests[c];
+        if (c == server.rate_limit_request){
+            continue;
+        }
+        if (request.body.contains(attachment)){
+            attachment_found = true;
+        }
+        if (request.body.contains("failed.jpg")){
+            cerr << "Request " << c << " references an attachment that failed to encode." << endl;
+            ok = false;
+        }
+        QByteArray payload = extract_payload(request.headers, request.body);
+        JsonValue json = parse_json(payload.toStdString());
+        const JsonObject* obj = json.to_object();
+        const JsonArray* embeds = obj == nullptr ? nullptr : obj->get_array("embeds");
+        if (embeds == nullptr){
+            cerr << "Request " << c << " has no embeds." << endl;
+            ok = false;
+            continue;
+        }
+        for (const JsonValue& embed : *embeds){
+            const JsonObject* embed_obj = embed.to_object();
+            const std::string* title = embed_obj == nullptr ? nullptr : embed_obj->get_string("title");
+            titles.emplace_back(title == nullptr ? "" : *title);
+        }
+    }
+    for (size_t c = 0; c < std::max(titles.size(), message_count); c++){
+        if (c >= titles.size() || c >= message_count || titles[c] != std::to_string(c)){
+            cerr << "Messages are missing, duplicated or out of order. (received " << titles.size() << ")" << endl;
+            ok = false;
+            break;
+        }
+    }
+
+    if (!attachment_found){
+        cerr << "Attachment did not arrive intact." << endl;
+        ok = false;
+    }
+    if (message_count > 1 && server.requests.size() >= message_count){
+        cerr << "Burst was not coalesced." << endl;
+        ok = false;
+    }
+    if (server.requests.size() > server.rate_limit_request + 1){
+        auto gap = server.requests[server.rate_limit_request + 1].time - server.requests[server.rate_limit_request].time;
+        if (gap < std::chrono::milliseconds((int64_t)(server.retry_after * 1000))){
+            cerr << "Retried before \"retry_after\" elapsed." << endl;
+            ok = false;
+        }
+    }
+    if (server.requests.size() > 1 && server.connections >= server.requests.size()){
+        cerr << "Connections were not reused." << endl;
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
+
+
+
+}
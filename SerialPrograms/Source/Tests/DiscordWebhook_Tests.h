@@ -0,0 +1,30 @@
+/*  Discord Webhook Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_DiscordWebhook_Tests_H
+#define PokemonAutomation_Tests_DiscordWebhook_Tests_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Run the webhook delivery engine against a local stand-in for Discord.
+//  The stand-in listens on 127.0.0.1, sends Discord's rate-limit headers and
+//  answers one request with a 429. Checks that:
+//    - Every message arrives exactly once and in order.
+//    - Bursts are coalesced into fewer requests.
+//    - The 429 "retry_after" is respected.
+//    - Connections are kept alive and reused.
+//    - In-memory attachments arrive intact.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "MESSAGES": # of messages in the burst. (default: 30)
+int test_DiscordWebhook_Delivery(const std::string& config_path);
+
+
+}
+#endif
@@ -0,0 +1,384 @@
+/*  Inference Pivot Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <iostream>
+#include <iomanip>
+#include <QFileInfo>
+#include <QDir>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "CommonFramework/AudioPipeline/IO/AudioSpectrumReplay.h"
+#include "CommonFramework/VideoPipeline/Backends/CameraFileReplay.h"
+#include "CommonFramework/Inference/BlackScreenDetector.h"
+#include "CommonFramework/Inference/FrozenImageDetector.h"
+#include "CommonFramework/InferenceInfra/InferenceExecutor.h"
+#include "CommonFramework/InferenceInfra/VisualInferencePivot.h"
+#include "CommonFramework/InferenceInfra/AudioInferencePivot.h"
+#include "InferencePivot_Benchmarks.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+//  If no callback makes progress for this long, something is stuck.
+const std::chrono::seconds STALL_TIMEOUT(10);
+
+
+//  Counts how many callbacks have finished the current tick.
+class TickBarrier{
+public:
+    void finished_tick(){
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_finished++;
+        }
+        m_cv.notify_all();
+    }
+
+    //  Wait until "callbacks" more calls to finished_tick() have been made
+    //  since the last wait. Returns false on a stall.
+    bool wait(size_t callbacks, CancellableScope& scope){
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_target += callbacks;
+        while (m_finished < m_target){
+            if (scope.cancelled()){
+                return false;
+            }
+            size_t before = m_finished;
+            m_cv.wait_for(lg, STALL_TIMEOUT);
+            if (m_finished == before && m_finished < m_target){
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    size_t m_finished = 0;
+    size_t m_target = 0;
+};
+
+
+//  Forwards each new frame to a detector exactly once.
+class VisualTickCallback : public VisualInferenceCallback{
+public:
+    VisualTickCallback(TickBarrier& barrier, std::unique_ptr<VisualInferenceCallback> detector)
+        : VisualInferenceCallback(detector->label())
+        , m_barrier(barrier)
+        , m_detector(std::move(detector))
+    {}
+
+    size_t triggers() const{ return m_triggers; }
+
+    virtual void make_overlays(VideoOverlaySet& items) const override{
+        m_detector->make_overlays(items);
+    }
+    virtual bool process_frame(const VideoSnapshot& frame) override{
+        //  The pivot can hand out the same frame more than once.
+        if (!frame || frame.timestamp == m_last_timestamp){
+            return false;
+        }
+        m_last_timestamp = frame.timestamp;
+        if (m_detector->process_frame(frame)){
+            m_triggers++;
+        }
+        m_barrier.finished_tick();
+        return false;
+    }
+
+private:
+    TickBarrier& m_barrier;
+    std::unique_ptr<VisualInferenceCallback> m_detector;
+    WallClock m_last_timestamp = WallClock::min();
+    size_t m_triggers = 0;
+};
+
+
+//  A stand-in for an audio detector. Adds up the energy of each new
+//  spectrum exactly once.
+class AudioTickCallback : public AudioInferenceCallback{
+public:
+    AudioTickCallback(TickBarrier& barrier)
+        : AudioInferenceCallback("SpectrumEnergy")
+        , m_barrier(barrier)
+    {}
+
+    double energy() const{ return m_energy; }
+
+    virtual bool process_spectrums(
+        const std::vector<AudioSpectrum>& new_spectrums,
+        AudioFeed& audio_feed
+    ) override{
+        if (new_spectrums.empty() || new_spectrums[0].stamp + 1 == m_next_stamp){
+            return false;
+        }
+        //  Newest first.
+        for (auto iter = new_spectrums.rbegin(); iter != new_spectrums.rend(); ++iter){
+            if (iter->stamp < m_next_stamp){
+                continue;
+            }
+            for (float magnitude : *iter->magnitudes){
+                m_energy += magnitude * magnitude;
+            }
+            m_next_stamp = iter->stamp + 1;
+            m_barrier.finished_tick();
+        }
+        return false;
+    }
+
+private:
+    TickBarrier& m_barrier;
+    uint64_t m_next_stamp = 0;
+    double m_energy = 0;
+};
+
+
+struct PhaseResult{
+    size_t ticks = 0;
+    double seconds = 0;
+    JsonObject callbacks;
+};
+
+JsonObject callback_stats(const StatAccumulatorI32& stats){
+    JsonObject obj;
+    obj["calls"] = stats.count();
+    obj["mean_us"] = stats.mean();
+    obj["max_us"] = stats.count() == 0 ? 0 : stats.max();
+    return obj;
+}
+void print_phase(const std::string& name, const char* units, const PhaseResult& result){
+    cout << name << ": " << result.ticks << " " << units << " in "
+         << std::fixed << std::setprecision(3) << result.seconds << " s, "
+         << std::setprecision(1) << result.ticks / result.seconds << " " << units << "/s" << endl;
+    cout.unsetf(std::ios::floatfield);
+}
+
+
+//  Step the replay once per tick until it runs out or "max_ticks".
+//  "step" returns false when there is nothing left to replay.
+bool run_ticks(
+    CancellableScope& scope, TickBarrier& barrier,
+    size_t callbacks, size_t max_ticks,
+    const std::function<bool()>& step,
+    PhaseResult& result
+){
+    WallClock start = current_time();
+    while (true){
+        if (!barrier.wait(callbacks, scope)){
+            return false;
+        }
+        result.ticks++;
+        if (result.ticks == max_ticks || !step()){
+            break;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(current_time() - start).count();
+    return true;
+}
+
+
+bool run_video(
+    Logger& logger, const std::string& path,
+    AsyncDispatcher& dispatcher, InferenceExecutor& executor,
+    std::chrono::milliseconds period, size_t max_ticks,
+    PhaseResult& result
+){
+    CameraFileReplay::CameraSession camera(logger, ReplayPacing::AS_FAST_AS_POSSIBLE);
+    camera.set_source(CameraInfo(path));
+    if (camera.current_resolution() == Resolution()){
+        cerr << "Unable to open video: " << path << endl;
+        return false;
+    }
+
+    TickBarrier barrier;
+    std::vector<std::unique_ptr<VisualTickCallback>> callbacks;
+    callbacks.emplace_back(new VisualTickCallback(barrier, std::make_unique<BlackScreenWatcher>()));
+    callbacks.emplace_back(new VisualTickCallback(barrier, std::make_unique<FrozenImageDetector>(
+        std::chrono::seconds(5), 10
+    )));
+    callbacks.emplace_back(new VisualTickCallback(barrier, std::make_unique<FrozenImageDetector>(
+        std::chrono::seconds(5), 10, FrozenImageDetector::Mode::SIGNATURE
+    )));
+
+    CancellableHolder<CancellableScope> scope;
+    InferenceExecutor::Client client(executor);
+    VisualInferencePivot pivot(scope, camera, dispatcher, client);
+    for (auto& callback : callbacks){
+        pivot.add_callback(scope, nullptr, *callback, period);
+    }
+
+    bool ok = run_ticks(
+        scope, barrier, callbacks.size(), max_ticks,
+        [&]{
+            if (camera.finished()){
+                return false;
+            }
+            camera.step();
+            return true;
+        },
+        result
+    );
+
+    for (auto& callback : callbacks){
+        StatAccumulatorI32 stats = pivot.remove_callback(*callback);
+        JsonObject obj = callback_stats(stats);
+        obj["triggers"] = callback->triggers();
+        result.callbacks[callback->label()] = std::move(obj);
+    }
+    if (!ok){
+        cerr << "Video replay stalled or was cancelled." << endl;
+        scope.throw_if_cancelled_with_exception();
+    }
+    return ok;
+}
+
+
+bool run_audio(
+    const std::string& path,
+    AsyncDispatcher& dispatcher, InferenceExecutor& executor,
+    std::chrono::milliseconds period, size_t max_ticks,
+    PhaseResult& result
+){
+    AudioSpectrumReplay audio(path, ReplayPacing::AS_FAST_AS_POSSIBLE);
+
+    TickBarrier barrier;
+    AudioTickCallback callback(barrier);
+
+    CancellableHolder<CancellableScope> scope;
+    InferenceExecutor::Client client(executor);
+    AudioInferencePivot pivot(scope, audio, dispatcher, client);
+    pivot.add_callback(scope, nullptr, callback, period);
+
+    bool ok = run_ticks(
+        scope, barrier, 1, max_ticks,
+        [&]{
+            if (audio.finished()){
+                return false;
+            }
+            audio.step();
+            return true;
+        },
+        result
+    );
+
+    StatAccumulatorI32 stats = pivot.remove_callback(callback);
+    result.callbacks[callback.label()] = callback_stats(stats);
+    if (!ok){
+        cerr << "Audio replay stalled or was cancelled." << endl;
+        scope.throw_if_cancelled_with_exception();
+    }
+    return ok;
+}
+
+
+}
+
+
+
+int test_inferencePivot_Benchmark(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+    const QDir config_dir = file_info.dir();
+
+    std::string video_path;
+    std::string audio_path;
+    int64_t period_ms = 0;
+    int64_t workers = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    int64_t max_ticks = 0;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_string(video_path, "VIDEO");
+            obj->read_string(audio_path, "AUDIO");
+            obj->read_integer(period_ms, "PERIOD_MS", 0, 10000);
+            obj->read_integer(workers, "WORKERS", 1, 1024);
+            obj->read_integer(max_ticks, "MAX_TICKS", 0, 1000000000);
+        }
+    }
+    if (video_path.empty() && audio_path.empty()){
+        cerr << "Config must set \"VIDEO\" and/or \"AUDIO\"." << endl;
+        return 1;
+    }
+    const std::chrono::milliseconds period(period_ms);
+
+    AsyncDispatcher dispatcher([]{}, 0);
+    InferenceExecutor executor(workers);
+
+    JsonObject results;
+    if (!video_path.empty()){
+        video_path = config_dir.absoluteFilePath(QString::fromStdString(video_path)).toStdString();
+        PhaseResult result;
+        if (!run_video(global_logger_command_line(), video_path, dispatcher, executor, period, max_ticks, result)){
+            return 1;
+        }
+        print_phase("Video", "frames", result);
+        JsonObject obj;
+        obj["path"] = video_path;
+        obj["frames"] = result.ticks;
+        obj["seconds"] = result.seconds;
+        obj["frames_per_sec"] = result.ticks / result.seconds;
+        obj["callbacks"] = std::move(result.callbacks);
+        results["video"] = std::move(obj);
+    }
+    if (!audio_path.empty()){
+        audio_path = config_dir.absoluteFilePath(QString::fromStdString(audio_path)).toStdString();
+        PhaseResult result;
+        try{
+            if (!run_audio(audio_path, dispatcher, executor, period, max_ticks, result)){
+                return 1;
+            }
+        }catch (FileException& e){
+            cerr << e.message() << endl;
+            return 1;
+        }
+        print_phase("Audio", "spectrums", result);
+        JsonObject obj;
+        obj["path"] = audio_path;
+        obj["spectrums"] = result.ticks;
+        obj["seconds"] = result.seconds;
+        obj["spectrums_per_sec"] = result.ticks / result.seconds;
+        obj["callbacks"] = std::move(result.callbacks);
+        results["audio"] = std::move(obj);
+    }
+
+    JsonObject report;
+    report["period_ms"] = period_ms;
+    report["workers"] = workers;
+    report["results"] = std::move(results);
+
+    const std::string output_path = config_dir.filePath(
+        "_" + file_info.completeBaseName() + "-Results.json"
+    ).toStdString();
+    JsonValue(std::move(report)).dump(output_path);
+    cout << "Wrote benchmark results to " << output_path << endl;
+
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,37 @@
+/*  Inference Pivot Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_InferencePivot_Benchmarks_H
+#define PokemonAutomation_Tests_InferencePivot_Benchmarks_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Replay recorded footage and spectrums through VisualInferencePivot and
+//  AudioInferencePivot as fast as they can take them. Every callback sees
+//  every recorded frame/spectrum exactly once. The replay moves on to the
+//  next one only after all of them have.
+//
+//  Reports the frames (or spectrums) per second through each pivot and the
+//  latency of each callback.
+//
+//  The test file is a JSON config. Relative paths are relative to it.
+//    - "VIDEO": Image sequence folder or ".rgb32" dump. (see ReplayFrameSource.h)
+//    - "AUDIO": Spectrum ".txt" dump or an audio file. (see AudioSpectrumReplay.h)
+//    - "PERIOD_MS": Callback period. (default: 0)
+//    - "WORKERS": Inference workers. (default: # of CPU threads)
+//    - "MAX_TICKS": Stop after this many frames/spectrums. (default: 0 = all)
+//  At least one of "VIDEO" and "AUDIO" must be set.
+//
+//  The results are printed and written next to the config as
+//  "_<config name>-Results.json".
+int test_inferencePivot_Benchmark(const std::string& config_path);
+
+
+}
+#endif
@@ -0,0 +1,219 @@
+/*  JSON Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
+#include "Common/Cpp/Json/JsonParser.h"
+#include "Common/Cpp/Json/JsonWriter.h"
+#include "CommonFramework/Globals.h"
+#include "Json_Benchmarks.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+struct CorpusFile{
+    std::string path;
+    std::string text;
+    JsonValue value;
+};
+
+struct BenchmarkResult{
+    size_t iterations = 0;
+    double ms_per_pass = 0;
+    double mb_per_s = 0;
+};
+
+
+//  Run "pass" over the whole corpus until "min_time" has elapsed.
+BenchmarkResult time_pass(
+    const std::function<void()>& pass,
+    size_t bytes,
+    std::chrono::milliseconds min_time
+){
+    pass();     //  Warm up.
+
+    BenchmarkResult result;
+    WallClock start = current_time();
+    std::chrono::nanoseconds elapsed(0);
+    while (elapsed < min_time){
+        pass();
+        result.iterations++;
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time() - start);
+    }
+
+    double seconds = elapsed.count() / 1e9;
+    result.ms_per_pass = seconds * 1000 / result.iterations;
+    result.mb_per_s = (double)bytes * result.iterations / seconds / 1e6;
+    return result;
+}
+
+JsonValue parse_nlohmann(const std::string& text){
+    return from_nlohmann(nlohmann::json::parse(text, nullptr, false));
+}
+
+
+}
+
+
+
+int test_json_Benchmark(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t min_time_ms = 200;
+    std::string resource_path = RESOURCE_PATH();
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(min_time_ms, "MIN_TIME_MS", 1, 60000);
+            obj->read_string(resource_path, "RESOURCE_PATH");
+        }
+    }
+    const std::chrono::milliseconds min_time(min_time_ms);
+
+    //  Load the corpus.
+    std::vector<CorpusFile> corpus;
+    size_t total_bytes = 0;
+    QDirIterator file_iter(
+        QString::fromStdString(resource_path),
+        {"*.json"},
+        QDir::Filter::Files,
+        QDirIterator::IteratorFlag::Subdirectories
+    );
+    while (file_iter.hasNext()){
+        CorpusFile file;
+        file.path = file_iter.next().toStdString();
+        file.text = file_to_string(file.path);
+        total_bytes += file.text.size();
+        corpus.emplace_back(std::move(file));
+    }
+    if (corpus.empty()){
+        cerr << "No JSON files found in: " << resource_path << endl;
+        return 1;
+    }
+    cout << "Corpus: " << corpus.size() << " files, " << total_bytes << " bytes" << endl;
+
+    //  Both parsers must agree on every file and the writer must round-trip
+    //  before the times mean anything.
+    size_t mismatches = 0;
+    size_t invalid = 0;
+    for (CorpusFile& file : corpus){
+        JsonValue expected = parse_nlohmann(file.text);
+        bool ok = parse_json_direct(file.value, file.text.data(), file.text.size());
+        if (!ok){
+            invalid++;
+        }
+
+        std::string expected_text;
+        write_json(expected_text, expected, 4);
+        std::string actual_text;
+        write_json(actual_text, file.value, 4);
+
+        JsonValue reparsed;
+        parse_json_direct(reparsed, actual_text.data(), actual_text.size());
+        std::string reparsed_text;
+        write_json(reparsed_text, reparsed, 4);
+
+        if (expected_text != actual_text || actual_text != reparsed_text){
+            if (mismatches < 10){
+                cerr << "Mismatch: " << file.path << endl;
+            }
+            mismatches++;
+        }
+    }
+    if (invalid != 0){
+        cout << "Files that are not valid JSON: " << invalid << endl;
+    }
+
+    struct Path{
+        std::string name;
+        std::function<void()> pass;
+    };
+    const std::vector<Path> paths{
+        {"parse nlohmann", [&corpus]{
+            for (const CorpusFile& file : corpus){
+                parse_nlohmann(file.text);
+            }
+        }},
+        {"parse direct", [&corpus]{
+            for (const CorpusFile& file : corpus){
+                JsonValue value;
+                parse_json_direct(value, file.text.data(), file.text.size());
+            }
+        }},
+        {"dump nlohmann", [&corpus]{
+            for (const CorpusFile& file : corpus){
+                to_nlohmann(file.value).dump(4);
+            }
+        }},
+        {"dump direct", [&corpus]{
+            std::string out;
+            for (const CorpusFile& file : corpus){
+                out.clear();
+                write_json(out, file.value, 4);
+            }
+        }},
+    };
+
+    JsonObject results;
+    for (const Path& path : paths){
+        BenchmarkResult result = time_pass(path.pass, total_bytes, min_time);
+        cout << "    " << std::left << std::setw(20) << path.name << std::right
+             << std::setw(10) << std::fixed << std::setprecision(3) << result.ms_per_pass << " ms/pass, "
+             << std::setw(8) << std::setprecision(2) << result.mb_per_s << " MB/s" << endl;
+        cout.unsetf(std::ios::floatfield);
+
+        JsonObject obj;
+        obj["iterations"] = result.iterations;
+        obj["ms_per_pass"] = result.ms_per_pass;
+        obj["mb_per_s"] = result.mb_per_s;
+        results[path.name] = std::move(obj);
+    }
+
+    JsonObject report;
+    report["resource_path"] = resource_path;
+    report["files"] = corpus.size();
+    report["bytes"] = total_bytes;
+    report["invalid_files"] = invalid;
+    report["mismatches"] = mismatches;
+    report["min_time_ms"] = min_time_ms;
+    report["results"] = std::move(results);
+
+    const std::string output_path = file_info.dir().filePath(
+        "_" + file_info.completeBaseName() + "-Results.json"
+    ).toStdString();
+    JsonValue(std::move(report)).dump(output_path);
+    cout << "Wrote benchmark results to " << output_path << endl;
+
+    if (mismatches != 0){
+        cerr << "Direct parser/writer disagrees with nlohmann on " << mismatches << " file(s)." << endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+}
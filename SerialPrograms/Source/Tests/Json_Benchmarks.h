@@ -0,0 +1,29 @@
+/*  JSON Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_Json_Benchmarks_H
+#define PokemonAutomation_Tests_Json_Benchmarks_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Time loading and saving every JSON file in the resource folder. Compares
+//  the direct parser/writer with the old path through nlohmann::json, and
+//  fails if the two disagree on any file.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "MIN_TIME_MS": Minimum time to spend on each path. (default: 200)
+//    - "RESOURCE_PATH": Folder to scan. (default: the program's resource folder)
+//
+//  The results are printed and written next to the config as
+//  "_<config name>-Results.json".
+int test_json_Benchmark(const std::string& config_path);
+
+
+}
+#endif
@@ -0,0 +1,548 @@
+/*  Kernels Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <random>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <QFileInfo>
+#include <QDir>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Kernels/AbsFFT/Kernels_AbsFFT.h"
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixView.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
+#include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImageBlockMean.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
+#include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
+#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
+#include "Kernels/Waterfill/Kernels_Waterfill.h"
+#include "Kernels_Benchmarks.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace Kernels;
+
+
+namespace{
+
+
+struct KernelBenchmark{
+    std::string family;
+    std::string name;
+    size_t elements;    //  Pixels, samples or matrix entries processed per run.
+    size_t bytes;       //  Bytes read + written per run.
+
+    //  If set, runs before every timed run and is not included in the time.
+    //  Use this for kernels that destroy their input.
+    std::function<void()> prepare;
+    std::function<void()> run;
+};
+
+struct BenchmarkResult{
+    size_t iterations = 0;
+    double ns_per_element = 0;
+    double gb_per_s = 0;
+};
+
+
+BenchmarkResult time_benchmark(const KernelBenchmark& benchmark, std::chrono::milliseconds min_time){
+    //  Warm up caches and any lazily built tables.
+    if (benchmark.prepare){
+        benchmark.prepare();
+    }
+    benchmark.run();
+
+    size_t iterations = 0;
+    std::chrono::nanoseconds elapsed(0);
+    size_t batch = 1;
+    while (elapsed < min_time){
+        if (benchmark.prepare){
+            for (size_t c = 0; c < batch; c++){
+                benchmark.prepare();
+                WallClock start = current_time();
+                benchmark.run();
+                elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(current_time() - start);
+            }
+        }else{
+            WallClock start = current_time();
+            for (size_t c = 0; c < batch; c++){
+                benchmark.run();
+            }
+            elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(current_time() - start);
+        }
+        iterations += batch;
+        batch *= 2;
+    }
+
+    BenchmarkResult ret;
+    ret.iterations = iterations;
+    double ns = (double)elapsed.count();
+    ret.ns_per_element = ns / ((double)iterations * benchmark.elements);
+    ret.gb_per_s = (double)iterations * benchmark.bytes / ns;
+    return ret;
+}
+
+
+//  Synthetic input that is the same for every level so the numbers are comparable.
+struct FrameData{
+    size_t width;
+    size_t height;
+    size_t bytes_per_row;
+    AlignedVector<uint32_t> image;
+    AlignedVector<uint32_t> reference;
+    AlignedVector<uint32_t> out;
+
+    FrameData(size_t p_width, size_t p_height)
+        : width(p_width)
+        , height(p_height)
+        , bytes_per_row(p_width * sizeof(uint32_t))
+        , image(p_width * p_height)
+        , reference(p_width * p_height)
+        , out(p_width * p_height)
+    {
+        std::mt19937 rng((uint32_t)(width * height));
+        for (size_t c = 0; c < width * height; c++){
+            uint32_t pixel = (uint32_t)rng();
+            image[c] = pixel;
+            reference[c] = pixel ^ (rng() & 0x000f0f0f);
+        }
+    }
+    size_t pixels() const{ return width * height; }
+};
+
+struct SignalData{
+    size_t length;
+    AlignedVector<float> input;
+    AlignedVector<float> work;
+    AlignedVector<float> out;
+
+    SignalData(size_t p_length)
+        : length(p_length)
+        , input(p_length)
+        , work(p_length)
+        , out(p_length)
+    {
+        std::mt19937 rng((uint32_t)length);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (size_t c = 0; c < length; c++){
+            input[c] = dist(rng);
+        }
+    }
+};
+
+struct MatrixData{
+    size_t width;
+    size_t height;
+    AlignedVector<float> a;
+    AlignedVector<float> t;
+    AlignedVector<float> w;
+    std::vector<const float*> rows_a;
+    std::vector<const float*> rows_t;
+    std::vector<const float*> rows_w;
+
+    MatrixData(size_t p_width, size_t p_height)
+        : width(p_width)
+        , height(p_height)
+        , a(p_width * p_height)
+        , t(p_width * p_height)
+        , w(p_width * p_height)
+    {
+        std::mt19937 rng((uint32_t)(width * height));
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        for (size_t c = 0; c < width * height; c++){
+            a[c] = dist(rng);
+            t[c] = dist(rng);
+            w[c] = dist(rng);
+        }
+        for (size_t r = 0; r < height; r++){
+            rows_a.emplace_back(a.data() + r * width);
+            rows_t.emplace_back(t.data() + r * width);
+            rows_w.emplace_back(w.data() + r * width);
+        }
+    }
+};
+
+
+struct BenchmarkData{
+    std::vector<std::unique_ptr<FrameData>> frames;
+    std::vector<std::unique_ptr<SignalData>> signals;
+    std::unique_ptr<SignalData> spike_kernel;
+    std::unique_ptr<MatrixData> matrix;
+
+    //  Binary matrices depend on the processor level. Rebuilt for each level.
+    std::vector<std::unique_ptr<PackedBinaryMatrix_IB>> binary;
+    std::unique_ptr<PackedBinaryMatrix_IB> waterfill_work;
+
+    //  Results of read-only benchmarks go here so they aren't optimized out.
+    size_t sink = 0;
+};
+
+
+std::vector<KernelBenchmark> make_benchmarks(BenchmarkData& data){
+    std::vector<KernelBenchmark> ret;
+
+    for (size_t f = 0; f < data.frames.size(); f++){
+        FrameData& frame = *data.frames[f];
+        const std::string size = std::to_string(frame.width) + "x" + std::to_string(frame.height);
+        const size_t pixels = frame.pixels();
+
+        ret.emplace_back(KernelBenchmark{
+            "ImageFilters", "filter_rgb32_range " + size, pixels, pixels * 8, nullptr,
+            [&frame]{
+                filter_rgb32_range(
+                    frame.image.data(), frame.bytes_per_row, frame.width, frame.height,
+                    frame.out.data(), frame.bytes_per_row,
+                    0xff404040, 0xffc0c0c0, 0xff000000, true
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ImageFilters", "filter_rgb32_euclidean " + size, pixels, pixels * 8, nullptr,
+            [&frame]{
+                filter_rgb32_euclidean(
+                    frame.image.data(), frame.bytes_per_row, frame.width, frame.height,
+                    frame.out.data(), frame.bytes_per_row,
+                    0xff808080, 100, 0xff000000, false
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ImageFilters", "to_blackwhite_rgb32_range " + size, pixels, pixels * 8, nullptr,
+            [&frame]{
+                to_blackwhite_rgb32_range(
+                    frame.image.data(), frame.bytes_per_row, frame.width, frame.height,
+                    frame.out.data(), frame.bytes_per_row,
+                    0xff404040, 0xffc0c0c0, true
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ImageScaleBrightness", "scale_brightness " + size, pixels, pixels * 8,
+            [&frame, pixels]{ memcpy(frame.out.data(), frame.image.data(), pixels * sizeof(uint32_t)); },
+            [&frame]{
+                scale_brightness(
+                    frame.width, frame.height,
+                    frame.out.data(), frame.bytes_per_row,
+                    0.9f, 1.1f, 0.8f
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ImageStats", "pixel_sum_sqr " + size, pixels, pixels * 8, nullptr,
+            [&frame]{
+                PixelSums sums;
+                pixel_sum_sqr(
+                    sums, frame.width, frame.height,
+                    frame.image.data(), frame.bytes_per_row,
+                    frame.reference.data(), frame.bytes_per_row
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ImageStats", "sum_sqr_deviation " + size, pixels, pixels * 8, nullptr,
+            [&frame]{
+                uint64_t count = 0;
+                uint64_t sumsqrs = 0;
+                sum_sqr_deviation(
+                    count, sumsqrs, frame.width, frame.height,
+                    frame.reference.data(), frame.bytes_per_row,
+                    frame.image.data(), frame.bytes_per_row
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ImageStats", "image_block_mean 64x36 " + size, pixels, pixels * 4, nullptr,
+            [&frame]{
+                image_block_mean(
+                    frame.out.data(), 64, 36,
+                    frame.image.data(), frame.bytes_per_row,
+                    frame.width, frame.height
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "BinaryImageFilters", "compress_rgb32_to_binary_range " + size, pixels, pixels * 4 + pixels / 8, nullptr,
+            [&frame, &data, f]{
+                compress_rgb32_to_binary_range(
+                    frame.image.data(), frame.bytes_per_row,
+                    *data.binary[f], 0xff000000, 0xff7f7f7f
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "BinaryImageFilters", "filter_by_mask " + size, pixels, pixels * 8 + pixels / 8,
+            [&frame, pixels]{ memcpy(frame.out.data(), frame.image.data(), pixels * sizeof(uint32_t)); },
+            [&frame, &data, f]{
+                filter_by_mask(
+                    *data.binary[f],
+                    frame.out.data(), frame.bytes_per_row,
+                    0xffffffff, true
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "BinaryMatrix", "virtual get() " + size, pixels, pixels / 8, nullptr,
+            [&data, f]{
+                const PackedBinaryMatrix_IB& matrix = *data.binary[f];
+                size_t width = matrix.width();
+                size_t height = matrix.height();
+                size_t sum = 0;
+                for (size_t r = 0; r < height; r++){
+                    for (size_t c = 0; c < width; c++){
+                        if (matrix.get(c, r)){
+                            sum += c + r;
+                        }
+                    }
+                }
+                data.sink += sum;
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "BinaryMatrix", "for_each_set_bit " + size, pixels, pixels / 8, nullptr,
+            [&data, f]{
+                const PackedBinaryMatrix_IB& matrix = *data.binary[f];
+                size_t sum = 0;
+                visit_matrix(matrix, [&](auto view){
+                    for_each_set_bit(view, [&](size_t c, size_t r){
+                        sum += c + r;
+                    });
+                });
+                data.sink += sum;
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "BinaryMatrix", "count_set_bits " + size, pixels, pixels / 8, nullptr,
+            [&data, f]{
+                const PackedBinaryMatrix_IB& matrix = *data.binary[f];
+                data.sink += visit_matrix(matrix, [](auto view){
+                    return count_set_bits(view);
+                });
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "Waterfill", "find_objects_inplace " + size, pixels, pixels / 8,
+            [&data, f]{ data.waterfill_work = data.binary[f]->clone(); },
+            [&data]{
+                Waterfill::find_objects_inplace(*data.waterfill_work, 10);
+            }
+        });
+    }
+
+    for (std::unique_ptr<SignalData>& signal_ptr : data.signals){
+        SignalData& signal = *signal_ptr;
+        const size_t length = signal.length;
+        int k = 0;
+        while (((size_t)1 << k) < length){
+            k++;
+        }
+        //  fft_abs() destroys its input. The copy is cheap next to the transform
+        //  and keeps the timing free of per-run clock overhead.
+        ret.emplace_back(KernelBenchmark{
+            "AbsFFT", "fft_abs " + std::to_string(length), length, length * 4 + length / 2 * 4, nullptr,
+            [&signal, k, length]{
+                memcpy(signal.work.data(), signal.input.data(), length * sizeof(float));
+                AbsFFT::fft_abs(k, signal.out.data(), signal.work.data());
+            }
+        });
+    }
+
+    {
+        SignalData& signal = *data.signals.back();
+        SignalData& kernel = *data.spike_kernel;
+        const size_t outputs = signal.length - kernel.length + 1;
+        ret.emplace_back(KernelBenchmark{
+            "SpikeConvolution",
+            "compute_spike_kernel " + std::to_string(signal.length) + " * " + std::to_string(kernel.length),
+            outputs, signal.length * 4 + outputs * 4, nullptr,
+            [&signal, &kernel]{
+                SpikeConvolution::compute_spike_kernel(
+                    signal.out.data(), signal.input.data(), signal.length,
+                    kernel.input.data(), kernel.length
+                );
+            }
+        });
+    }
+
+    {
+        MatrixData& matrix = *data.matrix;
+        const std::string size = std::to_string(matrix.width) + "x" + std::to_string(matrix.height);
+        const size_t entries = matrix.width * matrix.height;
+        ret.emplace_back(KernelBenchmark{
+            "ScaleInvariantMatrixMatch", "compute_scale " + size, entries, entries * 8, nullptr,
+            [&matrix]{
+                ScaleInvariantMatrixMatch::compute_scale(
+                    matrix.width, matrix.height,
+                    matrix.rows_a.data(), matrix.rows_t.data()
+                );
+            }
+        });
+        ret.emplace_back(KernelBenchmark{
+            "ScaleInvariantMatrixMatch", "compute_error weighted " + size, entries, entries * 12, nullptr,
+            [&matrix]{
+                ScaleInvariantMatrixMatch::compute_error(
+                    matrix.width, matrix.height, 0.5f,
+                    matrix.rows_a.data(), matrix.rows_t.data(), matrix.rows_w.data()
+                );
+            }
+        });
+    }
+
+    return ret;
+}
+
+
+//  Restore the processor level when leaving the benchmark, even on exception.
+//  CPU_CAPABILITY_CURRENT is process-wide. This is only safe because the
+//  command line runner never runs benchmarks concurrently with other tests.
+class CpuCapabilityGuard{
+public:
+    CpuCapabilityGuard()
+        : m_saved(CPU_CAPABILITY_CURRENT)
+    {}
+    ~CpuCapabilityGuard(){
+        CPU_CAPABILITY_CURRENT = m_saved;
+    }
+
+private:
+    CPU_Features m_saved;
+};
+
+
+}
+
+
+
+int test_kernels_Benchmark(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t min_time_ms = 200;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(min_time_ms, "MIN_TIME_MS", 1, 60000);
+        }
+    }
+    const std::chrono::milliseconds min_time(min_time_ms);
+
+    BenchmarkData data;
+    data.frames.emplace_back(std::make_unique<FrameData>(1280, 720));
+    data.frames.emplace_back(std::make_unique<FrameData>(1920, 1080));
+    data.signals.emplace_back(std::make_unique<SignalData>(1024));
+    data.signals.emplace_back(std::make_unique<SignalData>(2048));
+    data.signals.emplace_back(std::make_unique<SignalData>(4096));
+    data.spike_kernel = std::make_unique<SignalData>(64);
+    data.matrix = std::make_unique<MatrixData>(1024, 64);
+
+    const std::vector<KernelBenchmark> benchmarks = make_benchmarks(data);
+
+    struct BestResult{
+        std::string level;
+        double ns_per_element = 0;
+    };
+    std::vector<JsonObject> results_per_benchmark(benchmarks.size());
+    std::vector<BestResult> best(benchmarks.size());
+
+    JsonArray levels;
+    {
+        CpuCapabilityGuard guard;
+        for (const CpuCapabilityOption& option : AVAILABLE_CAPABILITIES()){
+            if (!option.available){
+                continue;
+            }
+            CPU_CAPABILITY_CURRENT = option.features;
+
+            const BinaryMatrixType matrix_type = get_BinaryMatrixType_default();
+            data.binary.clear();
+            for (const std::unique_ptr<FrameData>& frame : data.frames){
+                data.binary.emplace_back(make_PackedBinaryMatrix(matrix_type, frame->width, frame->height));
+                compress_rgb32_to_binary_range(
+                    frame->image.data(), frame->bytes_per_row,
+                    *data.binary.back(), 0xff000000, 0xff7f7f7f
+                );
+            }
+
+            JsonObject level;
+            level["slug"] = option.slug;
+            level["display"] = option.display;
+            level["binary_matrix"] = get_BinaryMatrixType_name(matrix_type);
+            levels.push_back(std::move(level));
+
+            cout << "Processor Level: " << option.display << " (" << get_BinaryMatrixType_name(matrix_type) << ")" << endl;
+            for (size_t c = 0; c < benchmarks.size(); c++){
+                const KernelBenchmark& benchmark = benchmarks[c];
+                BenchmarkResult result = time_benchmark(benchmark, min_time);
+
+                cout << "    " << std::left << std::setw(28) << benchmark.family
+                     << std::setw(44) << benchmark.name << std::right
+                     << std::setw(10) << std::fixed << std::setprecision(3) << result.ns_per_element << " ns/element, "
+                     << std::setw(8) << std::setprecision(2) << result.gb_per_s << " GB/s" << endl;
+                cout.unsetf(std::ios::floatfield);
+
+                JsonObject obj;
+                obj["iterations"] = result.iterations;
+                obj["ns_per_element"] = result.ns_per_element;
+                obj["gb_per_s"] = result.gb_per_s;
+                results_per_benchmark[c][option.slug] = std::move(obj);
+
+                if (best[c].level.empty() || result.ns_per_element < best[c].ns_per_element){
+                    best[c].level = option.slug;
+                    best[c].ns_per_element = result.ns_per_element;
+                }
+            }
+        }
+        data.waterfill_work.reset();
+        data.binary.clear();
+    }
+
+    JsonArray benchmarks_json;
+    for (size_t c = 0; c < benchmarks.size(); c++){
+        const KernelBenchmark& benchmark = benchmarks[c];
+        JsonObject obj;
+        obj["family"] = benchmark.family;
+        obj["name"] = benchmark.name;
+        obj["elements"] = benchmark.elements;
+        obj["bytes"] = benchmark.bytes;
+        obj["fastest"] = best[c].level;
+        obj["results"] = std::move(results_per_benchmark[c]);
+        benchmarks_json.push_back(std::move(obj));
+    }
+
+    JsonObject report;
+    report["arch"] = PA_ARCH_STRING;
+    report["min_time_ms"] = min_time_ms;
+    report["levels"] = std::move(levels);
+    report["benchmarks"] = std::move(benchmarks_json);
+
+    const std::string output_path = file_info.dir().filePath(
+        "_" + file_info.completeBaseName() + "-Results.json"
+    ).toStdString();
+    JsonValue(std::move(report)).dump(output_path);
+    cout << "Wrote benchmark results to " << output_path << endl;
+
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,31 @@
+/*  Kernels Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_Kernels_Benchmarks_H
+#define PokemonAutomation_Tests_Kernels_Benchmarks_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Benchmark every kernel family in "Kernels/" on every processor level that
+//  this machine supports.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "MIN_TIME_MS": Minimum time to spend on each kernel and level. (default: 200)
+//
+//  The results are printed and written next to the config as
+//  "_<config name>-Results.json". The leading underscore keeps the command
+//  line test runner from picking up the results as a test file.
+//
+//  This switches CPU_CAPABILITY_CURRENT while running. Do not run it with
+//  COMMAND_LINE_TESTS THREADS > 1.
+int test_kernels_Benchmark(const std::string& config_path);
+
+
+}
+#endif
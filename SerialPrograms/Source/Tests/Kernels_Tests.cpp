@@ -14,6 +14,7 @@
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixView.h"
 #ifdef PA_AutoDispatch_arm64_20_M1
     #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64x8_arm64_NEON.h"
     #include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_arm64_NEON.h"
@@ -25,6 +26,7 @@
 #include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
 #include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImageBlockMean.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
@@ -137,6 +139,162 @@ int test_kernels_BinaryMatrix(const ImageViewRGB32& image){
     return 0;
 }
 
+namespace{
+
+//  Compare the packed view against the virtual get() for one matrix.
+int check_packed_view(const PackedBinaryMatrix& matrix, const std::string& label){
+    const size_t width = matrix.width(), height = matrix.height();
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            if (matrix.get(x, y)){
+                expected.emplace_back(x, y);
+            }
+        }
+    }
+
+    //  Same cast as the callers in WaterfillUtilities.cpp.
+    const Kernels::PackedBinaryMatrix_IB& native = matrix;
+    size_t view_height = 0;
+    std::vector<std::pair<size_t, size_t>> bits;
+    size_t count = visit_matrix(native, [&](auto view){
+        view_height = decltype(view)::TILE_HEIGHT;
+        for_each_set_bit(view, [&](size_t x, size_t y){
+            bits.emplace_back(x, y);
+        });
+        return count_set_bits(view);
+    });
+    if (view_height != native.rows_per_tile()){
+        cout << "Error: " << label << " view tile height " << view_height << " != " << native.rows_per_tile() << endl;
+        return 1;
+    }
+    if (bits != expected){
+        cout << "Error: " << label << " for_each_set_bit() visited " << bits.size() << " bits, expected " << expected.size() << endl;
+        return 1;
+    }
+    TEST_RESULT_COMPONENT_EQUAL(count, expected.size(), label + " count_set_bits()");
+
+    //  Row at a time, as in SparkleDetectorRadial.cpp.
+    bits.clear();
+    visit_matrix(native, [&](auto view){
+        for (size_t y = 0; y < height; y++){
+            for_each_set_bit_in_row(view, y, [&](size_t x, size_t r){
+                bits.emplace_back(x, r);
+            });
+        }
+    });
+    if (bits != expected){
+        cout << "Error: " << label << " for_each_set_bit_in_row() mismatch." << endl;
+        return 1;
+    }
+    return 0;
+}
+
+//  Clear every other set bit through a mutable view and check get() sees it.
+int check_packed_view_set(PackedBinaryMatrix& matrix, const std::string& label){
+    PackedBinaryMatrix reference = matrix.copy();
+    size_t c = 0;
+    Kernels::visit_matrix((Kernels::PackedBinaryMatrix_IB&)matrix, [&](auto view){
+        for_each_set_bit(view, [&](size_t x, size_t y){
+            if (c++ % 2 == 0){
+                view.set(x, y, false);
+            }
+        });
+    });
+    c = 0;
+    for (size_t y = 0; y < matrix.height(); y++){
+        for (size_t x = 0; x < matrix.width(); x++){
+            bool expected = reference.get(x, y) && c++ % 2 == 1;
+            if (matrix.get(x, y) != expected){
+                cout << "Error: " << label << " set() mismatch at (" << x << ", " << y << ")" << endl;
+                return 1;
+            }
+        }
+    }
+    return check_packed_view(matrix, label + " after set()");
+}
+
+}
+
+int test_kernels_PackedBinaryMatrixView(const ImageViewRGB32& image){
+    //  Odd widths and heights so the last tile is partial in both directions.
+    const std::vector<std::pair<size_t, size_t>> sizes{
+        {1, 1}, {3, 5}, {63, 7}, {64, 8}, {65, 9}, {127, 17}, {128, 33}, {129, 65}, {200, 131},
+    };
+
+    for (int t = (int)BinaryMatrixType::i64x4_Default; t <= (int)BinaryMatrixType::arm64x8_x64_NEON; t++){
+        BinaryMatrixType type = (BinaryMatrixType)t;
+        if (!is_BinaryMatrixType_supported(type)){
+            continue;
+        }
+        const std::string name = get_BinaryMatrixType_name(type);
+        cout << "Testing PackedBinaryMatrixView on " << name << endl;
+
+        uint64_t seed = 1;
+        for (const auto& size : sizes){
+            const std::string label = name + " " + std::to_string(size.first) + " x " + std::to_string(size.second);
+
+            //  All ones. Bits past the width must not be visited.
+            PackedBinaryMatrix ones(make_PackedBinaryMatrix(type, size.first, size.second));
+            ones.set_ones();
+            if (check_packed_view(ones, label + " ones") != 0){
+                return 1;
+            }
+
+            PackedBinaryMatrix matrix(make_PackedBinaryMatrix(type, size.first, size.second));
+            matrix.set_zero();
+            if (check_packed_view(matrix, label + " zeros") != 0){
+                return 1;
+            }
+            for (size_t y = 0; y < size.second; y++){
+                for (size_t x = 0; x < size.first; x++){
+                    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                    matrix.set(x, y, (seed >> 61) < 3);
+                }
+            }
+            if (check_packed_view(matrix, label + " random") != 0){
+                return 1;
+            }
+            if (check_packed_view_set(matrix, label + " random") != 0){
+                return 1;
+            }
+
+            //  Garbage in the padding bits past the width must be ignored.
+            size_t tail = size.first % 64;
+            uint64_t padding = tail == 0 ? 0 : ~(((uint64_t)1 << tail) - 1);
+            Kernels::visit_matrix((Kernels::PackedBinaryMatrix_IB&)matrix, [&](auto view){
+                size_t last = view.word64_width() - 1;
+                for (size_t y = 0; y < view.height(); y++){
+                    view.word64(last, y) |= padding;
+                }
+            });
+            if (check_packed_view(matrix, label + " padding") != 0){
+                return 1;
+            }
+
+            //  Submatrices are how waterfill objects hand out their bits.
+            if (size.first > 2 && size.second > 2){
+                PackedBinaryMatrix sub = matrix.submatrix(1, 1, size.first - 2, size.second - 2);
+                if (check_packed_view(sub, label + " submatrix") != 0){
+                    return 1;
+                }
+            }
+        }
+
+        PackedBinaryMatrix matrix(make_PackedBinaryMatrix(type, image.width(), image.height()));
+        compress_rgb32_to_binary_range(
+            image.data(), image.bytes_per_row(), matrix,
+            uint32_t(Color(0, 0, 0)), uint32_t(Color(63, 63, 63))
+        );
+        if (check_packed_view(matrix, name + " image") != 0){
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image){
     const size_t width = image.width(), height = image.height();
     cout << "Testing filter_rgb32_range(), image size " << width << " x " << height << endl;
@@ -663,6 +821,122 @@ int test_kernels_Waterfill(const ImageViewRGB32& image){
     return 0;
 }
 
+
+namespace Kernels{
+void image_block_mean_Default(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+void image_block_mean_x64_SSE41(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+void image_block_mean_x64_AVX2(
+    uint32_t* grid, size_t grid_width, size_t grid_height,
+    const uint32_t* image, size_t image_bytes_per_row,
+    size_t width, size_t height
+);
+#endif
+}
+
+int test_kernels_ImageBlockMean(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_kernels_ImageBlockMean(), image size " << width << " x " << height << endl;
+
+    using BlockMeanFunction = void (*)(
+        uint32_t* grid, size_t grid_width, size_t grid_height,
+        const uint32_t* image, size_t image_bytes_per_row,
+        size_t width, size_t height
+    );
+    std::vector<std::pair<const char*, BlockMeanFunction>> kernels{
+        {"Default", Kernels::image_block_mean_Default},
+    };
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_NATIVE.OK_08_Nehalem){
+        kernels.emplace_back("x64_SSE41", Kernels::image_block_mean_x64_SSE41);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_NATIVE.OK_13_Haswell){
+        kernels.emplace_back("x64_AVX2", Kernels::image_block_mean_x64_AVX2);
+    }
+#endif
+
+    //  Also try a view that doesn't start on an aligned pixel or end on a
+    //  whole vector so the tails get covered.
+    std::vector<ImageViewRGB32> views{image};
+    if (width > 3 && height > 3){
+        views.emplace_back(image.sub_image(1, 1, width - 3, height - 2));
+    }
+
+    for (const ImageViewRGB32& view : views){
+        const size_t w = view.width();
+        const size_t h = view.height();
+        const size_t max_grid_width = std::min(w, IMAGE_BLOCK_MEAN_MAX_GRID_WIDTH);
+        const std::vector<std::pair<size_t, size_t>> grids{
+            {1, 1},
+            {std::min<size_t>(7, w), std::min<size_t>(5, h)},
+            {std::min<size_t>(64, w), std::min<size_t>(36, h)},
+            {max_grid_width, std::min(max_grid_width, h)},
+        };
+        for (const auto& grid_size : grids){
+            const size_t grid_width = grid_size.first;
+            const size_t grid_height = grid_size.second;
+
+            //  Scalar reference straight from the definition in the header.
+            std::vector<uint32_t> expected(grid_width * grid_height);
+            for (size_t by = 0; by < grid_height; by++){
+                for (size_t bx = 0; bx < grid_width; bx++){
+                    size_t x0 = bx * w / grid_width, x1 = (bx + 1) * w / grid_width;
+                    size_t y0 = by * h / grid_height, y1 = (by + 1) * h / grid_height;
+                    uint64_t sum[3] = {0, 0, 0};
+                    for (size_t y = y0; y < y1; y++){
+                        for (size_t x = x0; x < x1; x++){
+                            Color color(view.pixel(x, y));
+                            sum[0] += color.red();
+                            sum[1] += color.green();
+                            sum[2] += color.blue();
+                        }
+                    }
+                    uint64_t count = (uint64_t)(x1 - x0) * (y1 - y0);
+                    expected[by * grid_width + bx] = combine_rgb(
+                        (uint8_t)((sum[0] + count / 2) / count),
+                        (uint8_t)((sum[1] + count / 2) / count),
+                        (uint8_t)((sum[2] + count / 2) / count)
+                    );
+                }
+            }
+
+            for (const auto& kernel : kernels){
+                std::vector<uint32_t> grid(grid_width * grid_height);
+                kernel.second(
+                    grid.data(), grid_width, grid_height,
+                    view.data(), view.bytes_per_row(),
+                    w, h
+                );
+                for (size_t c = 0; c < grid.size(); c++){
+                    if (grid[c] != expected[c]){
+                        cout << "Error: " << kernel.first << ", view " << w << " x " << h
+                             << ", grid " << grid_width << " x " << grid_height
+                             << ", block (" << c % grid_width << ", " << c / grid_width << ") is "
+                             << Color(grid[c]).to_string() << " but should be " << Color(expected[c]).to_string() << endl;
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    cout << "Checked " << kernels.size() << " kernel(s)." << endl;
+    return 0;
+}
+
 // Additional tests on binary matrix tile implementation
 template<class Tile> int test_binary_matrix_tile_t(){
     size_t num_iters = 100000;
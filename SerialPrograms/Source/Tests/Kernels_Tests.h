@@ -17,6 +17,8 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image);
 
+int test_kernels_PackedBinaryMatrixView(const ImageViewRGB32& image);
+
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image);
 
 int test_kernels_FilterRGB32Euclidean(const ImageViewRGB32& image);
@@ -31,6 +33,8 @@ int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image);
 
 int test_kernels_Waterfill(const ImageViewRGB32& image);
 
+int test_kernels_ImageBlockMean(const ImageViewRGB32& image);
+
 
 }
 
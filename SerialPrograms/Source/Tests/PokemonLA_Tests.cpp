@@ -628,6 +628,19 @@ int test_pokemonLA_MMOSpriteMatcher(const std::string& filepath){
         }else{
             cout << "Match FAILURE" << endl;
         }
+
+        // The vectorized gradient matcher must give the same scores as the original.
+        for (const auto& item : compare_MMO_sprite_gradient_distances(sprite_image, new_boxes[i], region)){
+            const double reference = item.second.first;
+            const double score = item.second.second;
+            if (std::isnan(reference) && std::isnan(score)){
+                continue;
+            }
+            if (!(std::fabs(reference - score) <= 1e-9 * std::max(std::fabs(reference), 1.0))){
+                cerr << "Error: gradient score mismatch on " << item.first << ": " << score << " should be " << reference << endl;
+                return 1;
+            }
+        }
     }
 
     if (success_count == target_sprites.size()){
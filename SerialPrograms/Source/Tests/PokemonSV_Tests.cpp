@@ -10,6 +10,7 @@
 #include "TestUtils.h"
 
 #include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "PokemonSV/Inference/Battles/PokemonSV_NormalBattleMenus.h"
 #include "PokemonSV/Inference/Boxes/PokemonSV_BoxDetection.h"
 #include "PokemonSV/Inference/Boxes/PokemonSV_BoxEggDetector.h"
@@ -560,4 +561,21 @@ int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool tar
     return 0;
 }
 
+int test_pokemonSV_TeraCodeReader(const ImageViewRGB32& image, const std::vector<std::string>& words){
+    // last word: the code shown in the Tera raid lobby screenshot
+    if (words.empty()){
+        cerr << "Error: no code in the filename." << endl;
+        return 1;
+    }
+
+    auto& logger = global_logger_command_line();
+    AsyncDispatcher dispatcher([]{}, 0);
+    TeraLobbyReader reader(logger, dispatcher);
+
+    const std::string code = reader.raid_code(logger, dispatcher, image);
+    TEST_RESULT_EQUAL(code, words[words.size() - 1]);
+
+    return 0;
+}
+
 }
@@ -16,6 +16,15 @@
 #include "PokemonSwSh/MaxLair/Inference/PokemonSwSh_MaxLair_Detect_BattleMenu.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_DialogBoxDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxShinySymbolDetector.h"
+#include "PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_ShinySparkleSet.h"
+#include "PokemonSwSh/Inference/RNG/PokemonSwSh_OrbeetleAttackAnimationDetector.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Battle.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_DamageTable.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Rollout.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
 
 #include <QFileInfo>
 #include <QDir>
@@ -24,6 +33,7 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <set>
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -125,4 +135,330 @@ int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target){
     return 0;
 }
 
+int test_pokemonSwSh_MaxLair_DamageTable(const std::string& config_path){
+    using namespace papkmnlib;
+    using papkmnlib::Pokemon;
+
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    const std::map<std::string, Pokemon>& rentals = all_rental_pokemon();
+    const std::map<std::string, Pokemon>& bosses = all_boss_pokemon();
+
+    std::vector<std::string> boss_slugs;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        const JsonArray* array = obj == nullptr ? nullptr : obj->get_array("BOSSES");
+        if (array != nullptr){
+            for (const JsonValue& item : *array){
+                boss_slugs.emplace_back(item.to_string_throw(config_path));
+            }
+        }else{
+            for (const auto& item : bosses){
+                boss_slugs.emplace_back(item.first);
+            }
+        }
+    }
+
+    //  Each distinct field only needs to be checked once.
+    std::map<std::pair<Weather, Terrain>, Field> fields;
+    for (const std::string& slug : boss_slugs){
+        Field field;
+        field.set_default_field(slug);
+        fields.emplace(std::make_pair(field.weather(), field.terrain()), field);
+    }
+
+    std::vector<const Pokemon*> pokemon;
+    for (const auto& item : rentals){
+        pokemon.emplace_back(&item.second);
+    }
+    for (const auto& item : bosses){
+        pokemon.emplace_back(&item.second);
+    }
+
+    size_t checked = 0;
+    for (const auto& item : fields){
+        const Field& field = item.second;
+        for (const Pokemon* base : pokemon){
+            Pokemon attacker = *base;
+            for (size_t dmax = 0; dmax < 2; dmax++){
+                attacker.set_is_dynamax(dmax != 0);
+                for (size_t move = 0; move < attacker.num_moves(); move++){
+                    if ((dmax ? attacker.max_move_id(move) : attacker.move_id(move)) == 0){
+                        continue;
+                    }
+                    for (const Pokemon* defender : pokemon){
+                        for (size_t multi = 0; multi < 2; multi++){
+                            double expected = damage_score(attacker, *defender, move, field, multi != 0);
+                            double actual = damage_score_lookup(attacker, *defender, move, field, multi != 0);
+                            if (actual != expected){
+                                cerr << "Error: " << attacker.name() << " -> " << defender->name()
+                                     << ", move = " << move << ", dmax = " << dmax << ", multi = " << multi
+                                     << ", weather = " << (int)field.weather() << ", terrain = " << (int)field.terrain()
+                                     << ", table = " << actual << ", live = " << expected << endl;
+                                return 1;
+                            }
+                            checked++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //  Burned attackers aren't in the table and must still match.
+    for (const auto& item : fields){
+        const Field& field = item.second;
+        for (const Pokemon* base : pokemon){
+            Pokemon attacker = *base;
+            attacker.set_non_volatile_status_effect(NonVolatileStatusEffects::BURN);
+            const Pokemon& defender = *pokemon[checked % pokemon.size()];
+            for (size_t move = 0; move < attacker.num_moves(); move++){
+                if (attacker.move_id(move) == 0){
+                    continue;
+                }
+                double expected = damage_score(attacker, defender, move, field, false);
+                double actual = damage_score_lookup(attacker, defender, move, field, false);
+                TEST_RESULT_EQUAL(actual, expected);
+                checked++;
+            }
+        }
+    }
+
+    cout << "Damage table matches in " << checked << " cases over " << fields.size() << " field(s)." << endl;
+    return 0;
+}
+
+int test_pokemonSwSh_MaxLair_Rollout(const std::string& config_path){
+    using namespace papkmnlib;
+    using namespace MaxLairInternal;
+    using papkmnlib::Pokemon;
+
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    size_t rollouts = 2000;
+    size_t seconds = 2;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(rollouts, "ROLLOUTS", 1, 1000000);
+            obj->read_integer(seconds, "SECONDS", 0, 60);
+        }
+    }
+
+    //  Any team will do. Every rental and boss is a candidate.
+    std::vector<const Pokemon*> rentals;
+    for (const auto& item : all_rental_pokemon()){
+        rentals.emplace_back(&item.second);
+    }
+    std::vector<const Pokemon*> bosses;
+    for (const auto& item : all_boss_pokemon()){
+        bosses.emplace_back(&item.second);
+    }
+    if (rentals.size() < 4 || bosses.empty()){
+        cerr << "Error: Not enough Pokemon in the databases." << endl;
+        return 1;
+    }
+
+    RolloutState state;
+    for (size_t c = 0; c < 4; c++){
+        state.team[c] = rentals[c * rentals.size() / 4];
+    }
+    state.dmax_player = 0;
+    state.battles = {rentals, rentals, rentals, bosses};
+
+    RolloutEngine single(1);
+    RolloutEngine multi;
+    const uint64_t seed = 12345;
+    RolloutResult result0 = single.run(state, rollouts, seed);
+    RolloutResult result1 = multi.run(state, rollouts, seed);
+    cout << "Win Rate: " << result0.win_rate() << " (" << result0.wins << " / " << result0.rollouts << ")" << endl;
+    TEST_RESULT_EQUAL(result0.rollouts, rollouts);
+    TEST_RESULT_EQUAL(result1.rollouts, result0.rollouts);
+    TEST_RESULT_EQUAL(result1.wins, result0.wins);
+    TEST_RESULT_EQUAL(result1.battles_won, result0.battles_won);
+
+    if (seconds > 0){
+        WallClock start = current_time();
+        RolloutResult result = multi.run_until(state, start + std::chrono::seconds(seconds), (size_t)-1 / 2, seed);
+        double elapsed = std::chrono::duration<double>(current_time() - start).count();
+        cout << "Throughput: " << result.rollouts / elapsed << " rollouts/sec on " << multi.threads() << " thread(s)" << endl;
+    }
+
+    return 0;
+}
+
+namespace{
+
+//  Sparkle boxes that start at or right of "min_x", tagged by kind and sorted
+//  so the order they were found in doesn't matter.
+std::set<std::string> sparkle_boxes(const ShinySparkleSetSwSh& sparkles, size_t min_x = 0){
+    std::set<std::string> ret;
+    const std::vector<std::pair<const char*, const std::vector<ImagePixelBox>*>> kinds{
+        {"ball", &sparkles.balls},
+        {"star", &sparkles.stars},
+        {"square", &sparkles.squares},
+        {"line", &sparkles.lines},
+    };
+    for (const auto& kind : kinds){
+        for (const ImagePixelBox& box : *kind.second){
+            if (box.min_x < min_x){
+                continue;
+            }
+            ret.insert(
+                std::string(kind.first) + "(" + std::to_string(box.min_x) + "," + std::to_string(box.min_y) + "," +
+                std::to_string(box.max_x) + "," + std::to_string(box.max_y) + ")"
+            );
+        }
+    }
+    return ret;
+}
+std::string dump_sparkles(const ShinySparkleSetSwSh& sparkles){
+    std::string str;
+    for (const std::string& box : sparkle_boxes(sparkles)){
+        str += box + " ";
+    }
+    return str + "alpha = " + std::to_string(sparkles.alpha_overall());
+}
+
+}
+
+int test_pokemonSwSh_SparkleHeatMap(const ImageViewRGB32& image){
+    ShinySparkleSetSwSh reference;
+    reference.read_from_image(image);
+    const std::string expected = dump_sparkles(reference);
+    cout << "Full image: " << expected << endl;
+
+    SparkleHeatMap heat_map;
+    ShinySparkleSetSwSh sparkles;
+    sparkles.set_heat_map(&heat_map);
+
+    //  No history. The whole frame is searched.
+    sparkles.read_from_image(image);
+    TEST_RESULT_COMPONENT_EQUAL(dump_sparkles(sparkles), expected, "first frame");
+
+    //  A static frame goes cold.
+    const size_t COOL_FRAMES = SparkleHeatMap::HEAT_MAX / SparkleHeatMap::DECAY + 1;
+    for (size_t c = 0; c < COOL_FRAMES; c++){
+        sparkles.read_from_image(image);
+    }
+    TEST_RESULT_COMPONENT_EQUAL(heat_map.push_frame(image).size(), (size_t)0, "static regions");
+    sparkles.read_from_image(image);
+    TEST_RESULT_COMPONENT_EQUAL(sparkles.alpha_overall(), 0.0, "static alpha");
+
+    //  Coming from a black frame, every pixel that passes the filter is hot.
+    //  The hot regions must find exactly what the full search finds.
+    ImageRGB32 black(image.width(), image.height());
+    black.fill(0xff000000);
+    sparkles.read_from_image(black);
+    sparkles.read_from_image(image);
+    TEST_RESULT_COMPONENT_EQUAL(dump_sparkles(sparkles), expected, "after black frame");
+
+    //  Only the right half changes. Everything found there must be at the
+    //  same place as in the full search.
+    for (size_t c = 0; c < COOL_FRAMES; c++){
+        sparkles.read_from_image(image);
+    }
+    const size_t half = image.width() / 2;
+    ImageRGB32 right_black = image.copy();
+    for (size_t y = 0; y < image.height(); y++){
+        for (size_t x = half; x < image.width(); x++){
+            right_black.pixel(x, y) = 0xff000000;
+        }
+    }
+    sparkles.read_from_image(right_black);
+    sparkles.read_from_image(image);
+    const std::set<std::string> all = sparkle_boxes(reference);
+    const std::set<std::string> found = sparkle_boxes(sparkles);
+    for (const std::string& box : found){
+        if (all.find(box) == all.end()){
+            cerr << "Error: right half found " << box << ", which the full search didn't." << endl;
+            return 1;
+        }
+    }
+    for (const std::string& box : sparkle_boxes(reference, half)){
+        if (found.find(box) == found.end()){
+            cerr << "Error: right half missed " << box << "." << endl;
+            return 1;
+        }
+    }
+
+    //  One changed pixel only makes the blocks around it hot.
+    for (size_t c = 0; c < COOL_FRAMES; c++){
+        heat_map.push_frame(image);
+    }
+    ImageRGB32 changed = image.copy();
+    const size_t x = image.width() / 2, y = image.height() / 2;
+    uint32_t pixel = changed.pixel(x, y);
+    bool passes = ((pixel >> 16) & 0xff) >= 0xa0 && ((pixel >> 8) & 0xff) >= 0xa0;
+    changed.pixel(x, y) = passes ? 0xff000000 : 0xffffffff;
+    std::vector<ImagePixelBox> regions = heat_map.push_frame(changed);
+    TEST_RESULT_COMPONENT_EQUAL(regions.size(), (size_t)1, "changed pixel regions");
+    const ImagePixelBox& region = regions[0];
+    if (x < region.min_x || x >= region.max_x || y < region.min_y || y >= region.max_y){
+        cerr << "Error: the changed pixel is outside the hot region." << endl;
+        return 1;
+    }
+    TEST_RESULT_COMPONENT_EQUAL(region.width() <= 3 * SparkleHeatMap::BLOCK_SIZE, true, "region width");
+    TEST_RESULT_COMPONENT_EQUAL(region.height() <= 3 * SparkleHeatMap::BLOCK_SIZE, true, "region height");
+
+    return 0;
+}
+
+namespace{
+
+//  Apply "f" to every pixel inside the Orbeetle box.
+template <typename Function>
+ImageRGB32 edit_orbeetle_box(const ImageViewRGB32& image, Function&& f){
+    using Detector = OrbeetleAttackAnimationDetector;
+    ImageRGB32 ret = image.copy();
+    const size_t min_x = (size_t)(Detector::BOX.x * image.width());
+    const size_t min_y = (size_t)(Detector::BOX.y * image.height());
+    const size_t max_x = (size_t)((Detector::BOX.x + Detector::BOX.width) * image.width());
+    const size_t max_y = (size_t)((Detector::BOX.y + Detector::BOX.height) * image.height());
+    for (size_t y = min_y; y < max_y; y++){
+        for (size_t x = min_x; x < max_x; x++){
+            ret.pixel(x, y) = f(ret.pixel(x, y));
+        }
+    }
+    return ret;
+}
+
+}
+
+int test_pokemonSwSh_OrbeetleAttackAnimation(const ImageViewRGB32& image){
+    using Detector = OrbeetleAttackAnimationDetector;
+
+    //  Nothing changed.
+    TEST_RESULT_COMPONENT_EQUAL(Detector::classify(image, image), Detector::PHYSICAL, "same frame");
+
+    //  The special attack flashes the box red.
+    ImageRGB32 flash = edit_orbeetle_box(image, [](uint32_t){ return (uint32_t)0xffc83228; });
+    TEST_RESULT_COMPONENT_EQUAL(Detector::classify(image, flash), Detector::SPECIAL, "red flash");
+
+    //  Brightness changes keep the color ratios.
+    ImageRGB32 dark = edit_orbeetle_box(image, [](uint32_t pixel){
+        return 0xff000000 | ((pixel >> 1) & 0x007f7f7f);
+    });
+    TEST_RESULT_COMPONENT_EQUAL(Detector::classify(image, dark), Detector::PHYSICAL, "darker frame");
+    TEST_RESULT_COMPONENT_EQUAL(Detector::classify(dark, image), Detector::PHYSICAL, "brighter frame");
+
+    //  A flash that is only a bit redder than the baseline is not enough.
+    ImageRGB32 tint = edit_orbeetle_box(image, [](uint32_t pixel){
+        uint32_t r = (pixel >> 16) & 0xff;
+        r = std::min<uint32_t>(r + r / 8, 0xff);
+        return (pixel & 0xff00ffff) | (r << 16);
+    });
+    TEST_RESULT_COMPONENT_EQUAL(Detector::classify(image, tint), Detector::PHYSICAL, "slight tint");
+
+    return 0;
+}
+
 }
@@ -38,6 +38,30 @@ int test_pokemonSwSh_BoxShinySymbolDetector(const ImageViewRGB32& image, bool ta
 
 int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target);
 
+//  Check that searching only the regions SparkleHeatMap marks as hot finds the
+//  same sparkles as searching the whole image, and that static frames go cold.
+int test_pokemonSwSh_SparkleHeatMap(const ImageViewRGB32& image);
+
+//  Check the Orbeetle attack classifier on a saved battle frame: a red flash
+//  over the box is special, while the same frame or a darker or brighter
+//  one is physical.
+int test_pokemonSwSh_OrbeetleAttackAnimation(const ImageViewRGB32& image);
+
+//  Check that the precomputed Max Lair damage table matches damage_score()
+//  for every rental and boss pair, move, dmax state and target count.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "BOSSES": Array of boss slugs whose fields are checked. (default: all)
+int test_pokemonSwSh_MaxLair_DamageTable(const std::string& config_path);
+
+//  Run Max Lair adventure rollouts with a fixed seed on 1 thread and on all
+//  cores and check that the results are identical. Then print the throughput.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "ROLLOUTS": # of rollouts for the determinism check. (default: 2000)
+//    - "SECONDS": Duration of the throughput benchmark. (default: 2)
+int test_pokemonSwSh_MaxLair_Rollout(const std::string& config_path);
+
 }
 
 #endif
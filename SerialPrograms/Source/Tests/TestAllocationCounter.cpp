@@ -0,0 +1,91 @@
+/*  Test Allocation Counter
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdlib.h>
+#include <new>
+#include "TestAllocationCounter.h"
+
+namespace PokemonAutomation{
+
+namespace{
+
+//  Plain pointer so that there is no dynamic initialization. This makes it
+//  safe to read from operator new at any point of the thread's lifetime.
+thread_local TestAllocationStats* t_current_counter = nullptr;
+
+}
+
+
+TestAllocationCounter::TestAllocationCounter()
+    : m_parent(t_current_counter)
+{
+    t_current_counter = &m_stats;
+}
+TestAllocationCounter::~TestAllocationCounter(){
+    t_current_counter = m_parent;
+}
+
+
+}
+
+
+
+#ifdef PA_COUNT_TEST_ALLOCATIONS
+void* operator new(std::size_t size){
+    if (size == 0){
+        size = 1;
+    }
+    void* ptr;
+    while ((ptr = malloc(size)) == nullptr){
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr){
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+    PokemonAutomation::TestAllocationStats* counter = PokemonAutomation::t_current_counter;
+    if (counter != nullptr){
+        counter->allocations++;
+        counter->bytes += size;
+    }
+    return ptr;
+}
+void* operator new[](std::size_t size){
+    return operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return operator new(size);
+    }catch (...){
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return operator new(size);
+    }catch (...){
+        return nullptr;
+    }
+}
+void operator delete(void* ptr) noexcept{
+    free(ptr);
+}
+void operator delete[](void* ptr) noexcept{
+    free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept{
+    free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept{
+    free(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept{
+    free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept{
+    free(ptr);
+}
+#endif
@@ -0,0 +1,62 @@
+/*  Test Allocation Counter
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Count the heap allocations made by a command line test.
+ *
+ *  Counting needs the global operator new to be replaced, which only happens
+ *  in builds with PA_COUNT_TEST_ALLOCATIONS defined. (CMake option of the same
+ *  name, off by default.) Release builds keep the standard allocator and the
+ *  counters always read zero.
+ *
+ *  When enabled, counting is per-thread and only happens while a
+ *  TestAllocationCounter is alive on that thread, so the rest of the program
+ *  only pays for one thread-local load per allocation.
+ *
+ *  Allocations made on other threads on behalf of the test (e.g. work handed
+ *  off to a global thread pool) are not counted.
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_TestAllocationCounter_H
+#define PokemonAutomation_Tests_TestAllocationCounter_H
+
+#include <stdint.h>
+
+namespace PokemonAutomation{
+
+
+struct TestAllocationStats{
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+
+//  Count all allocations made on the current thread during the lifetime of
+//  this object. Counters can be nested. The inner counter takes over until it
+//  is destroyed and the outer counter does not see its allocations.
+class TestAllocationCounter{
+public:
+    static constexpr bool ENABLED =
+#ifdef PA_COUNT_TEST_ALLOCATIONS
+        true;
+#else
+        false;
+#endif
+
+    TestAllocationCounter();
+    ~TestAllocationCounter();
+    TestAllocationCounter(const TestAllocationCounter&) = delete;
+    void operator=(const TestAllocationCounter&) = delete;
+
+    const TestAllocationStats& stats() const{ return m_stats; }
+
+private:
+    TestAllocationStats* m_parent;
+    TestAllocationStats m_stats;
+};
+
+
+
+}
+#endif
@@ -7,7 +7,15 @@
 
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework_Tests.h"
+#include "Concurrency_Benchmarks.h"
+#include "Concurrency_Tests.h"
+#include "Kernels_Benchmarks.h"
 #include "Kernels_Tests.h"
+#include "Json_Benchmarks.h"
+#include "VideoOverlay_Benchmarks.h"
+#include "VideoOverlay_Tests.h"
+#include "InferencePivot_Benchmarks.h"
+#include "DiscordWebhook_Tests.h"
 #include "NintendoSwitch_Tests.h"
 #include "PokemonLA_Tests.h"
 #include "PokemonSwSh_Tests.h"
@@ -221,13 +229,26 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
     {"Kernels_BinaryMatrix", std::bind(image_void_detector_helper, test_kernels_BinaryMatrix, _1)},
+    {"Kernels_PackedBinaryMatrixView", std::bind(image_void_detector_helper, test_kernels_PackedBinaryMatrixView, _1)},
     {"Kernels_FilterRGB32Range", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Range, _1)},
     {"Kernels_FilterRGB32Euclidean", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Euclidean, _1)},
     {"Kernels_ToBlackWhiteRGB32Range", std::bind(image_void_detector_helper, test_kernels_ToBlackWhiteRGB32Range, _1)},
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"Kernels_ImageBlockMean", std::bind(image_void_detector_helper, test_kernels_ImageBlockMean, _1)},
+    {"Kernels_Benchmark", test_kernels_Benchmark},
+    {"Json_Benchmark", test_json_Benchmark},
+    {"Concurrency_Benchmark", test_concurrency_Benchmark},
+    {"Concurrency_WorkStealingPool", test_concurrency_WorkStealingPool},
+    {"Concurrency_InferenceExecutor", test_concurrency_InferenceExecutor},
+    {"VideoOverlay_Benchmark", test_videoOverlay_Benchmark},
+    {"VideoOverlay_Session", test_videoOverlay_Session},
+    {"InferencePivot_Benchmark", test_inferencePivot_Benchmark},
+    {"DiscordWebhook_Delivery", test_DiscordWebhook_Delivery},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_VisualChangeTracker", std::bind(image_void_detector_helper, test_CommonFramework_VisualChangeTracker, _1)},
+    {"CommonFramework_FrozenImageDetector", std::bind(image_void_detector_helper, test_CommonFramework_FrozenImageDetector, _1)},
     {"NintendoSwitch_UpdateMenuDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdateMenuDetector, _1)},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
@@ -240,6 +261,10 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSwSh_BlackDialogBoxDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BlackDialogBoxDetector, _1)},
     {"PokemonSwSh_BoxShinySymbolDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BoxShinySymbolDetector, _1)},
     {"PokemonSwSh_BoxGenderDetector", std::bind(image_int_detector_helper, test_pokemonSwSh_BoxGenderDetector, _1)},
+    {"PokemonSwSh_SparkleHeatMap", std::bind(image_void_detector_helper, test_pokemonSwSh_SparkleHeatMap, _1)},
+    {"PokemonSwSh_OrbeetleAttackAnimation", std::bind(image_void_detector_helper, test_pokemonSwSh_OrbeetleAttackAnimation, _1)},
+    {"PokemonSwSh_MaxLair_DamageTable", test_pokemonSwSh_MaxLair_DamageTable},
+    {"PokemonSwSh_MaxLair_Rollout", test_pokemonSwSh_MaxLair_Rollout},
     {"PokemonLA_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattleMenuDetector, _1)},
     {"PokemonLA_BattlePokemonSwitchDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattlePokemonSwitchDetector, _1)},
     {"PokemonLA_TransparentDialogueDetector", std::bind(image_bool_detector_helper, test_pokemonLA_TransparentDialogueDetector, _1)},
@@ -285,7 +310,8 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSV_ESPPressedEmotionDetector", std::bind(image_bool_detector_helper, test_pokemonSV_ESPPressedEmotionDetector, _1)},
     {"PokemonSV_MapFlyMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSV_MapFlyMenuDetector, _1)},
     {"PokemonSV_SandwichPlateDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichPlateDetector, _1)},
-    {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)}
+    {"PokemonSV_RecentlyBattledDetector", std::bind(image_bool_detector_helper, test_pokemonSV_RecentlyBattledDetector, _1)},
+    {"PokemonSV_TeraCodeReader", std::bind(image_words_detector_helper, test_pokemonSV_TeraCodeReader, _1)}
 };
 
 TestFunction find_test_function(const std::string& test_space, const std::string& test_name){
@@ -0,0 +1,197 @@
+/*  Video Overlay Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <deque>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <QFileInfo>
+#include <QDir>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayOption.h"
+#include "CommonFramework/VideoPipeline/VideoOverlaySession.h"
+#include "VideoOverlay_Benchmarks.h"
+
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+struct BenchmarkResult{
+    uint64_t updates = 0;
+    uint64_t snapshots = 0;
+    double seconds = 0;
+};
+
+BenchmarkResult run_case(
+    size_t writers, bool per_update,
+    size_t static_boxes,
+    std::chrono::milliseconds duration,
+    std::chrono::microseconds refresh_period
+){
+    VideoOverlayOption option;
+    VideoOverlaySession session(option);
+
+    //  Background boxes that are on screen the whole time.
+    std::deque<OverlayBox> boxes;
+    for (size_t c = 0; c < static_boxes; c++){
+        boxes.emplace_back(COLOR_RED, ImageFloatBox(0.01 * c, 0.01 * c, 0.1, 0.1), "static");
+        session.add_box(boxes.back());
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> updates(0);
+    std::atomic<uint64_t> snapshots(0);
+    uint64_t last_version = 0;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < writers; t++){
+        threads.emplace_back([&, t]{
+            OverlayBox box(COLOR_GREEN, ImageFloatBox(0, 0, 0.2, 0.2), "writer " + std::to_string(t));
+            const std::string message = "Writer " + std::to_string(t) + ": Detected something.";
+            uint64_t local_updates = 0;
+            uint64_t local_snapshots = 0;
+            auto on_update = [&]{
+                local_updates++;
+                if (per_update){
+                    session.snapshot();
+                    local_snapshots++;
+                }
+            };
+            for (size_t c = 0; !stop.load(std::memory_order_relaxed); c++){
+                box.box.x = (c % 64) / 100.;
+                session.add_box(box);
+                on_update();
+                session.add_log(message);
+                on_update();
+                session.remove_box(box);
+                on_update();
+            }
+            updates.fetch_add(local_updates, std::memory_order_relaxed);
+            snapshots.fetch_add(local_snapshots, std::memory_order_relaxed);
+        });
+    }
+
+    WallClock start = current_time();
+    WallClock end = start + duration;
+    if (!per_update){
+        //  The renderer.
+        WallClock next = start;
+        while (true){
+            next += refresh_period;
+            if (next > end){
+                break;
+            }
+            std::this_thread::sleep_until(next);
+            std::shared_ptr<const VideoOverlaySnapshot> snapshot = session.snapshot();
+            if (snapshot->version != last_version){
+                last_version = snapshot->version;
+                snapshots.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    std::this_thread::sleep_until(end);
+    stop.store(true, std::memory_order_relaxed);
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+
+    BenchmarkResult result;
+    result.seconds = std::chrono::duration<double>(current_time() - start).count();
+    result.updates = updates.load();
+    result.snapshots = snapshots.load();
+
+    for (const OverlayBox& box : boxes){
+        session.remove_box(box);
+    }
+    return result;
+}
+
+
+}
+
+
+
+int test_videoOverlay_Benchmark(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t min_time_ms = 500;
+    int64_t max_threads = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    int64_t refresh_hz = 60;
+    int64_t static_boxes = 16;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(min_time_ms, "MIN_TIME_MS", 1, 60000);
+            obj->read_integer(max_threads, "MAX_THREADS", 1, 1024);
+            obj->read_integer(refresh_hz, "REFRESH_HZ", 1, 1000);
+            obj->read_integer(static_boxes, "BOXES", 0, 10000);
+        }
+    }
+    const std::chrono::milliseconds duration(min_time_ms);
+    const std::chrono::microseconds refresh_period(1000000 / refresh_hz);
+
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < (size_t)max_threads; threads *= 2){
+        thread_counts.emplace_back(threads);
+    }
+    thread_counts.emplace_back(max_threads);
+
+    JsonObject results;
+    for (bool per_update : {false, true}){
+        const char* name = per_update ? "per update" : "coalesced";
+        JsonObject mode_results;
+        for (size_t threads : thread_counts){
+            BenchmarkResult result = run_case(
+                threads, per_update, static_boxes, duration, refresh_period
+            );
+            double updates_per_sec = result.updates / result.seconds;
+            double snapshots_per_sec = result.snapshots / result.seconds;
+            cout << std::left << std::setw(12) << name << std::right
+                 << "writers = " << std::setw(3) << threads << "  "
+                 << std::setw(14) << std::fixed << std::setprecision(0) << updates_per_sec << " updates/s, "
+                 << std::setw(12) << snapshots_per_sec << " snapshots/s" << endl;
+            cout.unsetf(std::ios::floatfield);
+
+            JsonObject obj;
+            obj["updates"] = result.updates;
+            obj["snapshots"] = result.snapshots;
+            obj["seconds"] = result.seconds;
+            obj["updates_per_sec"] = updates_per_sec;
+            mode_results[std::to_string(threads)] = std::move(obj);
+        }
+        results[name] = std::move(mode_results);
+    }
+
+    JsonObject report;
+    report["min_time_ms"] = min_time_ms;
+    report["max_threads"] = max_threads;
+    report["refresh_hz"] = refresh_hz;
+    report["boxes"] = static_boxes;
+    report["results"] = std::move(results);
+
+    const std::string output_path = file_info.dir().filePath(
+        "_" + file_info.completeBaseName() + "-Results.json"
+    ).toStdString();
+    JsonValue(std::move(report)).dump(output_path);
+    cout << "Wrote benchmark results to " << output_path << endl;
+
+    return 0;
+}
+
+
+
+}
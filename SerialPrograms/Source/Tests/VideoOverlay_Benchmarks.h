@@ -0,0 +1,38 @@
+/*  Video Overlay Benchmarks
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_VideoOverlay_Benchmarks_H
+#define PokemonAutomation_Tests_VideoOverlay_Benchmarks_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Measure how many overlay updates per second VideoOverlaySession takes from
+//  1, 2, 4, ... writer threads. Each writer acts like a detector: it moves a
+//  box (add + remove) and adds a log line. An "update" is one such call.
+//
+//  Two readers are tried:
+//    - "coalesced": Takes a snapshot at the display refresh rate like the
+//      overlay widget does.
+//    - "per update": Every writer also takes a snapshot after every update.
+//      Each of those builds a new snapshot. This is the cost that coalescing
+//      to the refresh rate saves.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "MIN_TIME_MS": Time to spend on each case. (default: 500)
+//    - "MAX_THREADS": Most writer threads to try. (default: # of CPU threads)
+//    - "REFRESH_HZ": Snapshot rate of the coalesced reader. (default: 60)
+//    - "BOXES": Boxes that stay on the overlay the whole time. (default: 16)
+//
+//  The results are printed and written next to the config as
+//  "_<config name>-Results.json".
+int test_videoOverlay_Benchmark(const std::string& config_path);
+
+
+}
+#endif
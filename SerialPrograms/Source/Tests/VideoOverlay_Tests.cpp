@@ -0,0 +1,229 @@
+/*  Video Overlay Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <iostream>
+#include <QFileInfo>
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayOption.h"
+#include "CommonFramework/VideoPipeline/VideoOverlaySession.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
+#include "TestUtils.h"
+#include "VideoOverlay_Tests.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+
+class CountingStat : public OverlayStat{
+public:
+    CountingStat(std::string name)
+        : m_name(std::move(name))
+    {}
+    virtual OverlayStatSnapshot get_current() override{
+        return {m_name + " " + std::to_string(m_reads++)};
+    }
+
+private:
+    std::string m_name;
+    size_t m_reads = 0;
+};
+
+
+int test_snapshots(){
+    VideoOverlayOption option;
+    VideoOverlaySession session(option);
+
+    std::shared_ptr<const VideoOverlaySnapshot> empty = session.snapshot();
+    TEST_RESULT_COMPONENT_EQUAL(session.snapshot() == empty, true, "unchanged snapshot");
+
+    {
+        OverlayBoxScope box(session, ImageFloatBox(0.1, 0.2, 0.3, 0.4));
+        std::shared_ptr<const VideoOverlaySnapshot> added = session.snapshot();
+        TEST_RESULT_COMPONENT_EQUAL(added != empty, true, "snapshot after add");
+        TEST_RESULT_COMPONENT_EQUAL(added->boxes.size(), (size_t)1, "boxes after add");
+        TEST_RESULT_COMPONENT_EQUAL(added->boxes[0].box.x, 0.1, "box x after add");
+        TEST_RESULT_COMPONENT_EQUAL(session.snapshot() == added, true, "snapshot after read");
+
+        //  The session keeps its own copy until the box is added again.
+        box.box.x = 0.5;
+        TEST_RESULT_COMPONENT_EQUAL(session.snapshot()->boxes[0].box.x, 0.1, "box x before add");
+        session.add_box(box);
+        TEST_RESULT_COMPONENT_EQUAL(session.snapshot()->boxes[0].box.x, 0.5, "box x after add");
+        TEST_RESULT_COMPONENT_EQUAL(added->boxes[0].box.x, 0.1, "box x in old snapshot");
+
+        //  Many writes in between, one new snapshot.
+        const uint64_t version = session.snapshot()->version;
+        for (size_t c = 0; c < 100; c++){
+            box.box.y = c / 100.;
+            session.add_box(box);
+            session.add_log("line " + std::to_string(c));
+        }
+        std::shared_ptr<const VideoOverlaySnapshot> coalesced = session.snapshot();
+        TEST_RESULT_COMPONENT_EQUAL(coalesced->version, version + 1, "coalesced version");
+        TEST_RESULT_COMPONENT_EQUAL(coalesced->boxes[0].box.y, 0.99, "coalesced box y");
+
+        //  Newest line first, oldest lines dropped.
+        TEST_RESULT_COMPONENT_EQUAL(coalesced->log.size(), VideoOverlaySession::LOG_MAX_LINES, "log size");
+        TEST_RESULT_COMPONENT_EQUAL(coalesced->log.front().message, std::string("line 99"), "newest log line");
+        TEST_RESULT_COMPONENT_EQUAL(
+            coalesced->log.back().message,
+            "line " + std::to_string(100 - VideoOverlaySession::LOG_MAX_LINES),
+            "oldest log line"
+        );
+        session.clear_log();
+        TEST_RESULT_COMPONENT_EQUAL(session.log_texts().size(), (size_t)0, "log after clear");
+
+        OverlayText text(COLOR_WHITE, "text", 0.1, 0.1, 4.0);
+        session.add_text(text);
+        TEST_RESULT_COMPONENT_EQUAL(session.texts().size(), (size_t)1, "texts after add");
+        TEST_RESULT_COMPONENT_EQUAL(session.texts()[0].message, std::string("text"), "text after add");
+        session.remove_text(text);
+        TEST_RESULT_COMPONENT_EQUAL(session.texts().size(), (size_t)0, "texts after remove");
+    }
+    TEST_RESULT_COMPONENT_EQUAL(session.boxes().size(), (size_t)0, "boxes after remove");
+
+    //  Nothing to remove.
+    std::shared_ptr<const VideoOverlaySnapshot> before = session.snapshot();
+    session.remove_box(OverlayBox(COLOR_RED, ImageFloatBox(0, 0, 0, 0), ""));
+    session.remove_text(OverlayText(COLOR_RED, "", 0, 0, 1));
+    session.clear_log();
+    TEST_RESULT_COMPONENT_EQUAL(session.snapshot() == before, true, "snapshot after removing nothing");
+
+    return 0;
+}
+
+int test_stats(){
+    VideoOverlayOption option;
+    VideoOverlaySession session(option);
+
+    CountingStat a("a");
+    CountingStat b("b");
+    session.add_stat(a);
+    session.add_stat(b);
+    session.add_stat(a);
+
+    std::vector<OverlayStatSnapshot> stats = session.stats();
+    TEST_RESULT_COMPONENT_EQUAL(stats.size(), (size_t)2, "stats");
+    TEST_RESULT_COMPONENT_EQUAL(stats[0].text, std::string("a 0"), "first stat");
+    TEST_RESULT_COMPONENT_EQUAL(stats[1].text, std::string("b 0"), "second stat");
+
+    session.remove_stat(a);
+    stats = session.stats();
+    TEST_RESULT_COMPONENT_EQUAL(stats.size(), (size_t)1, "stats after remove");
+    TEST_RESULT_COMPONENT_EQUAL(stats[0].text, std::string("b 1"), "remaining stat");
+    session.remove_stat(b);
+    TEST_RESULT_COMPONENT_EQUAL(session.stats().size(), (size_t)0, "stats after remove all");
+
+    return 0;
+}
+
+//  Writers move their own box and add log lines while a reader keeps taking
+//  snapshots.
+int test_concurrent(size_t threads, size_t rounds){
+    VideoOverlayOption option;
+    VideoOverlaySession session(option);
+
+    OverlayBox static_box(COLOR_RED, ImageFloatBox(0, 0, 0.1, 0.1), "static");
+    session.add_box(static_box);
+
+    std::atomic<bool> done(false);
+    std::atomic<bool> version_error(false);
+    std::thread reader([&]{
+        uint64_t last_version = 0;
+        while (!done.load(std::memory_order_acquire)){
+            std::shared_ptr<const VideoOverlaySnapshot> snapshot = session.snapshot();
+            if (snapshot->version < last_version){
+                version_error.store(true, std::memory_order_relaxed);
+            }
+            last_version = snapshot->version;
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < threads; t++){
+        writers.emplace_back([&, t]{
+            OverlayBox box(COLOR_GREEN, ImageFloatBox(0, 0, 0.2, 0.2), "writer " + std::to_string(t));
+            for (size_t c = 0; c < rounds; c++){
+                box.box.x = (c % 64) / 100.;
+                session.add_box(box);
+                session.add_log("writer " + std::to_string(t));
+                session.snapshot();
+                session.remove_box(box);
+            }
+        });
+    }
+    for (std::thread& thread : writers){
+        thread.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    TEST_RESULT_COMPONENT_EQUAL(version_error.load(), false, "versions in order");
+
+    std::shared_ptr<const VideoOverlaySnapshot> snapshot = session.snapshot();
+    TEST_RESULT_COMPONENT_EQUAL(snapshot->boxes.size(), (size_t)1, "boxes after writers");
+    TEST_RESULT_COMPONENT_EQUAL(snapshot->boxes[0].label, std::string("static"), "remaining box");
+    TEST_RESULT_COMPONENT_EQUAL(
+        snapshot->log.size(),
+        std::min(threads * rounds, VideoOverlaySession::LOG_MAX_LINES),
+        "log after writers"
+    );
+
+    session.remove_box(static_box);
+    return 0;
+}
+
+
+}
+
+
+int test_videoOverlay_Session(const std::string& config_path){
+    const QFileInfo file_info(QString::fromStdString(config_path));
+    if (file_info.suffix() != "json"){
+        return -1;
+    }
+
+    int64_t threads = 4;
+    int64_t rounds = 10000;
+    {
+        JsonValue config = load_json_file(config_path);
+        const JsonObject* obj = config.to_object();
+        if (obj != nullptr){
+            obj->read_integer(threads, "THREADS", 1, 1024);
+            obj->read_integer(rounds, "ROUNDS", 1, 100000000);
+        }
+    }
+
+    int ret = test_snapshots();
+    if (ret != 0){
+        return ret;
+    }
+    ret = test_stats();
+    if (ret != 0){
+        return ret;
+    }
+    ret = test_concurrent((size_t)threads, (size_t)rounds);
+    if (ret != 0){
+        return ret;
+    }
+
+    cout << "VideoOverlaySession: passed" << endl;
+    return 0;
+}
+
+
+}
@@ -0,0 +1,33 @@
+/*  Video Overlay Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_VideoOverlay_Tests_H
+#define PokemonAutomation_Tests_VideoOverlay_Tests_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Check VideoOverlaySession:
+//    - snapshot() returns the same snapshot until something changes.
+//    - Any number of writes between two calls builds one new snapshot.
+//    - A snapshot doesn't change after it's returned, and a box that is
+//      changed by the caller doesn't change until it's added again.
+//    - The log keeps the newest LOG_MAX_LINES lines, newest first.
+//    - Removing something that isn't there doesn't build a new snapshot.
+//    - Stats are listed once each, in the order they were added.
+//    - With writers and a reader running at the same time, the versions the
+//      reader sees never go down and the final snapshot matches the state.
+//
+//  The test file is a JSON config. It can be empty ("{}") or set:
+//    - "THREADS": Writer threads in the concurrent check. (default: 4)
+//    - "ROUNDS": Updates per writer in the concurrent check. (default: 10000)
+int test_videoOverlay_Session(const std::string& config_path);
+
+
+}
+#endif